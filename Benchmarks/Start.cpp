@@ -0,0 +1,653 @@
+#include "GLTF.hpp"
+#include "Jobs.hpp"
+#include "JSON.hpp"
+
+#include "Luft/Platform.hpp"
+
+#include <stdio.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static constexpr usize RunCount = 5;
+
+static constexpr StringView ScenePaths[] =
+{
+	"Assets/Scenes/Sponza/Sponza.gltf"_view,
+	"Assets/Scenes/Bistro/Bistro.gltf"_view,
+	"Assets/Scenes/EmeraldSquare/EmeraldSquare_Day.gltf"_view,
+	"Assets/Scenes/SunTemple/SunTemple.gltf"_view,
+};
+
+// The largest manifest, with root arrays long enough to split over every thread count below.
+static constexpr StringView ThreadScalingScenePath = "Assets/Scenes/EmeraldSquare/EmeraldSquare_Day.gltf"_view;
+static constexpr usize ThreadCounts[] = { 1, 2, 4, 8, 16 };
+
+static constexpr const char* ReportPath = "Benchmarks.json";
+
+static void MakeNullTerminated(StringView filePath, char* nullTerminatedPath, usize size)
+{
+	VERIFY(filePath.GetLength() < size, "File path is too long!");
+	Platform::MemoryCopy(nullTerminatedPath, filePath.GetData(), filePath.GetLength());
+	nullTerminatedPath[filePath.GetLength()] = '\0';
+}
+
+static bool DoesFileExist(StringView filePath)
+{
+	char nullTerminatedPath[512];
+	MakeNullTerminated(filePath, nullTerminatedPath, sizeof(nullTerminatedPath));
+
+	FILE* file = fopen(nullTerminatedPath, "rb");
+	if (!file)
+	{
+		return false;
+	}
+	fclose(file);
+	return true;
+}
+
+// Drops the cached pages of a file so that its next read comes from storage. Windows purges them when the file is
+// opened unbuffered with no other handle open; elsewhere the kernel is asked to drop them, which it does for clean pages.
+static void EvictFromCache(StringView filePath)
+{
+	char nullTerminatedPath[512];
+	MakeNullTerminated(filePath, nullTerminatedPath, sizeof(nullTerminatedPath));
+
+#if defined(_WIN32)
+	const HANDLE file = CreateFileA(nullTerminatedPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, nullptr);
+	VERIFY(file != INVALID_HANDLE_VALUE, "Failed to open file!");
+	CloseHandle(file);
+#else
+	const int file = open(nullTerminatedPath, O_RDONLY);
+	VERIFY(file >= 0, "Failed to open file!");
+	VERIFY(posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED) == 0, "Failed to evict file from cache!");
+	close(file);
+#endif
+}
+
+static void WriteMilliseconds(JSON::Writer* report, StringView key, float64 seconds)
+{
+	report->WriteKey(key);
+	report->WriteDecimal(seconds * 1000.0);
+}
+
+static void WriteCount(JSON::Writer* report, StringView key, usize count)
+{
+	report->WriteKey(key);
+	report->WriteInteger(static_cast<int64>(count));
+}
+
+static void BenchmarkDocument(StringView scenePath, JSON::Writer* report)
+{
+	float64 fastestTime = 0.0;
+	usize allocationCount = 0;
+	usize blockCount = 0;
+	usize usedSize = 0;
+	for (usize run = 0; run < RunCount; ++run)
+	{
+		const float64 start = Platform::GetTime();
+		const JSON::Document document = JSON::Load(scenePath);
+		const float64 time = Platform::GetTime() - start;
+
+		fastestTime = run == 0 ? time : Min(fastestTime, time);
+		allocationCount = document.GetStorage().GetAllocationCount();
+		blockCount = document.GetStorage().GetBlockCount();
+		usedSize = document.GetStorage().GetUsedSize();
+	}
+
+	Platform::LogFormatted("%.*s: Loaded document in %.2fms with %zu allocations in %zu blocks (%zu KB)\n",
+						   static_cast<int32>(scenePath.GetLength()),
+						   scenePath.GetData(),
+						   fastestTime * 1000.0,
+						   allocationCount,
+						   blockCount,
+						   usedSize / 1024);
+
+	report->WriteKey("document"_view);
+	report->BeginObject();
+	WriteMilliseconds(report, "milliseconds"_view, fastestTime);
+	WriteCount(report, "allocations"_view, allocationCount);
+	WriteCount(report, "blocks"_view, blockCount);
+	WriteCount(report, "usedBytes"_view, usedSize);
+	report->EndObject();
+}
+
+// Loads the document straight off storage each run, once through the chunked reader that indexes while the rest of
+// the file is still being read, and once by reading the whole file before parsing it.
+static void BenchmarkColdLoad(StringView scenePath, JSON::Writer* report)
+{
+	float64 chunkedTime = 0.0;
+	float64 readThenParseTime = 0.0;
+	for (usize run = 0; run < RunCount; ++run)
+	{
+		EvictFromCache(scenePath);
+		{
+			const float64 start = Platform::GetTime();
+			const JSON::Document document = JSON::Load(scenePath);
+			const float64 time = Platform::GetTime() - start;
+
+			chunkedTime = run == 0 ? time : Min(chunkedTime, time);
+		}
+
+		EvictFromCache(scenePath);
+		{
+			Arena storage(MB(1));
+
+			const float64 start = Platform::GetTime();
+			usize fileSize;
+			const char* fileData = reinterpret_cast<const char*>(Platform::ReadEntireFile(scenePath, &fileSize, &storage));
+			const JSON::Document document = JSON::Parse(StringView(fileData, fileSize));
+			const float64 time = Platform::GetTime() - start;
+
+			readThenParseTime = run == 0 ? time : Min(readThenParseTime, time);
+		}
+	}
+
+	Platform::LogFormatted("%.*s: Loaded document from storage in %.2fms chunked and %.2fms read then parsed (%.2fx)\n",
+						   static_cast<int32>(scenePath.GetLength()),
+						   scenePath.GetData(),
+						   chunkedTime * 1000.0,
+						   readThenParseTime * 1000.0,
+						   readThenParseTime / chunkedTime);
+
+	report->WriteKey("coldLoad"_view);
+	report->BeginObject();
+	WriteMilliseconds(report, "chunkedMilliseconds"_view, chunkedTime);
+	WriteMilliseconds(report, "readThenParseMilliseconds"_view, readThenParseTime);
+	report->WriteKey("speedup"_view);
+	report->WriteDecimal(readThenParseTime / chunkedTime);
+	report->EndObject();
+}
+
+// Indexes the whole manifest and matches its brackets without building anything, which is the first stage of every
+// parse. The file is read up front so that only the indexing is timed.
+static void BenchmarkStructuralIndex(StringView scenePath, JSON::Writer* report)
+{
+	Arena storage(MB(1));
+
+	usize fileSize;
+	const char* fileData = reinterpret_cast<const char*>(Platform::ReadEntireFile(scenePath, &fileSize, &storage));
+
+	float64 fastestTime = 0.0;
+	for (usize run = 0; run < RunCount; ++run)
+	{
+		Arena readerStorage(MB(1));
+
+		const float64 start = Platform::GetTime();
+		JSON::Reader reader(fileData, fileSize, &readerStorage);
+		reader.SkipValue();
+		VERIFY(reader.NextToken() == JSON::Token::End, "Unexpected characters after JSON value!");
+		const float64 time = Platform::GetTime() - start;
+
+		fastestTime = run == 0 ? time : Min(fastestTime, time);
+	}
+
+	const float64 gigabytesPerSecond = static_cast<float64>(fileSize) / fastestTime / 1.0e9;
+	Platform::LogFormatted("%.*s: Indexed %zu KB in %.2fms (%.2f GB/s)\n",
+						   static_cast<int32>(scenePath.GetLength()),
+						   scenePath.GetData(),
+						   fileSize / 1024,
+						   fastestTime * 1000.0,
+						   gigabytesPerSecond);
+
+	report->WriteKey("structuralIndex"_view);
+	report->BeginObject();
+	WriteMilliseconds(report, "milliseconds"_view, fastestTime);
+	WriteCount(report, "bytes"_view, fileSize);
+	report->WriteKey("gigabytesPerSecond"_view);
+	report->WriteDecimal(gigabytesPerSecond);
+	report->EndObject();
+}
+
+// Pulls every token of the manifest, which for accessor-heavy files is mostly numbers. Includes indexing, so it is
+// read against the index-only figure.
+static void BenchmarkNumbers(StringView scenePath, JSON::Writer* report)
+{
+	Arena storage(MB(1));
+
+	usize fileSize;
+	const char* fileData = reinterpret_cast<const char*>(Platform::ReadEntireFile(scenePath, &fileSize, &storage));
+
+	float64 fastestTime = 0.0;
+	usize integerCount = 0;
+	usize decimalCount = 0;
+	for (usize run = 0; run < RunCount; ++run)
+	{
+		Arena readerStorage(MB(1));
+		integerCount = 0;
+		decimalCount = 0;
+
+		const float64 start = Platform::GetTime();
+		JSON::Reader reader(fileData, fileSize, &readerStorage);
+		for (JSON::Token token = reader.NextToken(); token != JSON::Token::End; token = reader.NextToken())
+		{
+			if (token != JSON::Token::Value)
+			{
+				continue;
+			}
+			integerCount += reader.GetValue().GetTag() == JSON::Tag::Integer;
+			decimalCount += reader.GetValue().GetTag() == JSON::Tag::Decimal;
+		}
+		const float64 time = Platform::GetTime() - start;
+
+		fastestTime = run == 0 ? time : Min(fastestTime, time);
+	}
+
+	const float64 millionNumbersPerSecond = static_cast<float64>(integerCount + decimalCount) / fastestTime / 1.0e6;
+	Platform::LogFormatted("%.*s: Read %zu integers and %zu decimals in %.2fms (%.1fM numbers/s)\n",
+						   static_cast<int32>(scenePath.GetLength()),
+						   scenePath.GetData(),
+						   integerCount,
+						   decimalCount,
+						   fastestTime * 1000.0,
+						   millionNumbersPerSecond);
+
+	report->WriteKey("numbers"_view);
+	report->BeginObject();
+	WriteMilliseconds(report, "milliseconds"_view, fastestTime);
+	WriteCount(report, "integers"_view, integerCount);
+	WriteCount(report, "decimals"_view, decimalCount);
+	report->WriteKey("millionNumbersPerSecond"_view);
+	report->WriteDecimal(millionNumbersPerSecond);
+	report->EndObject();
+}
+
+static constexpr JSON::Key OptionalAccessorKeys[] =
+{
+	"byteOffset"_key,
+	"normalized"_key,
+	"min"_key,
+	"max"_key,
+	"sparse"_key,
+};
+
+// Looks up the optional members of every accessor, as the document parser of the scene loader does, once by asking
+// whether each is there before fetching it and once with a single TryGet. Values found are counted so that neither
+// lookup can be left out.
+static void BenchmarkKeyLookups(StringView scenePath, JSON::Writer* report)
+{
+	const JSON::Document document = JSON::Load(scenePath);
+	const JSON::Value* accessorsValue = document.GetRoot().TryGet("accessors"_key);
+	if (!accessorsValue)
+	{
+		return;
+	}
+	const JSON::Array accessorArray = accessorsValue->GetArray();
+
+	static constexpr usize lookupRunCount = 20;
+
+	float64 hasKeyTime = 0.0;
+	float64 tryGetTime = 0.0;
+	usize hasKeyFoundCount = 0;
+	usize tryGetFoundCount = 0;
+	for (usize run = 0; run < RunCount; ++run)
+	{
+		hasKeyFoundCount = 0;
+		float64 start = Platform::GetTime();
+		for (usize lookupRun = 0; lookupRun < lookupRunCount; ++lookupRun)
+		{
+			for (const JSON::Value& accessorValue : accessorArray)
+			{
+				const JSON::Object accessorObject = accessorValue.GetObject();
+				for (const JSON::Key key : OptionalAccessorKeys)
+				{
+					if (accessorObject.HasKey(key))
+					{
+						hasKeyFoundCount += accessorObject[key].GetTag() != JSON::Tag::None;
+					}
+				}
+			}
+		}
+		const float64 hasKeyRunTime = Platform::GetTime() - start;
+
+		tryGetFoundCount = 0;
+		start = Platform::GetTime();
+		for (usize lookupRun = 0; lookupRun < lookupRunCount; ++lookupRun)
+		{
+			for (const JSON::Value& accessorValue : accessorArray)
+			{
+				const JSON::Object accessorObject = accessorValue.GetObject();
+				for (const JSON::Key key : OptionalAccessorKeys)
+				{
+					const JSON::Value* value = accessorObject.TryGet(key);
+					if (value)
+					{
+						tryGetFoundCount += value->GetTag() != JSON::Tag::None;
+					}
+				}
+			}
+		}
+		const float64 tryGetRunTime = Platform::GetTime() - start;
+
+		hasKeyTime = run == 0 ? hasKeyRunTime : Min(hasKeyTime, hasKeyRunTime);
+		tryGetTime = run == 0 ? tryGetRunTime : Min(tryGetTime, tryGetRunTime);
+	}
+	VERIFY(hasKeyFoundCount == tryGetFoundCount, "Key lookups disagree!");
+
+	const usize lookupCount = accessorArray.GetCount() * ARRAY_COUNT(OptionalAccessorKeys) * lookupRunCount;
+	Platform::LogFormatted("%.*s: Looked up %zu accessor keys in %.2fms with HasKey and operator[] and %.2fms with TryGet (%.2fx)\n",
+						   static_cast<int32>(scenePath.GetLength()),
+						   scenePath.GetData(),
+						   lookupCount,
+						   hasKeyTime * 1000.0,
+						   tryGetTime * 1000.0,
+						   hasKeyTime / tryGetTime);
+
+	report->WriteKey("keyLookups"_view);
+	report->BeginObject();
+	WriteCount(report, "lookups"_view, lookupCount);
+	WriteCount(report, "found"_view, tryGetFoundCount);
+	WriteMilliseconds(report, "hasKeyMilliseconds"_view, hasKeyTime);
+	WriteMilliseconds(report, "tryGetMilliseconds"_view, tryGetTime);
+	report->EndObject();
+}
+
+// Loads the whole scene as the renderer does, with streams left where the file keeps them, and counts what its storage
+// took. Loading logs each of its stages, so the figures of every run show up above the summary.
+static void BenchmarkLoadScene(StringView scenePath, JSON::Writer* report)
+{
+	float64 fastestTime = 0.0;
+	usize allocationCount = 0;
+	usize blockCount = 0;
+	usize usedSize = 0;
+	for (usize run = 0; run < RunCount; ++run)
+	{
+		const float64 start = Platform::GetTime();
+		GLTF::Scene scene = GLTF::LoadScene(scenePath, GLTF::VertexLayout::AsStored);
+		const float64 time = Platform::GetTime() - start;
+
+		fastestTime = run == 0 ? time : Min(fastestTime, time);
+		allocationCount = scene.Storage->GetAllocationCount();
+		blockCount = scene.Storage->GetBlockCount();
+		usedSize = scene.Storage->GetUsedSize();
+
+		GLTF::UnloadScene(&scene);
+	}
+
+	Platform::LogFormatted("%.*s: Loaded scene in %.2fms with %zu allocations in %zu blocks (%zu KB)\n",
+						   static_cast<int32>(scenePath.GetLength()),
+						   scenePath.GetData(),
+						   fastestTime * 1000.0,
+						   allocationCount,
+						   blockCount,
+						   usedSize / 1024);
+
+	report->WriteKey("scene"_view);
+	report->BeginObject();
+	WriteMilliseconds(report, "milliseconds"_view, fastestTime);
+	WriteCount(report, "allocations"_view, allocationCount);
+	WriteCount(report, "blocks"_view, blockCount);
+	WriteCount(report, "usedBytes"_view, usedSize);
+	report->EndObject();
+}
+
+static float64 TimeLoadScene(StringView scenePath, GLTF::ManifestParser manifestParser)
+{
+	float64 fastestTime = 0.0;
+	for (usize run = 0; run < RunCount; ++run)
+	{
+		const float64 start = Platform::GetTime();
+		GLTF::Scene scene = GLTF::LoadScene(scenePath, GLTF::VertexLayout::AsStored, manifestParser);
+		const float64 time = Platform::GetTime() - start;
+
+		fastestTime = run == 0 ? time : Min(fastestTime, time);
+
+		GLTF::UnloadScene(&scene);
+	}
+	return fastestTime;
+}
+
+// Loads the scene once with the manifest read straight into it and once through a document, and reports how much faster
+// the first is. Both include reading the buffers, which is the same for each.
+static void BenchmarkManifestParsers(StringView scenePath, JSON::Writer* report)
+{
+	const float64 streamingTime = TimeLoadScene(scenePath, GLTF::ManifestParser::Streaming);
+	const float64 documentTime = TimeLoadScene(scenePath, GLTF::ManifestParser::Document);
+	const float64 speedup = documentTime / streamingTime;
+
+	Platform::LogFormatted("%.*s: Loaded scene in %.2fms streaming and %.2fms through a document (%.2fx)\n",
+						   static_cast<int32>(scenePath.GetLength()),
+						   scenePath.GetData(),
+						   streamingTime * 1000.0,
+						   documentTime * 1000.0,
+						   speedup);
+
+	report->WriteKey("manifestParsers"_view);
+	report->BeginObject();
+	WriteMilliseconds(report, "streamingMilliseconds"_view, streamingTime);
+	WriteMilliseconds(report, "documentMilliseconds"_view, documentTime);
+	report->WriteKey("speedup"_view);
+	report->WriteDecimal(speedup);
+	report->EndObject();
+}
+
+// Counts the primitives that load found repeating the geometry of an earlier one, and the bytes of positions and indices
+// that they no longer need their own copy of.
+static void BenchmarkSharedGeometry(StringView scenePath, JSON::Writer* report)
+{
+	GLTF::Scene scene = GLTF::LoadScene(scenePath, GLTF::VertexLayout::AsStored);
+
+	usize sharedGeometryCount = 0;
+	usize sharedGeometrySize = 0;
+	for (usize primitiveIndex = 0; primitiveIndex < scene.Primitives.GetCount(); ++primitiveIndex)
+	{
+		const GLTF::Primitive& primitive = scene.Primitives[primitiveIndex];
+		if (primitive.Geometry == primitiveIndex)
+		{
+			continue;
+		}
+
+		const GLTF::Accessor& positions = scene.Accessors[GLTF::GetAttribute(primitive, GLTF::AttributeType::Position)];
+		const GLTF::Accessor& indices = scene.Accessors[primitive.Indices];
+		++sharedGeometryCount;
+		sharedGeometrySize += positions.Count * GLTF::GetElementSize(positions.AccessorType, positions.ComponentType);
+		sharedGeometrySize += indices.Count * GLTF::GetElementSize(indices.AccessorType, indices.ComponentType);
+	}
+	const usize primitiveCount = scene.Primitives.GetCount();
+
+	GLTF::UnloadScene(&scene);
+
+	Platform::LogFormatted("%.*s: Shared the geometry of %zu of %zu primitives (%zu KB)\n",
+						   static_cast<int32>(scenePath.GetLength()),
+						   scenePath.GetData(),
+						   sharedGeometryCount,
+						   primitiveCount,
+						   sharedGeometrySize / 1024);
+
+	report->WriteKey("sharedGeometry"_view);
+	report->BeginObject();
+	WriteCount(report, "primitives"_view, primitiveCount);
+	WriteCount(report, "sharedPrimitives"_view, sharedGeometryCount);
+	WriteCount(report, "sharedBytes"_view, sharedGeometrySize);
+	report->EndObject();
+}
+
+// Loads the document with the job system restarted at each thread count, counting the calling thread as one of them.
+// Without worker threads on this platform every count runs serially, which the worker count in the report shows.
+static void BenchmarkThreadScaling(StringView scenePath, JSON::Writer* report)
+{
+	report->WriteKey("threadScaling"_view);
+	report->BeginArray();
+
+	float64 serialTime = 0.0;
+	for (const usize threadCount : ThreadCounts)
+	{
+		Jobs::Shutdown();
+		Jobs::Init(threadCount - 1);
+
+		float64 fastestTime = 0.0;
+		for (usize run = 0; run < RunCount; ++run)
+		{
+			const float64 start = Platform::GetTime();
+			const JSON::Document document = JSON::Load(scenePath);
+			const float64 time = Platform::GetTime() - start;
+
+			fastestTime = run == 0 ? time : Min(fastestTime, time);
+		}
+		if (threadCount == 1)
+		{
+			serialTime = fastestTime;
+		}
+
+		Platform::LogFormatted("%.*s: Loaded document on %zu threads (%zu workers) in %.2fms (%.2fx)\n",
+							   static_cast<int32>(scenePath.GetLength()),
+							   scenePath.GetData(),
+							   threadCount,
+							   Jobs::GetWorkerCount(),
+							   fastestTime * 1000.0,
+							   serialTime / fastestTime);
+
+		report->BeginObject();
+		WriteCount(report, "threads"_view, threadCount);
+		WriteCount(report, "workers"_view, Jobs::GetWorkerCount());
+		WriteMilliseconds(report, "milliseconds"_view, fastestTime);
+		report->WriteKey("speedup"_view);
+		report->WriteDecimal(serialTime / fastestTime);
+		report->EndObject();
+	}
+	report->EndArray();
+
+	Jobs::Shutdown();
+	Jobs::Init(Jobs::GetDefaultWorkerCount());
+}
+
+// Writes a document shaped like a scene manifest, with objects of strings, integers and float arrays, until it passes
+// the target size. The text is read back afterwards to check that it is whole.
+static void BenchmarkWriter(JSON::Format format, StringView formatName, JSON::Writer* report)
+{
+	static constexpr usize targetSize = MB(50);
+
+	float64 fastestTime = 0.0;
+	usize textSize = 0;
+	usize objectCount = 0;
+	for (usize run = 0; run < RunCount; ++run)
+	{
+		const float64 start = Platform::GetTime();
+		JSON::Writer writer(format);
+		writer.BeginObject();
+		writer.WriteKey("accessors"_view);
+		writer.BeginArray();
+		objectCount = 0;
+		while (writer.GetText().GetLength() < targetSize)
+		{
+			const float64 scale = static_cast<float64>(objectCount) * 0.001;
+			writer.BeginObject();
+			writer.WriteKey("name"_view);
+			writer.WriteString("accessor"_view);
+			writer.WriteKey("bufferView"_view);
+			writer.WriteInteger(static_cast<int64>(objectCount));
+			writer.WriteKey("count"_view);
+			writer.WriteInteger(static_cast<int64>(objectCount * 3 + 1));
+			writer.WriteKey("min"_view);
+			writer.BeginArray();
+			writer.WriteDecimal(-1.0 - scale);
+			writer.WriteDecimal(-0.3333333333333333 * scale);
+			writer.WriteDecimal(-2.718281828459045 + scale);
+			writer.EndArray();
+			writer.WriteKey("max"_view);
+			writer.BeginArray();
+			writer.WriteDecimal(1.0 + scale);
+			writer.WriteDecimal(0.1 * scale);
+			writer.WriteDecimal(3.141592653589793 * scale);
+			writer.EndArray();
+			writer.WriteKey("normalized"_view);
+			writer.WriteBoolean(objectCount % 2 == 0);
+			writer.EndObject();
+			++objectCount;
+		}
+		writer.EndArray();
+		writer.EndObject();
+		const float64 time = Platform::GetTime() - start;
+
+		fastestTime = run == 0 ? time : Min(fastestTime, time);
+		textSize = writer.GetText().GetLength();
+
+		if (run == 0)
+		{
+			const JSON::Document document = JSON::Parse(writer.GetText());
+			VERIFY(document.GetRoot()["accessors"_key].GetArray().GetCount() == objectCount, "Written JSON doesn't read back!");
+		}
+	}
+
+	Platform::LogFormatted("Writer: Wrote %zu KB of %.*s JSON in %.2fms (%.2f GB/s)\n",
+						   textSize / 1024,
+						   static_cast<int32>(formatName.GetLength()),
+						   formatName.GetData(),
+						   fastestTime * 1000.0,
+						   static_cast<float64>(textSize) / fastestTime / 1.0e9);
+
+	report->WriteKey(formatName);
+	report->BeginObject();
+	WriteMilliseconds(report, "milliseconds"_view, fastestTime);
+	WriteCount(report, "bytes"_view, textSize);
+	WriteCount(report, "objects"_view, objectCount);
+	report->EndObject();
+}
+
+// Reports the fastest of several runs of each figure, on every bundled scene that is present, and writes them all to a
+// JSON report next to the executable.
+void Start()
+{
+	Jobs::Init(Jobs::GetDefaultWorkerCount());
+
+	JSON::Writer report(JSON::Format::Pretty);
+	report.BeginObject();
+	WriteCount(&report, "workers"_view, Jobs::GetWorkerCount());
+
+	report.WriteKey("scenes"_view);
+	report.BeginObject();
+	for (const StringView scenePath : ScenePaths)
+	{
+		if (!DoesFileExist(scenePath))
+		{
+			Platform::LogFormatted("%.*s: Missing, skipped\n", static_cast<int32>(scenePath.GetLength()), scenePath.GetData());
+			continue;
+		}
+
+		report.WriteKey(scenePath);
+		report.BeginObject();
+		BenchmarkDocument(scenePath, &report);
+		BenchmarkColdLoad(scenePath, &report);
+		BenchmarkStructuralIndex(scenePath, &report);
+		BenchmarkNumbers(scenePath, &report);
+		BenchmarkKeyLookups(scenePath, &report);
+		BenchmarkLoadScene(scenePath, &report);
+		BenchmarkManifestParsers(scenePath, &report);
+		BenchmarkSharedGeometry(scenePath, &report);
+		report.EndObject();
+	}
+	report.EndObject();
+
+	if (DoesFileExist(ThreadScalingScenePath))
+	{
+		BenchmarkThreadScaling(ThreadScalingScenePath, &report);
+	}
+	else
+	{
+		Platform::LogFormatted("%.*s: Missing, thread scaling skipped\n",
+							   static_cast<int32>(ThreadScalingScenePath.GetLength()),
+							   ThreadScalingScenePath.GetData());
+	}
+
+	report.WriteKey("writer"_view);
+	report.BeginObject();
+	BenchmarkWriter(JSON::Format::Compact, "compact"_view, &report);
+	BenchmarkWriter(JSON::Format::Pretty, "pretty"_view, &report);
+	report.EndObject();
+
+	report.EndObject();
+
+	const StringView reportText = report.GetText();
+	FILE* reportFile = fopen(ReportPath, "wb");
+	VERIFY(reportFile, "Failed to open benchmark report!");
+	VERIFY(fwrite(reportText.GetData(), 1, reportText.GetLength(), reportFile) == reportText.GetLength(), "Failed to write benchmark report!");
+	fclose(reportFile);
+
+	Jobs::Shutdown();
+}
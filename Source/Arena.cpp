@@ -0,0 +1,149 @@
+#include "Arena.hpp"
+
+static constexpr usize ArenaAlignment = 16;
+
+Arena::Arena(usize blockSize, Allocator* parent)
+	: Parent(parent)
+	, BlockSize(blockSize)
+	, Current(nullptr)
+	, AllocationCount(0)
+	, BlockCount(0)
+	, UsedSize(0)
+{
+	CHECK(Parent);
+	CHECK(BlockSize > GetBlockHeaderSize());
+}
+
+Arena::~Arena()
+{
+	Reset();
+}
+
+Arena::Arena(Arena&& move)
+	: Parent(move.Parent)
+	, BlockSize(move.BlockSize)
+	, Current(move.Current)
+	, AllocationCount(move.AllocationCount)
+	, BlockCount(move.BlockCount)
+	, UsedSize(move.UsedSize)
+{
+	move.Current = nullptr;
+	move.AllocationCount = 0;
+	move.BlockCount = 0;
+	move.UsedSize = 0;
+}
+
+Arena& Arena::operator=(Arena&& move)
+{
+	if (&move == this)
+	{
+		return *this;
+	}
+
+	Reset();
+
+	Parent = move.Parent;
+	BlockSize = move.BlockSize;
+	Current = move.Current;
+	AllocationCount = move.AllocationCount;
+	BlockCount = move.BlockCount;
+	UsedSize = move.UsedSize;
+
+	move.Current = nullptr;
+	move.AllocationCount = 0;
+	move.BlockCount = 0;
+	move.UsedSize = 0;
+
+	return *this;
+}
+
+void* Arena::Allocate(usize size)
+{
+	const usize alignedSize = NextMultipleOf(size, ArenaAlignment);
+
+	if (!Current || Current->Offset + alignedSize > Current->Size)
+	{
+		AddBlock(alignedSize);
+	}
+
+	void* data = reinterpret_cast<uint8*>(Current) + Current->Offset;
+	Current->Offset += alignedSize;
+
+	++AllocationCount;
+	UsedSize += alignedSize;
+
+	return data;
+}
+
+void Arena::Deallocate(void*, usize)
+{
+}
+
+void Arena::Reset()
+{
+	while (Current)
+	{
+		Block* previous = Current->Previous;
+		Parent->Deallocate(Current, Current->Size);
+		Current = previous;
+	}
+
+	AllocationCount = 0;
+	BlockCount = 0;
+	UsedSize = 0;
+}
+
+void Arena::Adopt(Arena* other)
+{
+	CHECK(other && other != this);
+	CHECK(other->Parent == Parent);
+
+	if (!other->Current)
+	{
+		return;
+	}
+
+	Block* oldest = other->Current;
+	while (oldest->Previous)
+	{
+		oldest = oldest->Previous;
+	}
+
+	if (Current)
+	{
+		// The adopted blocks go under the current one, which is the only block still being allocated from.
+		oldest->Previous = Current->Previous;
+		Current->Previous = other->Current;
+	}
+	else
+	{
+		Current = other->Current;
+	}
+
+	AllocationCount += other->AllocationCount;
+	BlockCount += other->BlockCount;
+	UsedSize += other->UsedSize;
+
+	other->Current = nullptr;
+	other->AllocationCount = 0;
+	other->BlockCount = 0;
+	other->UsedSize = 0;
+}
+
+usize Arena::GetBlockHeaderSize()
+{
+	return NextMultipleOf(sizeof(Block), ArenaAlignment);
+}
+
+void Arena::AddBlock(usize minimumSize)
+{
+	const usize size = Max(BlockSize, GetBlockHeaderSize() + minimumSize);
+
+	Block* block = static_cast<Block*>(Parent->Allocate(size));
+	block->Previous = Current;
+	block->Size = size;
+	block->Offset = GetBlockHeaderSize();
+
+	Current = block;
+	++BlockCount;
+}
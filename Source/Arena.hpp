@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Luft/Base.hpp"
+
+class Arena : public Allocator
+{
+public:
+	explicit Arena(usize blockSize, Allocator* parent = &GlobalAllocator::Get());
+	~Arena();
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	Arena(Arena&& move);
+	Arena& operator=(Arena&& move);
+
+	void* Allocate(usize size) override;
+	void Deallocate(void* data, usize size) override;
+
+	void Reset();
+
+	// Takes over every block of another arena with the same parent, so its allocations live as long as this one.
+	void Adopt(Arena* other);
+
+	usize GetAllocationCount() const { return AllocationCount; }
+	usize GetBlockCount() const { return BlockCount; }
+	usize GetUsedSize() const { return UsedSize; }
+
+private:
+	struct Block
+	{
+		Block* Previous;
+		usize Size;
+		usize Offset;
+	};
+
+	static usize GetBlockHeaderSize();
+
+	void AddBlock(usize minimumSize);
+
+	Allocator* Parent;
+	usize BlockSize;
+
+	Block* Current;
+
+	usize AllocationCount;
+	usize BlockCount;
+	usize UsedSize;
+};
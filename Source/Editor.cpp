@@ -179,7 +179,7 @@ Editor::Editor(Platform::Window* window, ::Renderer* renderer, ::CameraControlle
 	, Renderer(renderer)
 	, CameraController(cameraController)
 {
-	SetScene(0);
+	SetScene(0, false);
 }
 
 void Editor::Update()
@@ -214,9 +214,15 @@ void Editor::Update()
 			[this]
 			{
 				static usize sceneIndex = 0;
+				static bool flattenNodeHierarchy = false;
 				if (DropDown({ "Sponza"_view, "Bistro"_view, "Emerald Square"_view, "Sun Temple"_view }, &sceneIndex))
 				{
-					SetScene(sceneIndex);
+					SetScene(sceneIndex, flattenNodeHierarchy);
+				}
+
+				if (CheckButton("Flatten Nodes"_view, &flattenNodeHierarchy))
+				{
+					SetScene(sceneIndex, flattenNodeHierarchy);
 				}
 
 				static usize viewModeIndex = 0;
@@ -331,11 +337,15 @@ void Editor::Update()
 	}
 }
 
-void Editor::SetScene(usize sceneIndex)
+void Editor::SetScene(usize sceneIndex, bool flattenNodeHierarchy)
 {
 	const float64 start = Platform::GetTime();
 
-	GLTF::Scene scene = GLTF::LoadScene(Scenes[sceneIndex]);
+	GLTF::Scene scene = GLTF::LoadScene(Scenes[sceneIndex], GLTF::VertexLayout::Packed);
+	if (flattenNodeHierarchy)
+	{
+		GLTF::FlattenNodeHierarchy(&scene);
+	}
 
 	const GLTF::Camera defaultCamera =
 	{
@@ -19,7 +19,7 @@ public:
 	void Update();
 
 private:
-	void SetScene(usize sceneIndex);
+	void SetScene(usize sceneIndex, bool flattenNodeHierarchy);
 
 	Platform::Window* Window;
 	Renderer* Renderer;
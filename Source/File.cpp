@@ -0,0 +1,193 @@
+#include "File.hpp"
+
+#include "Luft/Platform.hpp"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+namespace File
+{
+
+static_assert(sizeof(OVERLAPPED) == 32);
+
+static OVERLAPPED* GetRequest(uint8* request)
+{
+	return reinterpret_cast<OVERLAPPED*>(request);
+}
+
+static usize GetRequestOffset(const OVERLAPPED& request)
+{
+	return static_cast<usize>(request.Offset) | (static_cast<usize>(request.OffsetHigh) << 32);
+}
+
+static HANDLE OpenForReading(StringView filePath, DWORD flags)
+{
+	char nullTerminatedPath[MAX_PATH];
+	VERIFY(filePath.GetLength() < sizeof(nullTerminatedPath), "File path is too long!");
+	Platform::MemoryCopy(nullTerminatedPath, filePath.GetData(), filePath.GetLength());
+	nullTerminatedPath[filePath.GetLength()] = '\0';
+
+	const HANDLE file = CreateFileA(nullTerminatedPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+	VERIFY(file != INVALID_HANDLE_VALUE, "Failed to open file!");
+	return file;
+}
+
+static usize QueryFileSize(HANDLE file)
+{
+	LARGE_INTEGER size;
+	VERIFY(GetFileSizeEx(file, &size), "Failed to get file size!");
+	return static_cast<usize>(size.QuadPart);
+}
+
+const uint8* Map(StringView filePath, usize* fileSize)
+{
+	CHECK(fileSize);
+
+	const HANDLE file = OpenForReading(filePath, FILE_FLAG_SEQUENTIAL_SCAN);
+	*fileSize = QueryFileSize(file);
+	VERIFY(*fileSize != 0, "Cannot map an empty file!");
+
+	const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	VERIFY(mapping, "Failed to map file!");
+
+	const void* fileData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	VERIFY(fileData, "Failed to map file!");
+
+	// The view keeps the mapping and the file open until it is unmapped.
+	CloseHandle(mapping);
+	CloseHandle(file);
+
+	return static_cast<const uint8*>(fileData);
+}
+
+void Unmap(const uint8* fileData)
+{
+	CHECK(fileData);
+	VERIFY(UnmapViewOfFile(fileData), "Failed to unmap file!");
+}
+
+void Prefetch(const uint8* data, usize size)
+{
+	CHECK(data);
+	if (size == 0)
+	{
+		return;
+	}
+
+	WIN32_MEMORY_RANGE_ENTRY range =
+	{
+		.VirtualAddress = const_cast<uint8*>(data),
+		.NumberOfBytes = size,
+	};
+	// Only a hint, so a failure just means the pages are read in as they are touched.
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+ChunkedReader::ChunkedReader(StringView filePath, usize chunkSize)
+	: Size(0)
+	, ChunkSize(chunkSize)
+	, Destination(nullptr)
+	, QueuedSize(0)
+	, CompletedSize(0)
+	, OldestRequest(0)
+	, RequestsInFlight(0)
+{
+	CHECK(chunkSize != 0 && chunkSize <= 0xFFFFFFFF);
+
+	Handle = OpenForReading(filePath, FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN);
+	Size = QueryFileSize(Handle);
+
+	for (usize requestIndex = 0; requestIndex < MaximumReadsInFlight; ++requestIndex)
+	{
+		OVERLAPPED* request = GetRequest(Requests[requestIndex]);
+		Platform::MemorySet(request, 0, sizeof(OVERLAPPED));
+
+		request->hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+		VERIFY(request->hEvent, "Failed to create file read event!");
+	}
+}
+
+ChunkedReader::~ChunkedReader()
+{
+	Cancel();
+
+	for (usize requestIndex = 0; requestIndex < MaximumReadsInFlight; ++requestIndex)
+	{
+		CloseHandle(GetRequest(Requests[requestIndex])->hEvent);
+	}
+	CloseHandle(Handle);
+}
+
+void ChunkedReader::Start(void* destination)
+{
+	CHECK(destination && !Destination);
+	Destination = static_cast<uint8*>(destination);
+
+	while (RequestsInFlight < MaximumReadsInFlight && QueuedSize < Size)
+	{
+		QueueRead();
+	}
+}
+
+usize ChunkedReader::WaitForChunk()
+{
+	CHECK(Destination);
+	if (RequestsInFlight == 0)
+	{
+		return CompletedSize;
+	}
+
+	OVERLAPPED* request = GetRequest(Requests[OldestRequest]);
+	const usize expectedSize = Min(ChunkSize, Size - GetRequestOffset(*request));
+
+	DWORD transferredSize = 0;
+	VERIFY(GetOverlappedResult(Handle, request, &transferredSize, TRUE), "Failed to read file!");
+	VERIFY(transferredSize == expectedSize, "Failed to read file!");
+
+	CompletedSize += transferredSize;
+	OldestRequest = (OldestRequest + 1) % MaximumReadsInFlight;
+	--RequestsInFlight;
+
+	if (QueuedSize < Size)
+	{
+		QueueRead();
+	}
+	return CompletedSize;
+}
+
+void ChunkedReader::Cancel()
+{
+	if (RequestsInFlight == 0)
+	{
+		return;
+	}
+
+	CancelIoEx(Handle, nullptr);
+	for (; RequestsInFlight != 0; --RequestsInFlight)
+	{
+		// Cancelled reads still have to be waited on before their buffer can be released.
+		DWORD transferredSize = 0;
+		GetOverlappedResult(Handle, GetRequest(Requests[OldestRequest]), &transferredSize, TRUE);
+		OldestRequest = (OldestRequest + 1) % MaximumReadsInFlight;
+	}
+}
+
+void ChunkedReader::QueueRead()
+{
+	CHECK(RequestsInFlight < MaximumReadsInFlight);
+
+	OVERLAPPED* request = GetRequest(Requests[(OldestRequest + RequestsInFlight) % MaximumReadsInFlight]);
+	request->Offset = static_cast<DWORD>(QueuedSize);
+	request->OffsetHigh = static_cast<DWORD>(QueuedSize >> 32);
+	ResetEvent(request->hEvent);
+
+	const usize readSize = Min(ChunkSize, Size - QueuedSize);
+	const BOOL completed = ReadFile(Handle, Destination + QueuedSize, static_cast<DWORD>(readSize), nullptr, request);
+	VERIFY(completed || GetLastError() == ERROR_IO_PENDING, "Failed to read file!");
+
+	QueuedSize += readSize;
+	++RequestsInFlight;
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Luft/Base.hpp"
+#include "Luft/NoCopy.hpp"
+#include "Luft/String.hpp"
+
+namespace File
+{
+
+// Maps a whole file read-only, so its pages are only read in once they are touched. Mapped files are read through
+// the page cache with no copy on the heap.
+const uint8* Map(StringView filePath, usize* fileSize);
+void Unmap(const uint8* fileData);
+
+// Starts reading the pages of a mapped range in the background, ahead of them being touched front to back.
+void Prefetch(const uint8* data, usize size);
+
+// Reads a file front to back in fixed-size chunks, keeping the reads of the next chunks in flight while the
+// caller works on the ones that have already landed.
+class ChunkedReader : public NoCopy
+{
+public:
+	ChunkedReader(StringView filePath, usize chunkSize);
+	~ChunkedReader();
+
+	usize GetSize() const
+	{
+		return Size;
+	}
+
+	// The destination must hold the whole file and stay alive until every read has completed or been cancelled.
+	void Start(void* destination);
+
+	// Blocks until the oldest read in flight completes, then returns how many bytes from the start of the file are
+	// ready.
+	usize WaitForChunk();
+
+	void Cancel();
+
+private:
+	static constexpr usize MaximumReadsInFlight = 2;
+	static constexpr usize RequestSize = 32;
+
+	void QueueRead();
+
+	void* Handle;
+	usize Size;
+	usize ChunkSize;
+
+	uint8* Destination;
+	usize QueuedSize;
+	usize CompletedSize;
+
+	// OVERLAPPED structures, kept opaque so that windows.h stays out of the header.
+	alignas(8) uint8 Requests[MaximumReadsInFlight][RequestSize];
+	usize OldestRequest;
+	usize RequestsInFlight;
+};
+
+}
@@ -1,21 +1,36 @@
 #include "GLTF.hpp"
+#include "File.hpp"
 #include "JSON.hpp"
+#include "Jobs.hpp"
+#include "Meshopt.hpp"
 
 #include "Luft/Platform.hpp"
 
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GLTF_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define GLTF_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace GLTF
 {
 
 static Allocator* Allocator = &GlobalAllocator::Get();
 
-static String ResolveFilePath(StringView sceneFilePath, StringView filePath)
+static String ResolveFilePath(StringView sceneFilePath, StringView filePath, ::Allocator* allocator)
 {
 	static constexpr char pathSeparator = '/';
 
 	const usize directoryLength = sceneFilePath.ReverseFind(pathSeparator);
 	VERIFY(directoryLength != INDEX_NONE, "Invalid GLTF file path!");
 
-	String fullPath(directoryLength + sizeof(pathSeparator) + filePath.GetLength(), Allocator);
+	String fullPath(directoryLength + sizeof(pathSeparator) + filePath.GetLength(), allocator);
 	fullPath.Append(StringView(sceneFilePath.GetData(), directoryLength));
 	fullPath.Append(pathSeparator);
 	fullPath.Append(filePath);
@@ -23,820 +38,3977 @@ static String ResolveFilePath(StringView sceneFilePath, StringView filePath)
 	return fullPath;
 }
 
-static Matrix InternalCalculateLocalToWorld(ArrayView<Node> nodes, usize nodeIndex)
+// Matrices are stored column by column, so each column of the product is the parent's columns weighted by one
+// column of the child.
+static void MultiplyTransforms(const Matrix& parentToWorld, const Matrix& localToParent, Matrix* localToWorld)
 {
-	if (nodeIndex == INDEX_NONE)
+#if GLTF_SIMD_X86
+	const float32* parent = &parentToWorld.M00;
+	const float32* local = &localToParent.M00;
+	float32* result = &localToWorld->M00;
+
+	const __m128 parentColumn0 = _mm_loadu_ps(parent + 0);
+	const __m128 parentColumn1 = _mm_loadu_ps(parent + 4);
+	const __m128 parentColumn2 = _mm_loadu_ps(parent + 8);
+	const __m128 parentColumn3 = _mm_loadu_ps(parent + 12);
+	for (usize column = 0; column < 4; ++column)
+	{
+		const float32* localColumn = local + column * 4;
+		__m128 resultColumn = _mm_mul_ps(parentColumn0, _mm_set1_ps(localColumn[0]));
+		resultColumn = _mm_add_ps(resultColumn, _mm_mul_ps(parentColumn1, _mm_set1_ps(localColumn[1])));
+		resultColumn = _mm_add_ps(resultColumn, _mm_mul_ps(parentColumn2, _mm_set1_ps(localColumn[2])));
+		resultColumn = _mm_add_ps(resultColumn, _mm_mul_ps(parentColumn3, _mm_set1_ps(localColumn[3])));
+		_mm_storeu_ps(result + column * 4, resultColumn);
+	}
+#elif GLTF_SIMD_NEON
+	const float32* parent = &parentToWorld.M00;
+	const float32* local = &localToParent.M00;
+	float32* result = &localToWorld->M00;
+
+	const float32x4_t parentColumn0 = vld1q_f32(parent + 0);
+	const float32x4_t parentColumn1 = vld1q_f32(parent + 4);
+	const float32x4_t parentColumn2 = vld1q_f32(parent + 8);
+	const float32x4_t parentColumn3 = vld1q_f32(parent + 12);
+	for (usize column = 0; column < 4; ++column)
 	{
-		return Matrix::Identity;
+		const float32x4_t localColumn = vld1q_f32(local + column * 4);
+		float32x4_t resultColumn = vmulq_laneq_f32(parentColumn0, localColumn, 0);
+		resultColumn = vfmaq_laneq_f32(resultColumn, parentColumn1, localColumn, 1);
+		resultColumn = vfmaq_laneq_f32(resultColumn, parentColumn2, localColumn, 2);
+		resultColumn = vfmaq_laneq_f32(resultColumn, parentColumn3, localColumn, 3);
+		vst1q_f32(result + column * 4, resultColumn);
 	}
+#else
+	*localToWorld = parentToWorld * localToParent;
+#endif
+}
+
+// One breadth first level of the hierarchy. Every parent sits on an earlier level, so the nodes of a level don't
+// depend on each other and are split into batches.
+struct TransformLevel
+{
+	ArrayView<Node> Nodes;
+	const usize* Order;
+	usize First;
+	usize Count;
+	Matrix* LocalToWorlds;
+};
+
+static constexpr usize TransformBatchSize = 4096;
 
-	const Node& node = nodes[nodeIndex];
-	return InternalCalculateLocalToWorld(nodes, node.Parent) * node.LocalToWorld;
+static void MultiplyTransformBatch(void* context, usize batchIndex)
+{
+	const TransformLevel* level = static_cast<const TransformLevel*>(context);
+
+	const usize first = level->First + batchIndex * TransformBatchSize;
+	const usize end = Min(first + TransformBatchSize, level->First + level->Count);
+	for (usize orderIndex = first; orderIndex < end; ++orderIndex)
+	{
+		const usize nodeIndex = level->Order[orderIndex];
+		const Node& node = level->Nodes[nodeIndex];
+		MultiplyTransforms(level->LocalToWorlds[node.Parent], node.LocalToWorld, &level->LocalToWorlds[nodeIndex]);
+	}
 }
 
-static float32x3 ToFloat3(const JSON::Array& floatArray)
+// Orders the nodes breadth first from the roots, so that every parent is done before its children and each node
+// takes one multiply no matter how deep it sits.
+static Array<Matrix> CalculateNodeLocalToWorlds(ArrayView<Node> nodes, ArrayView<usize> childNodes, Arena* storage)
 {
-	VERIFY(floatArray.GetCount() == 3, "Expected GLTF float array to have 3 components!");
-	return float32x3
+	Array<usize> order(nodes.GetCount(), Allocator);
+	for (usize nodeIndex = 0; nodeIndex < nodes.GetCount(); ++nodeIndex)
 	{
-		static_cast<float32>(floatArray[0].GetDecimal()),
-		static_cast<float32>(floatArray[1].GetDecimal()),
-		static_cast<float32>(floatArray[2].GetDecimal()),
-	};
+		if (nodes[nodeIndex].Parent == INDEX_NONE)
+		{
+			order.Add(nodeIndex);
+		}
+	}
+	const usize rootCount = order.GetCount();
+	for (usize orderIndex = 0; orderIndex < order.GetCount(); ++orderIndex)
+	{
+		const Node& node = nodes[order[orderIndex]];
+		for (usize childIndex = 0; childIndex < node.ChildNodeCount; ++childIndex)
+		{
+			order.Add(childNodes[node.FirstChildNode + childIndex]);
+		}
+	}
+	VERIFY(order.GetCount() == nodes.GetCount(), "GLTF node hierarchy contains a cycle!");
+
+	Array<Matrix> localToWorlds(nodes.GetCount(), storage);
+	localToWorlds.AddUninitialized(nodes.GetCount());
+	for (usize orderIndex = 0; orderIndex < rootCount; ++orderIndex)
+	{
+		localToWorlds[order[orderIndex]] = nodes[order[orderIndex]].LocalToWorld;
+	}
+
+	// The children of one level are added to the order together, so each level ends where the children of the
+	// level before it do.
+	usize levelFirst = 0;
+	usize levelEnd = rootCount;
+	while (levelEnd != order.GetCount())
+	{
+		usize nextLevelEnd = levelEnd;
+		for (usize orderIndex = levelFirst; orderIndex < levelEnd; ++orderIndex)
+		{
+			nextLevelEnd += nodes[order[orderIndex]].ChildNodeCount;
+		}
+
+		TransformLevel level =
+		{
+			.Nodes = nodes,
+			.Order = order.GetData(),
+			.First = levelEnd,
+			.Count = nextLevelEnd - levelEnd,
+			.LocalToWorlds = localToWorlds.GetData(),
+		};
+		Jobs::ParallelFor((level.Count + TransformBatchSize - 1) / TransformBatchSize, MultiplyTransformBatch, &level);
+
+		levelFirst = levelEnd;
+		levelEnd = nextLevelEnd;
+	}
+	return localToWorlds;
 }
 
-static float32x4 ToFloat4(const JSON::Array& floatArray)
+static constexpr Bounds EmptyBounds =
 {
-	VERIFY(floatArray.GetCount() == 4, "Expected GLTF float array to have 4 components!");
-	return float32x4
+	.Min = { FLT_MAX, FLT_MAX, FLT_MAX },
+	.Max = { -FLT_MAX, -FLT_MAX, -FLT_MAX },
+	.Center = { 0.0f, 0.0f, 0.0f },
+	.Radius = -1.0f,
+};
+
+static Bounds ToBounds(float32x3 minimum, float32x3 maximum)
+{
+	if (minimum.X > maximum.X || minimum.Y > maximum.Y || minimum.Z > maximum.Z)
 	{
-		static_cast<float32>(floatArray[0].GetDecimal()),
-		static_cast<float32>(floatArray[1].GetDecimal()),
-		static_cast<float32>(floatArray[2].GetDecimal()),
-		static_cast<float32>(floatArray[3].GetDecimal()),
+		return EmptyBounds;
+	}
+
+	const float32x3 extent = { maximum.X - minimum.X, maximum.Y - minimum.Y, maximum.Z - minimum.Z };
+	return Bounds
+	{
+		.Min = minimum,
+		.Max = maximum,
+		.Center = { (minimum.X + maximum.X) * 0.5f, (minimum.Y + maximum.Y) * 0.5f, (minimum.Z + maximum.Z) * 0.5f },
+		.Radius = sqrtf(extent.X * extent.X + extent.Y * extent.Y + extent.Z * extent.Z) * 0.5f,
 	};
 }
 
-Scene LoadScene(StringView filePath)
+struct PositionBounds
 {
-	const JSON::Object rootObject = JSON::Load(filePath);
+	const Scene* Scene;
+	usize Accessor;
 
-	const JSON::Array& sceneArray = rootObject["scenes"_view].GetArray();
-	VERIFY(sceneArray.GetCount() == 1, "GLTF file contains multiple scenes!");
+	float32x3 Min;
+	float32x3 Max;
+};
 
-	const JSON::Object& sceneObject = sceneArray[0].GetObject();
+// Takes the bounds the file gives when they are exact, and otherwise reads every position. Normalized positions are
+// always read, as the file gives their bounds before normalization.
+static void CalculatePositionBounds(void* context, usize index)
+{
+	PositionBounds& positionBounds = static_cast<PositionBounds*>(context)[index];
+	const Scene& scene = *positionBounds.Scene;
+	const Accessor& accessor = scene.Accessors[positionBounds.Accessor];
+	VERIFY(accessor.AccessorType == AccessorType::Vector3, "Unexpected GLTF position type!");
 
-	const JSON::Array& topLevelNodeArray = sceneObject["nodes"_view].GetArray();
-	Array<usize> topLevelNodes(topLevelNodeArray.GetCount(), Allocator);
-	for (const JSON::Value& nodeValue : topLevelNodeArray)
+	if (accessor.HasMinMax && !accessor.Normalized)
 	{
-		topLevelNodes.Add(static_cast<usize>(nodeValue.GetDecimal()));
+		positionBounds.Min = accessor.Min;
+		positionBounds.Max = accessor.Max;
+		return;
 	}
 
-	Array<Camera> cameraTemplates(Allocator);
-	if (rootObject.HasKey("cameras"_view))
+	float32 minimum[4] = { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX };
+	float32 maximum[4] = { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	if (accessor.Count == 0)
 	{
-		const JSON::Array& cameraArray = rootObject["cameras"_view].GetArray();
-		cameraTemplates.Reserve(cameraArray.GetCount());
-		for (const JSON::Value& cameraValue : cameraArray)
-		{
-			const JSON::Object& cameraObject = cameraValue.GetObject();
+		positionBounds.Min = EmptyBounds.Min;
+		positionBounds.Max = EmptyBounds.Max;
+		return;
+	}
 
-			const bool perspective = cameraObject.HasKey("perspective"_view) && cameraObject["type"_view].GetString() == "perspective"_view;
-			VERIFY(perspective, "Expected GLTF camera to be perspective!");
+	VERIFY(accessor.BufferView < scene.BufferViews.GetCount(), "Invalid GLTF accessor!");
+	const AccessorView view = GetAccessorView(scene, positionBounds.Accessor);
+	VERIFY(view.Offset + view.Size <= scene.Buffers[view.Buffer].Size, "Invalid GLTF accessor!");
+
+	const uint8* positions = scene.Buffers[view.Buffer].Data + view.Offset;
+	usize positionIndex = 0;
 
-			const JSON::Object& perspectiveObject = cameraObject["perspective"_view].GetObject();
+	// Whole float positions are loaded as four lanes, where the last one reads into the next position and is ignored.
+	// The final position has nothing after it, so it is read by components below.
+	if (accessor.ComponentType == ComponentType::Float32)
+	{
+#if GLTF_SIMD_X86
+		__m128 minimumLanes = _mm_loadu_ps(minimum);
+		__m128 maximumLanes = _mm_loadu_ps(maximum);
+		for (; positionIndex < accessor.Count - 1; ++positionIndex)
+		{
+			const __m128 position = _mm_loadu_ps(reinterpret_cast<const float32*>(positions + positionIndex * view.Stride));
+			minimumLanes = _mm_min_ps(minimumLanes, position);
+			maximumLanes = _mm_max_ps(maximumLanes, position);
+		}
+		_mm_storeu_ps(minimum, minimumLanes);
+		_mm_storeu_ps(maximum, maximumLanes);
+#elif GLTF_SIMD_NEON
+		float32x4_t minimumLanes = vld1q_f32(minimum);
+		float32x4_t maximumLanes = vld1q_f32(maximum);
+		for (; positionIndex < accessor.Count - 1; ++positionIndex)
+		{
+			const float32x4_t position = vld1q_f32(reinterpret_cast<const float32*>(positions + positionIndex * view.Stride));
+			minimumLanes = vminq_f32(minimumLanes, position);
+			maximumLanes = vmaxq_f32(maximumLanes, position);
+		}
+		vst1q_f32(minimum, minimumLanes);
+		vst1q_f32(maximum, maximumLanes);
+#endif
+	}
 
-			const float32 fieldOfViewYRadians = static_cast<float32>(perspectiveObject["yfov"_view].GetDecimal());
+	const usize componentSize = GetComponentSize(accessor.ComponentType);
+	for (; positionIndex < accessor.Count; ++positionIndex)
+	{
+		const uint8* position = positions + positionIndex * view.Stride;
+		for (usize componentIndex = 0; componentIndex < 3; ++componentIndex)
+		{
+			const float32 component = DecodeComponent(position + componentIndex * componentSize, accessor.ComponentType, accessor.Normalized);
+			minimum[componentIndex] = Min(minimum[componentIndex], component);
+			maximum[componentIndex] = Max(maximum[componentIndex], component);
+		}
+	}
 
-			const float32 aspectRatio = perspectiveObject.HasKey("aspectRatio"_view) ? static_cast<float32>(perspectiveObject["aspectRatio"_view].GetDecimal())
-																					 : 16.0f / 9.0f;
+	positionBounds.Min = float32x3 { minimum[0], minimum[1], minimum[2] };
+	positionBounds.Max = float32x3 { maximum[0], maximum[1], maximum[2] };
+}
 
-			const float32 near = static_cast<float32>(perspectiveObject["znear"_view].GetDecimal());
+// Primitives often share position streams, so each stream is bounded once, one to a job.
+static void CalculatePrimitiveBounds(Scene* scene)
+{
+	Array<usize> accessorPositionBounds(scene->Accessors.GetCount(), Allocator);
+	for (usize accessorIndex = 0; accessorIndex < scene->Accessors.GetCount(); ++accessorIndex)
+	{
+		accessorPositionBounds.Add(INDEX_NONE);
+	}
 
-			const float32 far = perspectiveObject.HasKey("zfar"_view) ? static_cast<float32>(perspectiveObject["zfar"_view].GetDecimal())
-																	  : 1000.0f;
+	Array<PositionBounds> positionBounds(Allocator);
+	for (const Primitive& primitive : scene->Primitives)
+	{
+		const usize positionAccessor = primitive.Attributes[static_cast<usize>(AttributeType::Position)];
+		if (positionAccessor == INDEX_NONE)
+		{
+			continue;
+		}
+		VERIFY(positionAccessor < scene->Accessors.GetCount(), "Invalid GLTF accessor!");
 
-			cameraTemplates.Add(Camera
+		if (accessorPositionBounds[positionAccessor] == INDEX_NONE)
+		{
+			accessorPositionBounds[positionAccessor] = positionBounds.GetCount();
+			positionBounds.Add(PositionBounds
 			{
-				.FieldOfViewYRadians = fieldOfViewYRadians,
-				.AspectRatio = aspectRatio,
-				.Near = near,
-				.Far = far,
+				.Scene = scene,
+				.Accessor = positionAccessor,
+				.Min = EmptyBounds.Min,
+				.Max = EmptyBounds.Max,
 			});
 		}
 	}
 
-	Array<Light> lightTemplates;
-	if (rootObject.HasKey("extensions"_view))
+	Jobs::ParallelFor(positionBounds.GetCount(), CalculatePositionBounds, positionBounds.GetData());
+
+	for (Primitive& primitive : scene->Primitives)
 	{
-		const JSON::Object& extensionsObject = rootObject["extensions"_view].GetObject();
-		if (extensionsObject.HasKey("KHR_lights_punctual"_view))
+		const usize positionAccessor = primitive.Attributes[static_cast<usize>(AttributeType::Position)];
+		if (positionAccessor == INDEX_NONE)
 		{
-			const JSON::Object& lightsPunctualObject = extensionsObject["KHR_lights_punctual"_view].GetObject();
-			const JSON::Array& lightsArray = lightsPunctualObject["lights"_view].GetArray();
-
-			for (const JSON::Value& light : lightsArray)
-			{
-				const JSON::Object& lightObject = light.GetObject();
-
-				const float32 intensity = lightObject.HasKey("intensity"_view) ? static_cast<float32>(lightObject["intensity"_view].GetDecimal())
-																			   : 1.0f;
+			primitive.Bounds = EmptyBounds;
+			continue;
+		}
 
-				const float32x3 color = lightObject.HasKey("color"_view) ? ToFloat3(lightObject["color"_view].GetArray())
-																		 : float32x3 { 1.0f, 1.0f, 1.0f };
+		const PositionBounds& primitivePositionBounds = positionBounds[accessorPositionBounds[positionAccessor]];
+		primitive.Bounds = ToBounds(primitivePositionBounds.Min, primitivePositionBounds.Max);
+	}
+}
 
-				LightType type = LightType::Directional;
+// The box is the one around the corners of the mesh box once they are transformed, and the sphere is the mesh sphere
+// scaled by the largest axis scale.
+static Bounds TransformBounds(const Bounds& bounds, const Matrix& localToWorld)
+{
+	if (bounds.Radius < 0.0f)
+	{
+		return EmptyBounds;
+	}
 
-				const String& typeString = lightObject["type"_view].GetString();
-				if (typeString == "directional"_view)
-				{
-					type = LightType::Directional;
-				}
-				else if (typeString == "point"_view)
-				{
-					type = LightType::Point;
-				}
-				else
-				{
-					CHECK(false);
-				}
+	const float32* columns = &localToWorld.M00;
+	const float32 center[3] = { bounds.Center.X, bounds.Center.Y, bounds.Center.Z };
+	const float32 halfExtent[3] = { bounds.Max.X - bounds.Center.X, bounds.Max.Y - bounds.Center.Y, bounds.Max.Z - bounds.Center.Z };
 
-				lightTemplates.Add(Light
-				{
-					.Type = type,
-					.Intensity = intensity,
-					.RGB = color,
-				});
-			}
+	float32 centerWS[3] = { columns[12], columns[13], columns[14] };
+	float32 halfExtentWS[3] = { 0.0f, 0.0f, 0.0f };
+	float32 largestScaleSquared = 0.0f;
+	for (usize column = 0; column < 3; ++column)
+	{
+		const float32* axis = columns + column * 4;
+		for (usize row = 0; row < 3; ++row)
+		{
+			centerWS[row] += axis[row] * center[column];
+			halfExtentWS[row] += fabsf(axis[row]) * halfExtent[column];
 		}
+		largestScaleSquared = Max(largestScaleSquared, axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
 	}
 
-	Array<usize> cameraIndices(Allocator);
-	Array<usize> lightIndices(Allocator);
-
-	const JSON::Array& nodeArray = rootObject["nodes"_view].GetArray();
-	Array<Node> nodes(nodeArray.GetCount(), Allocator);
-	for (usize nodeIndex = 0; nodeIndex < nodeArray.GetCount(); ++nodeIndex)
+	return Bounds
 	{
-		Matrix localToWorld = Matrix::Identity;
-		Array<usize> childNodes(Allocator);
-		usize mesh = INDEX_NONE;
-		usize camera = INDEX_NONE;
-		usize light = INDEX_NONE;
+		.Min = { centerWS[0] - halfExtentWS[0], centerWS[1] - halfExtentWS[1], centerWS[2] - halfExtentWS[2] },
+		.Max = { centerWS[0] + halfExtentWS[0], centerWS[1] + halfExtentWS[1], centerWS[2] + halfExtentWS[2] },
+		.Center = { centerWS[0], centerWS[1], centerWS[2] },
+		.Radius = bounds.Radius * sqrtf(largestScaleSquared),
+	};
+}
 
-		const JSON::Object& nodeObject = nodeArray[nodeIndex].GetObject();
+// Instanced nodes are bounded by the union of the bounds of their placements.
+static void CalculateNodeWorldBounds(Scene* scene)
+{
+	Array<Bounds> meshBounds(scene->Meshes.GetCount(), Allocator);
+	for (const Mesh& mesh : scene->Meshes)
+	{
+		float32x3 minimum = EmptyBounds.Min;
+		float32x3 maximum = EmptyBounds.Max;
+		for (usize primitiveIndex = mesh.FirstPrimitive; primitiveIndex < mesh.FirstPrimitive + mesh.PrimitiveCount; ++primitiveIndex)
+		{
+			const Bounds& primitiveBounds = scene->Primitives[primitiveIndex].Bounds;
+			minimum = float32x3 { Min(minimum.X, primitiveBounds.Min.X), Min(minimum.Y, primitiveBounds.Min.Y), Min(minimum.Z, primitiveBounds.Min.Z) };
+			maximum = float32x3 { Max(maximum.X, primitiveBounds.Max.X), Max(maximum.Y, primitiveBounds.Max.Y), Max(maximum.Z, primitiveBounds.Max.Z) };
+		}
+		meshBounds.Add(ToBounds(minimum, maximum));
+	}
 
-		const bool hasTranslation = nodeObject.HasKey("translation"_view);
-		const bool hasRotation = nodeObject.HasKey("rotation"_view);
-		const bool hasScale = nodeObject.HasKey("scale"_view);
-		if (hasTranslation || hasRotation || hasScale)
+	scene->NodeWorldBounds = Array<Bounds>(scene->Nodes.GetCount(), scene->Storage);
+	scene->InstanceWorldBounds = Array<Bounds>(scene->InstanceLocalToWorlds.GetCount(), scene->Storage);
+	scene->InstanceWorldBounds.AddUninitialized(scene->InstanceLocalToWorlds.GetCount());
+	for (usize nodeIndex = 0; nodeIndex < scene->Nodes.GetCount(); ++nodeIndex)
+	{
+		const Node& node = scene->Nodes[nodeIndex];
+		if (node.Mesh == INDEX_NONE)
 		{
-			VERIFY(!nodeObject.HasKey("matrix"_view), "Invalid GLTF node property combination!");
+			scene->NodeWorldBounds.Add(EmptyBounds);
+			continue;
+		}
+		VERIFY(node.Mesh < meshBounds.GetCount(), "Invalid GLTF mesh!");
 
-			Vector translation = Vector::Zero;
-			if (hasTranslation)
-			{
-				const JSON::Array& translationArray = nodeObject["translation"_view].GetArray();
-				VERIFY(translationArray.GetCount() == 3, "Invalid GLTF translation!");
+		if (node.InstanceCount == 0)
+		{
+			scene->NodeWorldBounds.Add(TransformBounds(meshBounds[node.Mesh], scene->NodeLocalToWorlds[nodeIndex]));
+			continue;
+		}
 
-				translation = Vector(static_cast<float32>(translationArray[0].GetDecimal()),
-									 static_cast<float32>(translationArray[1].GetDecimal()),
-									 static_cast<float32>(translationArray[2].GetDecimal()));
-			}
+		float32x3 minimum = EmptyBounds.Min;
+		float32x3 maximum = EmptyBounds.Max;
+		for (usize instanceIndex = node.FirstInstance; instanceIndex < node.FirstInstance + node.InstanceCount; ++instanceIndex)
+		{
+			const Bounds instanceBounds = TransformBounds(meshBounds[node.Mesh], scene->InstanceLocalToWorlds[instanceIndex]);
+			scene->InstanceWorldBounds[instanceIndex] = instanceBounds;
 
-			Quaternion rotation = Quaternion::Identity;
-			if (hasRotation)
-			{
-				const JSON::Array& rotationArray = nodeObject["rotation"_view].GetArray();
-				VERIFY(rotationArray.GetCount() == 4, "Invalid GLTF rotation!");
+			minimum = float32x3 { Min(minimum.X, instanceBounds.Min.X), Min(minimum.Y, instanceBounds.Min.Y), Min(minimum.Z, instanceBounds.Min.Z) };
+			maximum = float32x3 { Max(maximum.X, instanceBounds.Max.X), Max(maximum.Y, instanceBounds.Max.Y), Max(maximum.Z, instanceBounds.Max.Z) };
+		}
+		scene->NodeWorldBounds.Add(ToBounds(minimum, maximum));
+	}
+}
 
-				rotation = Quaternion(static_cast<float32>(rotationArray[0].GetDecimal()),
-									  static_cast<float32>(rotationArray[1].GetDecimal()),
-									  static_cast<float32>(rotationArray[2].GetDecimal()),
-									  static_cast<float32>(rotationArray[3].GetDecimal()));
-			}
+// XXH64, fed in pieces so that interleaved streams can be hashed one element at a time.
+class StreamHasher
+{
+public:
+	StreamHasher()
+		: Lanes { Prime1 + Prime2, Prime2, 0, 0 - Prime1 }
+		, PendingSize(0)
+		, TotalSize(0)
+	{
+	}
 
-			Vector scale(1.0f, 1.0f, 1.0f);
-			if (hasScale)
-			{
-				const JSON::Array& scaleArray = nodeObject["scale"_view].GetArray();
-				VERIFY(scaleArray.GetCount() == 3, "Invalid GLTF scale!");
+	void Add(const uint8* data, usize size)
+	{
+		TotalSize += size;
 
-				scale = Vector(static_cast<float32>(scaleArray[0].GetDecimal()),
-							   static_cast<float32>(scaleArray[1].GetDecimal()),
-							   static_cast<float32>(scaleArray[2].GetDecimal()));
-			}
+		if (PendingSize + size < BlockSize)
+		{
+			Platform::MemoryCopy(Pending + PendingSize, data, size);
+			PendingSize += size;
+			return;
+		}
 
-			localToWorld = Matrix::Translation(translation.X, translation.Y, translation.Z) *
-						   rotation.ToMatrix() *
-						   Matrix::Scale(scale.X, scale.Y, scale.Z);
+		if (PendingSize > 0)
+		{
+			const usize fillSize = BlockSize - PendingSize;
+			Platform::MemoryCopy(Pending + PendingSize, data, fillSize);
+			AddBlock(Pending);
+			data += fillSize;
+			size -= fillSize;
+			PendingSize = 0;
 		}
-		if (nodeObject.HasKey("matrix"_view))
+
+		for (; size >= BlockSize; data += BlockSize, size -= BlockSize)
 		{
-			VERIFY(!nodeObject.HasKey("translation"_view) &&
-				   !nodeObject.HasKey("rotation"_view) &&
-				   !nodeObject.HasKey("scale"_view), "Invalid GLTF node property combination!");
+			AddBlock(data);
+		}
 
-			const JSON::Array& matrixArray = nodeObject["matrix"_view].GetArray();
-			VERIFY(matrixArray.GetCount() == 16, "Invalid GLTF matrix!");
+		Platform::MemoryCopy(Pending, data, size);
+		PendingSize = size;
+	}
 
-			float32* element = &localToWorld.M00;
-			for (const JSON::Value& elementValue : matrixArray)
+	uint64 Finish() const
+	{
+		uint64 hash;
+		if (TotalSize >= BlockSize)
+		{
+			hash = RotateLeft(Lanes[0], 1) + RotateLeft(Lanes[1], 7) + RotateLeft(Lanes[2], 12) + RotateLeft(Lanes[3], 18);
+			for (const uint64 lane : Lanes)
 			{
-				*element = static_cast<float32>(elementValue.GetDecimal());
-				++element;
+				hash = (hash ^ Round(0, lane)) * Prime1 + Prime4;
 			}
 		}
-		if (nodeObject.HasKey("children"_view))
+		else
 		{
-			const JSON::Array& childrenArray = nodeObject["children"_view].GetArray();
-			childNodes.Reserve(childrenArray.GetCount());
-			for (const JSON::Value& childValue : childrenArray)
-			{
-				childNodes.Add(static_cast<usize>(childValue.GetDecimal()));
-			}
+			hash = Prime5;
 		}
-		if (nodeObject.HasKey("mesh"_view))
+		hash += TotalSize;
+
+		usize offset = 0;
+		for (; offset + sizeof(uint64) <= PendingSize; offset += sizeof(uint64))
 		{
-			mesh = static_cast<usize>(nodeObject["mesh"_view].GetDecimal());
+			hash ^= Round(0, Read<uint64>(Pending + offset));
+			hash = RotateLeft(hash, 27) * Prime1 + Prime4;
 		}
-		if (nodeObject.HasKey("camera"_view))
+		if (offset + sizeof(uint32) <= PendingSize)
 		{
-			camera = static_cast<usize>(nodeObject["camera"_view].GetDecimal());
-			cameraIndices.Add(nodeIndex);
+			hash ^= Read<uint32>(Pending + offset) * Prime1;
+			hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+			offset += sizeof(uint32);
 		}
-		if (nodeObject.HasKey("extensions"_view))
+		for (; offset < PendingSize; ++offset)
 		{
-			const JSON::Object& extensionsObject = nodeObject["extensions"_view].GetObject();
-			if (extensionsObject.HasKey("KHR_lights_punctual"_view))
-			{
-				lightIndices.Add(nodeIndex);
-
-				const JSON::Object& lightsPunctualObject = extensionsObject["KHR_lights_punctual"_view].GetObject();
-				light = static_cast<usize>(lightsPunctualObject["light"_view].GetDecimal());
-			}
+			hash ^= Pending[offset] * Prime5;
+			hash = RotateLeft(hash, 11) * Prime1;
 		}
 
-		nodes.Add(Node
-		{
-			.LocalToWorld = localToWorld,
-			.Parent = INDEX_NONE,
-			.ChildNodes = Move(childNodes),
-			.Mesh = mesh,
-			.Camera = camera,
-			.Light = light,
-		});
+		hash ^= hash >> 33;
+		hash *= Prime2;
+		hash ^= hash >> 29;
+		hash *= Prime3;
+		hash ^= hash >> 32;
+		return hash;
 	}
 
-	for (usize nodeIndex = 0; nodeIndex < nodes.GetCount(); ++nodeIndex)
-	{
-		const Node& node = nodes[nodeIndex];
+private:
+	static constexpr uint64 Prime1 = 0x9E3779B185EBCA87ull;
+	static constexpr uint64 Prime2 = 0xC2B2AE3D27D4EB4Full;
+	static constexpr uint64 Prime3 = 0x165667B19E3779F9ull;
+	static constexpr uint64 Prime4 = 0x85EBCA77C2B2AE63ull;
+	static constexpr uint64 Prime5 = 0x27D4EB2F165667C5ull;
 
-		for (const usize childNodeIndex : node.ChildNodes)
-		{
-			nodes[childNodeIndex].Parent = nodeIndex;
-		}
-	}
+	static constexpr usize BlockSize = 32;
 
-	Array<Camera> cameras(cameraIndices.GetCount(), Allocator);
-	for (usize cameraIndex : cameraIndices)
+	static uint64 RotateLeft(uint64 value, uint32 count)
 	{
-		const Node& node = nodes[cameraIndex];
-
-		Camera placedCamera = cameraTemplates[node.Camera];
-		placedCamera.LocalToWorld = InternalCalculateLocalToWorld(nodes, cameraIndex);
-		cameras.Add(placedCamera);
+		return (value << count) | (value >> (64 - count));
 	}
 
-	Array<Light> lights(lightIndices.GetCount(), Allocator);
-	for (usize lightIndex : lightIndices)
+	static uint64 Round(uint64 lane, uint64 input)
 	{
-		const Node& node = nodes[lightIndex];
+		return RotateLeft(lane + input * Prime2, 31) * Prime1;
+	}
 
-		Light placedLight = lightTemplates[node.Light];
-		placedLight.LocalToWorld = InternalCalculateLocalToWorld(nodes, lightIndex);
-		lights.Add(placedLight);
+	template<typename T>
+	static T Read(const uint8* data)
+	{
+		T value;
+		Platform::MemoryCopy(&value, data, sizeof(value));
+		return value;
 	}
 
-	const JSON::Array& bufferArray = rootObject["buffers"_view].GetArray();
-	Array<Buffer> buffers(bufferArray.GetCount(), Allocator);
-	for (const JSON::Value& bufferValue : bufferArray)
+	void AddBlock(const uint8* block)
 	{
-		const JSON::Object& bufferObject = bufferValue.GetObject();
+		for (usize lane = 0; lane < ARRAY_COUNT(Lanes); ++lane)
+		{
+			Lanes[lane] = Round(Lanes[lane], Read<uint64>(block + lane * sizeof(uint64)));
+		}
+	}
 
-		const String& bufferPath = bufferObject["uri"_view].GetString();
-		const String fullPath = ResolveFilePath(filePath, bufferPath);
+	uint64 Lanes[4];
 
-		const usize bufferSize = static_cast<usize>(bufferObject["byteLength"_view].GetDecimal());
+	uint8 Pending[BlockSize];
+	usize PendingSize;
+	usize TotalSize;
+};
 
-		usize fileSize;
-		uint8* bufferData = Platform::ReadEntireFile(fullPath, &fileSize, Allocator);
-		VERIFY(bufferSize == fileSize, "Failed to read GLTF buffer!");
+struct StreamHash
+{
+	const Scene* Scene;
+	usize Accessor;
 
-		buffers.Add(Buffer
-		{
-			.Data = bufferData,
-			.Size = bufferSize,
-		});
-	}
+	uint64 Hash;
+};
 
-	const JSON::Array& bufferViewArray = rootObject["bufferViews"_view].GetArray();
-	Array<BufferView> bufferViews(bufferViewArray.GetCount(), Allocator);
-	for (const JSON::Value& bufferViewValue : bufferViewArray)
-	{
-		const JSON::Object& bufferViewObject = bufferViewValue.GetObject();
+// The hash covers the element bytes and nothing between them, so the same data stored with different strides matches.
+static void HashStream(void* context, usize index)
+{
+	StreamHash& streamHash = static_cast<StreamHash*>(context)[index];
+	const Scene& scene = *streamHash.Scene;
+	const Accessor& accessor = scene.Accessors[streamHash.Accessor];
 
-		const usize buffer = static_cast<usize>(bufferViewObject["buffer"_view].GetDecimal());
-		const usize size = static_cast<usize>(bufferViewObject["byteLength"_view].GetDecimal());
+	StreamHasher hasher;
+
+	const uint8 format[] =
+	{
+		static_cast<uint8>(accessor.ComponentType),
+		static_cast<uint8>(accessor.AccessorType),
+		static_cast<uint8>(accessor.Normalized),
+	};
+	hasher.Add(format, sizeof(format));
+	hasher.Add(reinterpret_cast<const uint8*>(&accessor.Count), sizeof(accessor.Count));
 
-		const usize offset = bufferViewObject.HasKey("byteOffset"_view) ? static_cast<usize>(bufferViewObject["byteOffset"_view].GetDecimal())
-																		: 0;
+	if (accessor.Count > 0)
+	{
+		const AccessorView view = GetAccessorView(scene, streamHash.Accessor);
+		const usize elementSize = GetElementSize(accessor.AccessorType, accessor.ComponentType);
+		const uint8* elements = scene.Buffers[view.Buffer].Data + view.Offset;
 
-		TargetType targetType = TargetType::ArrayBuffer;
-		if (bufferViewObject.HasKey("target"_view))
+		if (view.Stride == elementSize)
 		{
-			const usize targetTypeNumber = static_cast<usize>(bufferViewObject["target"_view].GetDecimal());
-			if (targetTypeNumber == 34962)
-			{
-				targetType = TargetType::ArrayBuffer;
-			}
-			else if (targetTypeNumber == 34963)
-			{
-				targetType = TargetType::ElementArrayBuffer;
-			}
-			else
+			hasher.Add(elements, accessor.Count * elementSize);
+		}
+		else
+		{
+			for (usize elementIndex = 0; elementIndex < accessor.Count; ++elementIndex)
 			{
-				VERIFY(false, "Unexpected GLTF target type!");
+				hasher.Add(elements + elementIndex * view.Stride, elementSize);
 			}
 		}
-
-		bufferViews.Add(BufferView
-		{
-			.Buffer = buffer,
-			.Size = size,
-			.Offset = offset,
-			.Target = targetType,
-		});
 	}
 
-	const JSON::Array& meshArray = rootObject["meshes"_view].GetArray();
-	Array<Mesh> meshes(meshArray.GetCount(), Allocator);
-	for (const JSON::Value& meshValue : meshArray)
+	streamHash.Hash = hasher.Finish();
+}
+
+static bool AreStreamsEqual(const Scene& scene, usize accessorIndexA, usize accessorIndexB)
+{
+	const Accessor& accessorA = scene.Accessors[accessorIndexA];
+	const Accessor& accessorB = scene.Accessors[accessorIndexB];
+	if (accessorA.ComponentType != accessorB.ComponentType ||
+		accessorA.AccessorType != accessorB.AccessorType ||
+		accessorA.Normalized != accessorB.Normalized ||
+		accessorA.Count != accessorB.Count)
+	{
+		return false;
+	}
+	if (accessorA.Count == 0)
 	{
-		const JSON::Object& meshObject = meshValue.GetObject();
+		return true;
+	}
 
-		const JSON::Array& primitiveArray = meshObject["primitives"_view].GetArray();
-		Array<Primitive> primitives(primitiveArray.GetCount());
-		for (const JSON::Value& primitiveValue : primitiveArray)
+	const AccessorView viewA = GetAccessorView(scene, accessorIndexA);
+	const AccessorView viewB = GetAccessorView(scene, accessorIndexB);
+	const usize elementSize = GetElementSize(accessorA.AccessorType, accessorA.ComponentType);
+	const uint8* elementsA = scene.Buffers[viewA.Buffer].Data + viewA.Offset;
+	const uint8* elementsB = scene.Buffers[viewB.Buffer].Data + viewB.Offset;
+
+	if (viewA.Stride == elementSize && viewB.Stride == elementSize)
+	{
+		return memcmp(elementsA, elementsB, accessorA.Count * elementSize) == 0;
+	}
+	for (usize elementIndex = 0; elementIndex < accessorA.Count; ++elementIndex)
+	{
+		if (memcmp(elementsA + elementIndex * viewA.Stride, elementsB + elementIndex * viewB.Stride, elementSize) != 0)
 		{
-			const JSON::Object& primitiveObject = primitiveValue.GetObject();
+			return false;
+		}
+	}
+	return true;
+}
 
-			if (primitiveObject.HasKey("mode"_view))
-			{
-				VERIFY(static_cast<usize>(primitiveObject["mode"_view].GetDecimal()) == 4, "Unexpected GLTF primitive type!");
-			}
+// Streams shared between primitives are only hashed once.
+static void AddStreamHash(const Scene& scene, usize accessorIndex, Array<usize>* accessorStreams, Array<StreamHash>* streamHashes)
+{
+	if (accessorIndex == INDEX_NONE)
+	{
+		return;
+	}
+	VERIFY(accessorIndex < scene.Accessors.GetCount(), "Invalid GLTF accessor!");
+	if ((*accessorStreams)[accessorIndex] != INDEX_NONE)
+	{
+		return;
+	}
 
-			const usize indices = static_cast<usize>(primitiveObject["indices"_view].GetDecimal());
-			const usize material = static_cast<usize>(primitiveObject["material"_view].GetDecimal());
+	const Accessor& accessor = scene.Accessors[accessorIndex];
+	VERIFY(accessor.BufferView < scene.BufferViews.GetCount(), "Invalid GLTF accessor!");
+	if (accessor.Count > 0)
+	{
+		const AccessorView view = GetAccessorView(scene, accessorIndex);
+		VERIFY(view.Offset + view.Size <= scene.Buffers[view.Buffer].Size, "Invalid GLTF accessor!");
+	}
 
-			const JSON::Object& attributesObject = primitiveObject["attributes"_view].GetObject();
-			HashTable<AttributeType, usize> attributes(4, Allocator);
+	(*accessorStreams)[accessorIndex] = streamHashes->GetCount();
+	streamHashes->Add(StreamHash
+	{
+		.Scene = &scene,
+		.Accessor = accessorIndex,
+		.Hash = 0,
+	});
+}
 
-			if (attributesObject.HasKey("POSITION"_view))
-			{
-				attributes.Add(AttributeType::Position, static_cast<usize>(attributesObject["POSITION"_view].GetDecimal()));
-			}
-			if (attributesObject.HasKey("NORMAL"_view))
-			{
-				attributes.Add(AttributeType::Normal, static_cast<usize>(attributesObject["NORMAL"_view].GetDecimal()));
-			}
-			if (attributesObject.HasKey("TANGENT"_view))
-			{
-				attributes.Add(AttributeType::Tangent, static_cast<usize>(attributesObject["TANGENT"_view].GetDecimal()));
-			}
-			if (attributesObject.HasKey("TEXCOORD_0"_view))
-			{
-				attributes.Add(AttributeType::TexCoord0, static_cast<usize>(attributesObject["TEXCOORD_0"_view].GetDecimal()));
-			}
+// Exporters often write the same geometry once per mesh that uses it. Streams holding the same elements are found by
+// hash, one stream to a job, and confirmed byte for byte, after which every primitive reads the first of them. Packing
+// then copies one stream where there were several, and primitives left with the same positions and indices point at
+// the first primitive to have them, so the renderer can share its acceleration structure.
+static void DeduplicateStreams(Scene* scene)
+{
+	static constexpr usize minimumSlotCount = 64;
 
-			primitives.Add(Primitive
+	Array<usize> accessorStreams(scene->Accessors.GetCount(), Allocator);
+	for (usize accessorIndex = 0; accessorIndex < scene->Accessors.GetCount(); ++accessorIndex)
+	{
+		accessorStreams.Add(INDEX_NONE);
+	}
+
+	Array<StreamHash> streamHashes(Allocator);
+	for (const Primitive& primitive : scene->Primitives)
+	{
+		for (const usize accessorIndex : primitive.Attributes)
+		{
+			AddStreamHash(*scene, accessorIndex, &accessorStreams, &streamHashes);
+		}
+		AddStreamHash(*scene, primitive.Indices, &accessorStreams, &streamHashes);
+	}
+
+	Jobs::ParallelFor(streamHashes.GetCount(), HashStream, streamHashes.GetData());
+
+	usize slotCount = minimumSlotCount;
+	while (slotCount < streamHashes.GetCount() * 2)
+	{
+		slotCount *= 2;
+	}
+	const usize slotMask = slotCount - 1;
+
+	Array<usize> slots(slotCount, Allocator);
+	for (usize slot = 0; slot < slotCount; ++slot)
+	{
+		slots.Add(INDEX_NONE);
+	}
+
+	// Each stream is mapped to the accessor of the first stream with the same elements.
+	Array<usize> canonicalAccessors(scene->Accessors.GetCount(), Allocator);
+	for (usize accessorIndex = 0; accessorIndex < scene->Accessors.GetCount(); ++accessorIndex)
+	{
+		canonicalAccessors.Add(accessorIndex);
+	}
+
+	usize duplicateCount = 0;
+	usize duplicateSize = 0;
+	for (usize streamIndex = 0; streamIndex < streamHashes.GetCount(); ++streamIndex)
+	{
+		const StreamHash& streamHash = streamHashes[streamIndex];
+
+		usize slot = streamHash.Hash & slotMask;
+		for (; slots[slot] != INDEX_NONE; slot = (slot + 1) & slotMask)
+		{
+			const StreamHash& other = streamHashes[slots[slot]];
+			if (other.Hash == streamHash.Hash && AreStreamsEqual(*scene, other.Accessor, streamHash.Accessor))
+			{
+				break;
+			}
+		}
+
+		if (slots[slot] == INDEX_NONE)
+		{
+			slots[slot] = streamIndex;
+			continue;
+		}
+
+		const Accessor& accessor = scene->Accessors[streamHash.Accessor];
+		canonicalAccessors[streamHash.Accessor] = streamHashes[slots[slot]].Accessor;
+		++duplicateCount;
+		duplicateSize += accessor.Count * GetElementSize(accessor.AccessorType, accessor.ComponentType);
+	}
+
+	for (Primitive& primitive : scene->Primitives)
+	{
+		for (usize& accessorIndex : primitive.Attributes)
+		{
+			if (accessorIndex != INDEX_NONE)
+			{
+				accessorIndex = canonicalAccessors[accessorIndex];
+			}
+		}
+		if (primitive.Indices != INDEX_NONE)
+		{
+			primitive.Indices = canonicalAccessors[primitive.Indices];
+		}
+	}
+
+	// Primitives with the same geometry now have the same position and index accessors, so matching those suffices.
+	for (usize slot = 0; slot < slotCount; ++slot)
+	{
+		slots[slot] = INDEX_NONE;
+	}
+
+	usize sharedGeometryCount = 0;
+	for (usize primitiveIndex = 0; primitiveIndex < scene->Primitives.GetCount(); ++primitiveIndex)
+	{
+		Primitive& primitive = scene->Primitives[primitiveIndex];
+		const usize positionAccessor = primitive.Attributes[static_cast<usize>(AttributeType::Position)];
+		primitive.Geometry = primitiveIndex;
+		if (positionAccessor == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const uint64 geometryHash = (static_cast<uint64>(positionAccessor) * 0x9E3779B97F4A7C15ull) ^ primitive.Indices;
+
+		usize slot = geometryHash & slotMask;
+		for (; slots[slot] != INDEX_NONE; slot = (slot + 1) & slotMask)
+		{
+			const Primitive& other = scene->Primitives[slots[slot]];
+			if (other.Attributes[static_cast<usize>(AttributeType::Position)] == positionAccessor && other.Indices == primitive.Indices)
+			{
+				break;
+			}
+		}
+
+		if (slots[slot] == INDEX_NONE)
+		{
+			slots[slot] = primitiveIndex;
+			continue;
+		}
+
+		primitive.Geometry = slots[slot];
+		++sharedGeometryCount;
+	}
+
+	Platform::LogFormatted("GLTF::LoadScene: Merged %zu of %zu streams (%zu KB) and %zu of %zu primitive geometries\n",
+						   duplicateCount,
+						   streamHashes.GetCount(),
+						   duplicateSize / 1024,
+						   sharedGeometryCount,
+						   scene->Primitives.GetCount());
+}
+
+static float32x3 ToFloat3(JSON::Array floatArray)
+{
+	VERIFY(floatArray.GetCount() == 3, "Expected GLTF float array to have 3 components!");
+	return float32x3
+	{
+		static_cast<float32>(floatArray[0].GetDecimal()),
+		static_cast<float32>(floatArray[1].GetDecimal()),
+		static_cast<float32>(floatArray[2].GetDecimal()),
+	};
+}
+
+static float32x4 ToFloat4(JSON::Array floatArray)
+{
+	VERIFY(floatArray.GetCount() == 4, "Expected GLTF float array to have 4 components!");
+	return float32x4
+	{
+		static_cast<float32>(floatArray[0].GetDecimal()),
+		static_cast<float32>(floatArray[1].GetDecimal()),
+		static_cast<float32>(floatArray[2].GetDecimal()),
+		static_cast<float32>(floatArray[3].GetDecimal()),
+	};
+}
+
+static Matrix ToLocalToParent(Vector translation, Quaternion rotation, Vector scale)
+{
+	return Matrix::Translation(translation.X, translation.Y, translation.Z) *
+		   rotation.ToMatrix() *
+		   Matrix::Scale(scale.X, scale.Y, scale.Z);
+}
+
+static LightType ParseLightType(StringView typeString)
+{
+	if (typeString == "directional"_view)
+	{
+		return LightType::Directional;
+	}
+	if (typeString == "point"_view)
+	{
+		return LightType::Point;
+	}
+	CHECK(false);
+	return LightType::Directional;
+}
+
+static TargetType ParseTargetType(usize targetTypeNumber)
+{
+	if (targetTypeNumber == 34962)
+	{
+		return TargetType::ArrayBuffer;
+	}
+	if (targetTypeNumber == 34963)
+	{
+		return TargetType::ElementArrayBuffer;
+	}
+	VERIFY(false, "Unexpected GLTF target type!");
+	return TargetType::ArrayBuffer;
+}
+
+static ComponentType ParseComponentType(usize componentTypeNumber)
+{
+	switch (componentTypeNumber)
+	{
+	case 5120:
+		return ComponentType::Int8;
+	case 5121:
+		return ComponentType::UInt8;
+	case 5122:
+		return ComponentType::Int16;
+	case 5123:
+		return ComponentType::UInt16;
+	case 5125:
+		return ComponentType::UInt32;
+	case 5126:
+		return ComponentType::Float32;
+	default:
+		VERIFY(false, "Unexpected GLTF component type!");
+		break;
+	}
+	return ComponentType::Int8;
+}
+
+static AccessorType ParseAccessorType(StringView accessorTypeString)
+{
+	if (accessorTypeString == "SCALAR"_view)
+	{
+		return AccessorType::Scalar;
+	}
+	if (accessorTypeString == "VEC2"_view)
+	{
+		return AccessorType::Vector2;
+	}
+	if (accessorTypeString == "VEC3"_view)
+	{
+		return AccessorType::Vector3;
+	}
+	if (accessorTypeString == "VEC4"_view)
+	{
+		return AccessorType::Vector4;
+	}
+	if (accessorTypeString == "MAT2"_view)
+	{
+		return AccessorType::Matrix2;
+	}
+	if (accessorTypeString == "MAT3"_view)
+	{
+		return AccessorType::Matrix3;
+	}
+	if (accessorTypeString == "MAT4"_view)
+	{
+		return AccessorType::Matrix4;
+	}
+	VERIFY(false, "Unexpected GLTF accessor type!");
+	return AccessorType::Scalar;
+}
+
+static AlphaMode ParseAlphaMode(StringView alphaModeString)
+{
+	if (alphaModeString == "OPAQUE"_view)
+	{
+		return AlphaMode::Opaque;
+	}
+	if (alphaModeString == "MASK"_view)
+	{
+		return AlphaMode::Mask;
+	}
+	if (alphaModeString == "BLEND"_view)
+	{
+		return AlphaMode::Blend;
+	}
+	VERIFY(false, "Unexpected GLTF alpha mode!");
+	return AlphaMode::Opaque;
+}
+
+static Filter ParseFilter(usize filter, bool magnification)
+{
+	if (magnification)
+	{
+		CHECK(filter == 9728 || filter == 9729);
+	}
+
+	switch (filter)
+	{
+	case 9728:
+		return Filter::Nearest;
+	case 9729:
+		return Filter::Linear;
+	case 9984:
+		return Filter::NearestMipMapNearest;
+	case 9985:
+		return Filter::LinearMipMapNearest;
+	case 9986:
+		return Filter::NearestMipMapLinear;
+	case 9987:
+		return Filter::LinearMipMapLinear;
+	default:
+		CHECK(false);
+	}
+	return Filter::Nearest;
+}
+
+static Address ParseAddress(usize address)
+{
+	switch (address)
+	{
+	case 10497:
+		return Address::Repeat;
+	case 33071:
+		return Address::ClampToEdge;
+	case 33648:
+		return Address::MirroredRepeat;
+	default:
+		CHECK(false);
+	}
+	return Address::Repeat;
+}
+
+static Meshopt::Mode ParseMeshoptMode(StringView modeString)
+{
+	if (modeString == "ATTRIBUTES"_view)
+	{
+		return Meshopt::Mode::Attributes;
+	}
+	if (modeString == "TRIANGLES"_view)
+	{
+		return Meshopt::Mode::Triangles;
+	}
+	VERIFY(modeString == "INDICES"_view, "Unexpected GLTF meshopt compression mode!");
+	return Meshopt::Mode::Indices;
+}
+
+static Meshopt::Filter ParseMeshoptFilter(StringView filterString)
+{
+	if (filterString == "NONE"_view)
+	{
+		return Meshopt::Filter::None;
+	}
+	if (filterString == "OCTAHEDRAL"_view)
+	{
+		return Meshopt::Filter::Octahedral;
+	}
+	if (filterString == "QUATERNION"_view)
+	{
+		return Meshopt::Filter::Quaternion;
+	}
+	VERIFY(filterString == "EXPONENTIAL"_view, "Unexpected GLTF meshopt compression filter!");
+	return Meshopt::Filter::Exponential;
+}
+
+static void LogParsedManifest(const JSON::Document& document, float64 parseStart)
+{
+	const float64 parseEnd = Platform::GetTime();
+	Platform::LogFormatted("GLTF::LoadScene: Parsed manifest in %.2fms (%zu allocations in %zu blocks, %zu KB)\n",
+						   (parseEnd - parseStart) * 1000.0,
+						   document.GetStorage().GetAllocationCount(),
+						   document.GetStorage().GetBlockCount(),
+						   document.GetStorage().GetUsedSize() / 1024);
+}
+
+static bool IsBinaryFile(StringView filePath)
+{
+	const StringView binaryExtension = ".glb"_view;
+
+	return filePath.GetLength() >= binaryExtension.GetLength()
+		&& StringView(filePath.GetData() + filePath.GetLength() - binaryExtension.GetLength(), binaryExtension.GetLength()) == binaryExtension;
+}
+
+struct BinaryFile
+{
+	StringView Manifest;
+	Buffer BinaryChunk;
+};
+
+static uint32 ReadUInt32(const uint8* data)
+{
+	uint32 value;
+	Platform::MemoryCopy(&value, data, sizeof(value));
+	return value;
+}
+
+// A GLB file is a 12-byte header followed by a JSON chunk and an optional BIN chunk, each with an 8-byte header of
+// its own and padded to 4 bytes.
+static BinaryFile ParseBinaryFile(const uint8* fileData, usize fileSize)
+{
+	static constexpr uint32 magic = 0x46546C67;
+	static constexpr uint32 version = 2;
+	static constexpr uint32 jsonChunkType = 0x4E4F534A;
+	static constexpr uint32 binaryChunkType = 0x004E4942;
+
+	static constexpr usize headerSize = 12;
+	static constexpr usize chunkHeaderSize = 8;
+
+	VERIFY(fileSize >= headerSize + chunkHeaderSize, "Invalid GLB file!");
+	VERIFY(ReadUInt32(fileData) == magic, "Invalid GLB file!");
+	VERIFY(ReadUInt32(fileData + 4) == version, "Unsupported GLB file version!");
+	VERIFY(ReadUInt32(fileData + 8) <= fileSize, "Invalid GLB file!");
+	const usize containerSize = ReadUInt32(fileData + 8);
+
+	// Every size below is checked against the room left in the container, which is known to be there first, so a
+	// truncated file can't have a chunk reach past the mapping.
+	VERIFY(containerSize >= headerSize + chunkHeaderSize, "Invalid GLB file!");
+
+	const usize jsonChunkSize = ReadUInt32(fileData + headerSize);
+	VERIFY(ReadUInt32(fileData + headerSize + 4) == jsonChunkType, "Expected GLB file to start with a JSON chunk!");
+	const usize jsonChunkStart = headerSize + chunkHeaderSize;
+	VERIFY(jsonChunkSize <= containerSize - jsonChunkStart, "Invalid GLB file!");
+
+	BinaryFile binaryFile =
+	{
+		.Manifest = StringView(reinterpret_cast<const char*>(fileData + jsonChunkStart), jsonChunkSize),
+		.BinaryChunk = Buffer {},
+	};
+
+	const usize binaryChunkHeaderStart = jsonChunkStart + jsonChunkSize;
+	if (containerSize - binaryChunkHeaderStart >= chunkHeaderSize)
+	{
+		const usize binaryChunkSize = ReadUInt32(fileData + binaryChunkHeaderStart);
+		const usize binaryChunkStart = binaryChunkHeaderStart + chunkHeaderSize;
+		if (ReadUInt32(fileData + binaryChunkHeaderStart + 4) == binaryChunkType)
+		{
+			VERIFY(containerSize >= binaryChunkStart, "Invalid GLB file!");
+			VERIFY(binaryChunkSize <= containerSize - binaryChunkStart, "Invalid GLB file!");
+			binaryFile.BinaryChunk = Buffer
+			{
+				.Data = fileData + binaryChunkStart,
+				.Size = binaryChunkSize,
+				.MappedFile = fileData,
+			};
+		}
+	}
+	return binaryFile;
+}
+
+struct PackedStream
+{
+	usize Offset;
+	usize Stride;
+};
+
+struct StreamCopy
+{
+	const uint8* Source;
+	uint8* Destination;
+	usize Count;
+	usize SourceStride;
+	usize DestinationStride;
+	usize ElementSize;
+};
+
+static void CopyStream(void* context, usize index)
+{
+	const StreamCopy& copy = static_cast<const StreamCopy*>(context)[index];
+	if (copy.SourceStride == copy.ElementSize && copy.DestinationStride == copy.ElementSize)
+	{
+		Platform::MemoryCopy(copy.Destination, copy.Source, copy.Count * copy.ElementSize);
+		return;
+	}
+
+	// Padding is zeroed, so the uploaded buffer doesn't depend on what the storage held before.
+	if (copy.DestinationStride != copy.ElementSize)
+	{
+		Platform::MemorySet(copy.Destination, 0, copy.Count * copy.DestinationStride);
+	}
+	for (usize elementIndex = 0; elementIndex < copy.Count; ++elementIndex)
+	{
+		Platform::MemoryCopy(copy.Destination + elementIndex * copy.DestinationStride,
+							 copy.Source + elementIndex * copy.SourceStride,
+							 copy.ElementSize);
+	}
+}
+
+static void AddPackedStream(const Scene& scene,
+							usize accessorIndex,
+							usize elementAlignment,
+							Array<PackedStream>* packedStreams,
+							usize* packedSize)
+{
+	static constexpr usize streamAlignment = 16;
+
+	// Accessors shared between primitives are only packed once.
+	if (accessorIndex == INDEX_NONE || (*packedStreams)[accessorIndex].Offset != INDEX_NONE)
+	{
+		return;
+	}
+
+	const Accessor& accessor = scene.Accessors[accessorIndex];
+	const usize stride = NextMultipleOf(GetElementSize(accessor.AccessorType, accessor.ComponentType), elementAlignment);
+
+	*packedSize = NextMultipleOf(*packedSize, streamAlignment);
+	(*packedStreams)[accessorIndex] = PackedStream { *packedSize, stride };
+	*packedSize += accessor.Count * stride;
+}
+
+// Copies the streams the renderer reads into one buffer, with every position stream first, then every texture
+// coordinate, normal and index stream, so that each pass fetches from dense memory. The accessors are pointed at the
+// copies, which leaves the source buffers to anything else.
+static void PackStreams(Scene* scene)
+{
+	static constexpr AttributeType packedAttributes[] =
+	{
+		AttributeType::Position,
+		AttributeType::TexCoord0,
+		AttributeType::Normal,
+	};
+
+	// Vertex attribute elements start on 4 bytes as the specification requires, which quantized elements such as
+	// three 16-bit components need padding for. Index elements are packed without gaps.
+	static constexpr usize attributeAlignment = 4;
+	static constexpr usize indexAlignment = 1;
+
+	static constexpr usize copyElementCount = 64 * 1024;
+
+	Array<PackedStream> packedStreams(scene->Accessors.GetCount(), Allocator);
+	for (usize accessorIndex = 0; accessorIndex < scene->Accessors.GetCount(); ++accessorIndex)
+	{
+		packedStreams.Add(PackedStream { INDEX_NONE, 0 });
+	}
+
+	usize packedSize = 0;
+	for (const AttributeType attributeType : packedAttributes)
+	{
+		for (const Primitive& primitive : scene->Primitives)
+		{
+			const usize accessorIndex = primitive.Attributes[static_cast<usize>(attributeType)];
+			AddPackedStream(*scene, accessorIndex, attributeAlignment, &packedStreams, &packedSize);
+		}
+	}
+	for (const Primitive& primitive : scene->Primitives)
+	{
+		AddPackedStream(*scene, primitive.Indices, indexAlignment, &packedStreams, &packedSize);
+	}
+	if (packedSize == 0)
+	{
+		return;
+	}
+
+	uint8* packedData = static_cast<uint8*>(scene->Storage->Allocate(packedSize));
+
+	// Long streams are split, so one large mesh doesn't leave the other workers waiting.
+	Array<StreamCopy> copies(Allocator);
+	for (usize accessorIndex = 0; accessorIndex < scene->Accessors.GetCount(); ++accessorIndex)
+	{
+		const PackedStream& packedStream = packedStreams[accessorIndex];
+		if (packedStream.Offset == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const AccessorView view = GetAccessorView(*scene, accessorIndex);
+		const Accessor& accessor = scene->Accessors[accessorIndex];
+		const usize elementSize = GetElementSize(accessor.AccessorType, accessor.ComponentType);
+		const uint8* source = scene->Buffers[view.Buffer].Data + view.Offset;
+		uint8* destination = packedData + packedStream.Offset;
+
+		for (usize firstElement = 0; firstElement < accessor.Count; firstElement += copyElementCount)
+		{
+			copies.Add(StreamCopy
+			{
+				.Source = source + firstElement * view.Stride,
+				.Destination = destination + firstElement * packedStream.Stride,
+				.Count = Min(copyElementCount, accessor.Count - firstElement),
+				.SourceStride = view.Stride,
+				.DestinationStride = packedStream.Stride,
+				.ElementSize = elementSize,
+			});
+		}
+	}
+	Jobs::ParallelFor(copies.GetCount(), CopyStream, copies.GetData());
+
+	const usize packedBuffer = scene->Buffers.GetCount();
+	scene->Buffers.Add(Buffer
+	{
+		.Data = packedData,
+		.Size = packedSize,
+		.MappedFile = nullptr,
+	});
+
+	// Every stream gets its own view, since padded streams differ in stride.
+	for (usize accessorIndex = 0; accessorIndex < scene->Accessors.GetCount(); ++accessorIndex)
+	{
+		const PackedStream& packedStream = packedStreams[accessorIndex];
+		if (packedStream.Offset == INDEX_NONE)
+		{
+			continue;
+		}
+
+		Accessor& accessor = scene->Accessors[accessorIndex];
+		const usize elementSize = GetElementSize(accessor.AccessorType, accessor.ComponentType);
+
+		accessor.BufferView = scene->BufferViews.GetCount();
+		accessor.Offset = 0;
+		scene->BufferViews.Add(BufferView
+		{
+			.Buffer = packedBuffer,
+			.Size = accessor.Count * packedStream.Stride,
+			.Offset = packedStream.Offset,
+			.Stride = packedStream.Stride == elementSize ? 0 : packedStream.Stride,
+			.Target = TargetType::ArrayBuffer,
+		});
+	}
+}
+
+static constexpr usize StorageBlockSize = MB(1);
+
+// The EXT_meshopt_compression part of a buffer view, as the manifest gives it.
+struct CompressedBufferView
+{
+	usize BufferView;
+
+	usize SourceBuffer;
+	usize SourceOffset;
+	usize SourceSize;
+
+	usize Count;
+	usize Stride;
+	Meshopt::Mode Mode;
+	Meshopt::Filter Filter;
+};
+
+struct ViewDecode
+{
+	uint8* Destination;
+	usize Count;
+	usize Stride;
+	Meshopt::Mode Mode;
+	Meshopt::Filter Filter;
+	const uint8* Source;
+	usize SourceSize;
+};
+
+static void DecodeView(void* context, usize index)
+{
+	const ViewDecode& decode = static_cast<const ViewDecode*>(context)[index];
+	Meshopt::Decode(decode.Destination, decode.Count, decode.Stride, decode.Mode, decode.Filter, decode.Source, decode.SourceSize);
+}
+
+// A fallback buffer only stands in for data decoded from EXT_meshopt_compression views, so it gets writable room in
+// the storage instead of a file, and its URI, if any, is never read.
+static Buffer LoadBuffer(StringView filePath, const Buffer& binaryChunk, usize bufferIndex, usize bufferSize, const StringView* uri, bool fallback, Arena* storage)
+{
+	if (fallback)
+	{
+		return Buffer
+		{
+			.Data = static_cast<uint8*>(storage->Allocate(bufferSize)),
+			.Size = bufferSize,
+			.MappedFile = nullptr,
+		};
+	}
+
+	Buffer buffer;
+	if (uri)
+	{
+		const String fullPath = ResolveFilePath(filePath, *uri, Allocator);
+
+		usize fileSize;
+		const uint8* fileData = File::Map(fullPath, &fileSize);
+		VERIFY(bufferSize == fileSize, "Failed to read GLTF buffer!");
+
+		buffer = Buffer
+		{
+			.Data = fileData,
+			.Size = bufferSize,
+			.MappedFile = fileData,
+		};
+	}
+	else
+	{
+		// In a GLB file the first buffer has no URI and is the BIN chunk, which stays in the mapped file.
+		VERIFY(bufferIndex == 0 && binaryChunk.Data, "GLTF buffer is missing a URI!");
+		VERIFY(bufferSize <= binaryChunk.Size, "Failed to read GLTF buffer!");
+
+		buffer = Buffer
+		{
+			.Data = binaryChunk.Data,
+			.Size = bufferSize,
+			.MappedFile = binaryChunk.MappedFile,
+		};
+	}
+
+	// Every buffer gets uploaded or packed close to in full, so its pages can start coming in while the rest of the
+	// manifest is read.
+	File::Prefetch(buffer.Data, buffer.Size);
+	return buffer;
+}
+
+// Views are only checked against their buffers here, as the manifest can list the buffers after the views. Views with
+// EXT_meshopt_compression keep their data encoded in another buffer, and the ones that land in a fallback buffer are
+// decoded into it. Other buffers already hold the data in full, so their compressed copy is left alone.
+static void DecodeBufferViews(ArrayView<Buffer> buffers, ArrayView<BufferView> bufferViews, ArrayView<CompressedBufferView> compressedBufferViews)
+{
+	// Until the scene is packed, the only buffers without a mapped file are fallback buffers, made writable above.
+	usize fallbackViewCount = 0;
+	for (const BufferView& bufferView : bufferViews)
+	{
+		VERIFY(bufferView.Buffer < buffers.GetCount() && bufferView.Offset + bufferView.Size <= buffers[bufferView.Buffer].Size, "Invalid GLTF buffer view!");
+		fallbackViewCount += buffers[bufferView.Buffer].MappedFile == nullptr;
+	}
+
+	Array<ViewDecode> decodes(Allocator);
+	for (const CompressedBufferView& compressedBufferView : compressedBufferViews)
+	{
+		const BufferView& bufferView = bufferViews[compressedBufferView.BufferView];
+		const Buffer& buffer = buffers[bufferView.Buffer];
+		if (buffer.MappedFile)
+		{
+			continue;
+		}
+
+		const usize sourceBuffer = compressedBufferView.SourceBuffer;
+		VERIFY(sourceBuffer < buffers.GetCount() && buffers[sourceBuffer].MappedFile, "Invalid GLTF meshopt compression buffer!");
+		VERIFY(compressedBufferView.SourceOffset + compressedBufferView.SourceSize <= buffers[sourceBuffer].Size, "Invalid GLTF meshopt compression buffer!");
+		VERIFY(compressedBufferView.Count * compressedBufferView.Stride <= bufferView.Size, "Invalid GLTF meshopt compression count!");
+
+		decodes.Add(ViewDecode
+		{
+			.Destination = const_cast<uint8*>(buffer.Data) + bufferView.Offset,
+			.Count = compressedBufferView.Count,
+			.Stride = compressedBufferView.Stride,
+			.Mode = compressedBufferView.Mode,
+			.Filter = compressedBufferView.Filter,
+			.Source = buffers[sourceBuffer].Data + compressedBufferView.SourceOffset,
+			.SourceSize = compressedBufferView.SourceSize,
+		});
+	}
+	VERIFY(decodes.GetCount() == fallbackViewCount, "GLTF buffer view reads from a fallback buffer!");
+
+	// Views are decoded one to a job, as an encoded stream can only be read from the start.
+	Jobs::ParallelFor(decodes.GetCount(), DecodeView, decodes.GetData());
+}
+
+static void LinkChildNodes(Array<Node>* nodes, ArrayView<usize> childNodes)
+{
+	for (usize nodeIndex = 0; nodeIndex < nodes->GetCount(); ++nodeIndex)
+	{
+		const Node& node = (*nodes)[nodeIndex];
+
+		for (usize childIndex = 0; childIndex < node.ChildNodeCount; ++childIndex)
+		{
+			const usize childNodeIndex = childNodes[node.FirstChildNode + childIndex];
+			VERIFY(childNodeIndex < nodes->GetCount(), "Invalid GLTF child node!");
+			VERIFY((*nodes)[childNodeIndex].Parent == INDEX_NONE, "GLTF node has multiple parents!");
+			(*nodes)[childNodeIndex].Parent = nodeIndex;
+		}
+	}
+}
+
+// Copies the camera or light each of the nodes refers to, placed where the node is.
+template<typename T>
+static Array<T> PlaceAtNodes(ArrayView<T> templates, usize Node::* templateIndex, ArrayView<usize> nodeIndices, ArrayView<Node> nodes, ArrayView<Matrix> nodeLocalToWorlds, Arena* storage)
+{
+	Array<T> placed(nodeIndices.GetCount(), storage);
+	for (usize nodeIndex : nodeIndices)
+	{
+		T placedTemplate = templates[nodes[nodeIndex].*templateIndex];
+		placedTemplate.LocalToWorld = nodeLocalToWorlds[nodeIndex];
+		placed.Add(placedTemplate);
+	}
+	return placed;
+}
+
+// The EXT_mesh_gpu_instancing part of a node, as the manifest gives it.
+struct MeshInstancing
+{
+	usize Node;
+
+	usize Translation;
+	usize Rotation;
+	usize Scale;
+};
+
+static usize GetInstanceCount(const Scene& scene, usize accessorIndex, AccessorType accessorType)
+{
+	if (accessorIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+	VERIFY(accessorIndex < scene.Accessors.GetCount(), "Invalid GLTF accessor!");
+
+	const Accessor& accessor = scene.Accessors[accessorIndex];
+	VERIFY(accessor.AccessorType == accessorType, "Unexpected GLTF instance attribute type!");
+	VERIFY(accessor.BufferView < scene.BufferViews.GetCount(), "Invalid GLTF accessor!");
+	if (accessor.Count > 0)
+	{
+		const AccessorView view = GetAccessorView(scene, accessorIndex);
+		VERIFY(view.Offset + view.Size <= scene.Buffers[view.Buffer].Size, "Invalid GLTF accessor!");
+	}
+	return accessor.Count;
+}
+
+// Leaves the components alone when the attribute is missing, so they keep their defaults.
+static void ReadInstanceAttribute(const Scene& scene, usize accessorIndex, usize instanceIndex, float32* components, usize componentCount)
+{
+	if (accessorIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const Accessor& accessor = scene.Accessors[accessorIndex];
+	const AccessorView view = GetAccessorView(scene, accessorIndex);
+	const usize componentSize = GetComponentSize(accessor.ComponentType);
+
+	const uint8* element = scene.Buffers[view.Buffer].Data + view.Offset + instanceIndex * view.Stride;
+	for (usize componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+	{
+		components[componentIndex] = DecodeComponent(element + componentIndex * componentSize, accessor.ComponentType, accessor.Normalized);
+	}
+}
+
+// Gives every node with EXT_mesh_gpu_instancing a run of placements, each with the instance transform combined with
+// that of the node. Nodes without it keep no placements and place their mesh once.
+static void PlaceMeshInstances(Scene* scene, ArrayView<MeshInstancing> meshInstancings)
+{
+	usize instanceCount = 0;
+	for (const MeshInstancing& meshInstancing : meshInstancings)
+	{
+		VERIFY(meshInstancing.Node < scene->Nodes.GetCount() && scene->Nodes[meshInstancing.Node].Mesh != INDEX_NONE, "Invalid GLTF mesh instancing!");
+
+		usize nodeInstanceCount = INDEX_NONE;
+		const usize attributeInstanceCounts[] =
+		{
+			GetInstanceCount(*scene, meshInstancing.Translation, AccessorType::Vector3),
+			GetInstanceCount(*scene, meshInstancing.Rotation, AccessorType::Vector4),
+			GetInstanceCount(*scene, meshInstancing.Scale, AccessorType::Vector3),
+		};
+		for (const usize attributeInstanceCount : attributeInstanceCounts)
+		{
+			if (attributeInstanceCount == INDEX_NONE)
+			{
+				continue;
+			}
+			VERIFY(nodeInstanceCount == INDEX_NONE || nodeInstanceCount == attributeInstanceCount, "Invalid GLTF mesh instancing count!");
+			nodeInstanceCount = attributeInstanceCount;
+		}
+		VERIFY(nodeInstanceCount != INDEX_NONE, "Key not present in JSON object!");
+
+		Node& node = scene->Nodes[meshInstancing.Node];
+		node.FirstInstance = instanceCount;
+		node.InstanceCount = nodeInstanceCount;
+		instanceCount += nodeInstanceCount;
+	}
+
+	scene->InstanceLocalToWorlds = Array<Matrix>(instanceCount, scene->Storage);
+	scene->InstanceLocalToWorlds.AddUninitialized(instanceCount);
+	for (const MeshInstancing& meshInstancing : meshInstancings)
+	{
+		const Node& node = scene->Nodes[meshInstancing.Node];
+		const Matrix& nodeLocalToWorld = scene->NodeLocalToWorlds[meshInstancing.Node];
+
+		for (usize instanceIndex = 0; instanceIndex < node.InstanceCount; ++instanceIndex)
+		{
+			float32 translation[3] = { 0.0f, 0.0f, 0.0f };
+			float32 rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+			float32 scale[3] = { 1.0f, 1.0f, 1.0f };
+			ReadInstanceAttribute(*scene, meshInstancing.Translation, instanceIndex, translation, 3);
+			ReadInstanceAttribute(*scene, meshInstancing.Rotation, instanceIndex, rotation, 4);
+			ReadInstanceAttribute(*scene, meshInstancing.Scale, instanceIndex, scale, 3);
+
+			const Matrix instanceToNode = ToLocalToParent(Vector(translation[0], translation[1], translation[2]),
+														  Quaternion(rotation[0], rotation[1], rotation[2], rotation[3]),
+														  Vector(scale[0], scale[1], scale[2]));
+			MultiplyTransforms(nodeLocalToWorld, instanceToNode, &scene->InstanceLocalToWorlds[node.FirstInstance + instanceIndex]);
+		}
+	}
+}
+
+// What the manifest gives that can only be resolved once all of it has been read.
+struct ManifestReferences
+{
+	Array<Camera> CameraTemplates;
+	Array<usize> CameraNodes;
+
+	Array<Light> LightTemplates;
+	Array<usize> LightNodes;
+
+	Array<MeshInstancing> MeshInstancings;
+
+	Array<CompressedBufferView> CompressedBufferViews;
+};
+
+// Expects the scene to hold everything read from the manifest, with node parents, world transforms, mesh instances,
+// cameras and lights still to be filled in.
+static void FinishScene(Scene* scene, const ManifestReferences& references, VertexLayout vertexLayout)
+{
+	DecodeBufferViews(scene->Buffers, scene->BufferViews, references.CompressedBufferViews);
+
+	DeduplicateStreams(scene);
+
+	LinkChildNodes(&scene->Nodes, scene->ChildNodes);
+	scene->NodeLocalToWorlds = CalculateNodeLocalToWorlds(scene->Nodes, scene->ChildNodes, scene->Storage);
+	PlaceMeshInstances(scene, references.MeshInstancings);
+
+	CalculatePrimitiveBounds(scene);
+	CalculateNodeWorldBounds(scene);
+
+	scene->Cameras = PlaceAtNodes<Camera>(references.CameraTemplates, &Node::Camera, references.CameraNodes, scene->Nodes, scene->NodeLocalToWorlds, scene->Storage);
+	scene->Lights = PlaceAtNodes<Light>(references.LightTemplates, &Node::Light, references.LightNodes, scene->Nodes, scene->NodeLocalToWorlds, scene->Storage);
+
+	if (vertexLayout == VertexLayout::Packed)
+	{
+		PackStreams(scene);
+	}
+}
+
+static Scene ParseScene(StringView filePath, JSON::Object rootObject, const Buffer& binaryChunk, VertexLayout vertexLayout)
+{
+	Arena* storage = Allocator->Create<Arena>(StorageBlockSize, Allocator);
+
+	ManifestReferences references =
+	{
+		.CameraTemplates = Array<Camera>(Allocator),
+		.CameraNodes = Array<usize>(Allocator),
+		.LightTemplates = Array<Light>(Allocator),
+		.LightNodes = Array<usize>(Allocator),
+		.MeshInstancings = Array<MeshInstancing>(Allocator),
+		.CompressedBufferViews = Array<CompressedBufferView>(Allocator),
+	};
+
+	const JSON::Array sceneArray = rootObject["scenes"_key].GetArray();
+	VERIFY(sceneArray.GetCount() == 1, "GLTF file contains multiple scenes!");
+
+	const JSON::Object sceneObject = sceneArray[0].GetObject();
+
+	const JSON::Array topLevelNodeArray = sceneObject["nodes"_key].GetArray();
+	Array<usize> topLevelNodes(topLevelNodeArray.GetCount(), storage);
+	for (const JSON::Value& nodeValue : topLevelNodeArray)
+	{
+		topLevelNodes.Add(nodeValue.GetUnsigned());
+	}
+
+	const JSON::Value* camerasValue = rootObject.TryGet("cameras"_key);
+	if (camerasValue)
+	{
+		const JSON::Array cameraArray = camerasValue->GetArray();
+		references.CameraTemplates.Reserve(cameraArray.GetCount());
+		for (const JSON::Value& cameraValue : cameraArray)
+		{
+			const JSON::Object cameraObject = cameraValue.GetObject();
+
+			const JSON::Value* perspectiveValue = cameraObject.TryGet("perspective"_key);
+			const bool perspective = perspectiveValue && cameraObject["type"_key].GetString() == "perspective"_view;
+			VERIFY(perspective, "Expected GLTF camera to be perspective!");
+
+			const JSON::Object perspectiveObject = perspectiveValue->GetObject();
+
+			const float32 fieldOfViewYRadians = static_cast<float32>(perspectiveObject["yfov"_key].GetDecimal());
+
+			const JSON::Value* aspectRatioValue = perspectiveObject.TryGet("aspectRatio"_key);
+			const float32 aspectRatio = aspectRatioValue ? static_cast<float32>(aspectRatioValue->GetDecimal())
+														 : 16.0f / 9.0f;
+
+			const float32 near = static_cast<float32>(perspectiveObject["znear"_key].GetDecimal());
+
+			const JSON::Value* farValue = perspectiveObject.TryGet("zfar"_key);
+			const float32 far = farValue ? static_cast<float32>(farValue->GetDecimal())
+										 : 1000.0f;
+
+			references.CameraTemplates.Add(Camera
+			{
+				.FieldOfViewYRadians = fieldOfViewYRadians,
+				.AspectRatio = aspectRatio,
+				.Near = near,
+				.Far = far,
+			});
+		}
+	}
+
+	const JSON::Value* extensionsValue = rootObject.TryGet("extensions"_key);
+	if (extensionsValue)
+	{
+		const JSON::Object extensionsObject = extensionsValue->GetObject();
+		const JSON::Value* lightsPunctualValue = extensionsObject.TryGet("KHR_lights_punctual"_key);
+		if (lightsPunctualValue)
+		{
+			const JSON::Object lightsPunctualObject = lightsPunctualValue->GetObject();
+			const JSON::Array lightsArray = lightsPunctualObject["lights"_key].GetArray();
+
+			for (const JSON::Value& light : lightsArray)
+			{
+				const JSON::Object lightObject = light.GetObject();
+
+				const JSON::Value* intensityValue = lightObject.TryGet("intensity"_key);
+				const float32 intensity = intensityValue ? static_cast<float32>(intensityValue->GetDecimal())
+														 : 1.0f;
+
+				const JSON::Value* colorValue = lightObject.TryGet("color"_key);
+				const float32x3 color = colorValue ? ToFloat3(colorValue->GetArray())
+												   : float32x3 { 1.0f, 1.0f, 1.0f };
+
+				references.LightTemplates.Add(Light
+				{
+					.Type = ParseLightType(lightObject["type"_key].GetString()),
+					.Intensity = intensity,
+					.RGB = color,
+				});
+			}
+		}
+	}
+
+	const JSON::Array nodeArray = rootObject["nodes"_key].GetArray();
+	Array<Node> nodes(nodeArray.GetCount(), storage);
+
+	// Every node but a root is the child of exactly one other, so this is only exceeded by invalid files.
+	Array<usize> childNodes(nodeArray.GetCount(), storage);
+	for (usize nodeIndex = 0; nodeIndex < nodeArray.GetCount(); ++nodeIndex)
+	{
+		Matrix localToWorld = Matrix::Identity;
+		const usize firstChildNode = childNodes.GetCount();
+		usize mesh = INDEX_NONE;
+		usize camera = INDEX_NONE;
+		usize light = INDEX_NONE;
+
+		const JSON::Object nodeObject = nodeArray[nodeIndex].GetObject();
+
+		const JSON::Value* translationValue = nodeObject.TryGet("translation"_key);
+		const JSON::Value* rotationValue = nodeObject.TryGet("rotation"_key);
+		const JSON::Value* scaleValue = nodeObject.TryGet("scale"_key);
+		const JSON::Value* matrixValue = nodeObject.TryGet("matrix"_key);
+		if (translationValue || rotationValue || scaleValue)
+		{
+			VERIFY(!matrixValue, "Invalid GLTF node property combination!");
+
+			Vector translation = Vector::Zero;
+			if (translationValue)
+			{
+				const JSON::Array translationArray = translationValue->GetArray();
+				VERIFY(translationArray.GetCount() == 3, "Invalid GLTF translation!");
+
+				translation = Vector(static_cast<float32>(translationArray[0].GetDecimal()),
+									 static_cast<float32>(translationArray[1].GetDecimal()),
+									 static_cast<float32>(translationArray[2].GetDecimal()));
+			}
+
+			Quaternion rotation = Quaternion::Identity;
+			if (rotationValue)
+			{
+				const JSON::Array rotationArray = rotationValue->GetArray();
+				VERIFY(rotationArray.GetCount() == 4, "Invalid GLTF rotation!");
+
+				rotation = Quaternion(static_cast<float32>(rotationArray[0].GetDecimal()),
+									  static_cast<float32>(rotationArray[1].GetDecimal()),
+									  static_cast<float32>(rotationArray[2].GetDecimal()),
+									  static_cast<float32>(rotationArray[3].GetDecimal()));
+			}
+
+			Vector scale(1.0f, 1.0f, 1.0f);
+			if (scaleValue)
+			{
+				const JSON::Array scaleArray = scaleValue->GetArray();
+				VERIFY(scaleArray.GetCount() == 3, "Invalid GLTF scale!");
+
+				scale = Vector(static_cast<float32>(scaleArray[0].GetDecimal()),
+							   static_cast<float32>(scaleArray[1].GetDecimal()),
+							   static_cast<float32>(scaleArray[2].GetDecimal()));
+			}
+
+			localToWorld = ToLocalToParent(translation, rotation, scale);
+		}
+		if (matrixValue)
+		{
+			VERIFY(!translationValue && !rotationValue && !scaleValue, "Invalid GLTF node property combination!");
+
+			const JSON::Array matrixArray = matrixValue->GetArray();
+			VERIFY(matrixArray.GetCount() == 16, "Invalid GLTF matrix!");
+
+			float32* element = &localToWorld.M00;
+			for (const JSON::Value& elementValue : matrixArray)
+			{
+				*element = static_cast<float32>(elementValue.GetDecimal());
+				++element;
+			}
+		}
+		const JSON::Value* childrenValue = nodeObject.TryGet("children"_key);
+		if (childrenValue)
+		{
+			const JSON::Array childrenArray = childrenValue->GetArray();
+			for (const JSON::Value& childValue : childrenArray)
+			{
+				childNodes.Add(childValue.GetUnsigned());
+			}
+		}
+		const JSON::Value* meshValue = nodeObject.TryGet("mesh"_key);
+		if (meshValue)
+		{
+			mesh = meshValue->GetUnsigned();
+		}
+		const JSON::Value* cameraValue = nodeObject.TryGet("camera"_key);
+		if (cameraValue)
+		{
+			camera = cameraValue->GetUnsigned();
+			references.CameraNodes.Add(nodeIndex);
+		}
+		const JSON::Value* extensionsValue = nodeObject.TryGet("extensions"_key);
+		if (extensionsValue)
+		{
+			const JSON::Object extensionsObject = extensionsValue->GetObject();
+			const JSON::Value* lightsPunctualValue = extensionsObject.TryGet("KHR_lights_punctual"_key);
+			if (lightsPunctualValue)
+			{
+				references.LightNodes.Add(nodeIndex);
+
+				const JSON::Object lightsPunctualObject = lightsPunctualValue->GetObject();
+				light = lightsPunctualObject["light"_key].GetUnsigned();
+			}
+			const JSON::Value* meshInstancingValue = extensionsObject.TryGet("EXT_mesh_gpu_instancing"_key);
+			if (meshInstancingValue)
+			{
+				const JSON::Object attributesObject = meshInstancingValue->GetObject()["attributes"_key].GetObject();
+				const JSON::Value* translationAccessorValue = attributesObject.TryGet("TRANSLATION"_key);
+				const JSON::Value* rotationAccessorValue = attributesObject.TryGet("ROTATION"_key);
+				const JSON::Value* scaleAccessorValue = attributesObject.TryGet("SCALE"_key);
+
+				references.MeshInstancings.Add(MeshInstancing
+				{
+					.Node = nodeIndex,
+					.Translation = translationAccessorValue ? translationAccessorValue->GetUnsigned() : INDEX_NONE,
+					.Rotation = rotationAccessorValue ? rotationAccessorValue->GetUnsigned() : INDEX_NONE,
+					.Scale = scaleAccessorValue ? scaleAccessorValue->GetUnsigned() : INDEX_NONE,
+				});
+			}
+		}
+
+		nodes.Add(Node
+		{
+			.LocalToWorld = localToWorld,
+			.Parent = INDEX_NONE,
+			.FirstChildNode = firstChildNode,
+			.ChildNodeCount = childNodes.GetCount() - firstChildNode,
+			.Mesh = mesh,
+			.Camera = camera,
+			.Light = light,
+			.FirstInstance = 0,
+			.InstanceCount = 0,
+		});
+	}
+
+	const JSON::Array bufferArray = rootObject["buffers"_key].GetArray();
+	Array<Buffer> buffers(bufferArray.GetCount(), storage);
+	for (const JSON::Value& bufferValue : bufferArray)
+	{
+		const JSON::Object bufferObject = bufferValue.GetObject();
+
+		const usize bufferSize = bufferObject["byteLength"_key].GetUnsigned();
+
+		bool fallback = false;
+		const JSON::Value* bufferExtensionsValue = bufferObject.TryGet("extensions"_key);
+		if (bufferExtensionsValue)
+		{
+			const JSON::Value* meshoptValue = bufferExtensionsValue->GetObject().TryGet("EXT_meshopt_compression"_key);
+			if (meshoptValue)
+			{
+				const JSON::Value* fallbackValue = meshoptValue->GetObject().TryGet("fallback"_key);
+				fallback = fallbackValue && fallbackValue->GetBoolean();
+			}
+		}
+
+		const JSON::Value* uriValue = bufferObject.TryGet("uri"_key);
+		const StringView uri = uriValue ? uriValue->GetString()
+										: StringView {};
+
+		buffers.Add(LoadBuffer(filePath, binaryChunk, buffers.GetCount(), bufferSize, uriValue ? &uri : nullptr, fallback, storage));
+	}
+
+	const JSON::Array bufferViewArray = rootObject["bufferViews"_key].GetArray();
+	Array<BufferView> bufferViews(bufferViewArray.GetCount(), storage);
+	for (const JSON::Value& bufferViewValue : bufferViewArray)
+	{
+		const JSON::Object bufferViewObject = bufferViewValue.GetObject();
+
+		const usize buffer = bufferViewObject["buffer"_key].GetUnsigned();
+		const usize size = bufferViewObject["byteLength"_key].GetUnsigned();
+
+		const JSON::Value* offsetValue = bufferViewObject.TryGet("byteOffset"_key);
+		const usize offset = offsetValue ? offsetValue->GetUnsigned()
+										 : 0;
+
+		const JSON::Value* bufferViewExtensionsValue = bufferViewObject.TryGet("extensions"_key);
+		const JSON::Value* meshoptValue = bufferViewExtensionsValue ? bufferViewExtensionsValue->GetObject().TryGet("EXT_meshopt_compression"_key)
+																	: nullptr;
+		if (meshoptValue)
+		{
+			const JSON::Object meshoptObject = meshoptValue->GetObject();
+
+			const JSON::Value* sourceOffsetValue = meshoptObject.TryGet("byteOffset"_key);
+			const usize sourceOffset = sourceOffsetValue ? sourceOffsetValue->GetUnsigned()
+														 : 0;
+
+			const JSON::Value* filterValue = meshoptObject.TryGet("filter"_key);
+			references.CompressedBufferViews.Add(CompressedBufferView
+			{
+				.BufferView = bufferViews.GetCount(),
+				.SourceBuffer = meshoptObject["buffer"_key].GetUnsigned(),
+				.SourceOffset = sourceOffset,
+				.SourceSize = meshoptObject["byteLength"_key].GetUnsigned(),
+				.Count = meshoptObject["count"_key].GetUnsigned(),
+				.Stride = meshoptObject["byteStride"_key].GetUnsigned(),
+				.Mode = ParseMeshoptMode(meshoptObject["mode"_key].GetString()),
+				.Filter = filterValue ? ParseMeshoptFilter(filterValue->GetString())
+									  : Meshopt::Filter::None,
+			});
+		}
+
+		const JSON::Value* strideValue = bufferViewObject.TryGet("byteStride"_key);
+		const usize stride = strideValue ? strideValue->GetUnsigned()
+										 : 0;
+		VERIFY(stride == 0 || (stride >= 4 && stride <= 252 && stride % 4 == 0), "Invalid GLTF buffer view stride!");
+
+		const JSON::Value* targetValue = bufferViewObject.TryGet("target"_key);
+		const TargetType targetType = targetValue ? ParseTargetType(targetValue->GetUnsigned())
+												  : TargetType::ArrayBuffer;
+
+		bufferViews.Add(BufferView
+		{
+			.Buffer = buffer,
+			.Size = size,
+			.Offset = offset,
+			.Stride = stride,
+			.Target = targetType,
+		});
+	}
+
+	const JSON::Array meshArray = rootObject["meshes"_key].GetArray();
+	usize primitiveCount = 0;
+	for (const JSON::Value& meshValue : meshArray)
+	{
+		primitiveCount += meshValue.GetObject()["primitives"_key].GetArray().GetCount();
+	}
+
+	Array<Mesh> meshes(meshArray.GetCount(), storage);
+	Array<Primitive> primitives(primitiveCount, storage);
+	for (const JSON::Value& meshValue : meshArray)
+	{
+		const JSON::Object meshObject = meshValue.GetObject();
+
+		const JSON::Array primitiveArray = meshObject["primitives"_key].GetArray();
+		const usize firstPrimitive = primitives.GetCount();
+		for (const JSON::Value& primitiveValue : primitiveArray)
+		{
+			const JSON::Object primitiveObject = primitiveValue.GetObject();
+
+			const JSON::Value* modeValue = primitiveObject.TryGet("mode"_key);
+			if (modeValue)
+			{
+				VERIFY(modeValue->GetUnsigned() == 4, "Unexpected GLTF primitive type!");
+			}
+
+			const usize indices = primitiveObject["indices"_key].GetUnsigned();
+			const usize material = primitiveObject["material"_key].GetUnsigned();
+
+			const JSON::Object attributesObject = primitiveObject["attributes"_key].GetObject();
+			Primitive primitive =
+			{
+				.Attributes = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE },
+				.Indices = indices,
+				.Material = material,
+			};
+			static_assert(static_cast<usize>(AttributeType::Count) == 4);
+
+			const JSON::Value* positionValue = attributesObject.TryGet("POSITION"_key);
+			if (positionValue)
+			{
+				primitive.Attributes[static_cast<usize>(AttributeType::Position)] = positionValue->GetUnsigned();
+			}
+			const JSON::Value* normalValue = attributesObject.TryGet("NORMAL"_key);
+			if (normalValue)
+			{
+				primitive.Attributes[static_cast<usize>(AttributeType::Normal)] = normalValue->GetUnsigned();
+			}
+			const JSON::Value* tangentValue = attributesObject.TryGet("TANGENT"_key);
+			if (tangentValue)
+			{
+				primitive.Attributes[static_cast<usize>(AttributeType::Tangent)] = tangentValue->GetUnsigned();
+			}
+			const JSON::Value* texCoord0Value = attributesObject.TryGet("TEXCOORD_0"_key);
+			if (texCoord0Value)
+			{
+				primitive.Attributes[static_cast<usize>(AttributeType::TexCoord0)] = texCoord0Value->GetUnsigned();
+			}
+
+			primitives.Add(primitive);
+		}
+
+		meshes.Add(Mesh
+		{
+			.FirstPrimitive = firstPrimitive,
+			.PrimitiveCount = primitives.GetCount() - firstPrimitive,
+		});
+	}
+
+	Array<Image> images(storage);
+	const JSON::Value* imagesValue = rootObject.TryGet("images"_key);
+	if (imagesValue)
+	{
+		const JSON::Array imageArray = imagesValue->GetArray();
+		images.Reserve(imageArray.GetCount());
+		for (const JSON::Value& imageValue : imageArray)
+		{
+			const JSON::Object imageObject = imageValue.GetObject();
+
+			const StringView imagePath = imageObject["uri"_key].GetString();
+			String fullPath = ResolveFilePath(filePath, imagePath, storage);
+
+			images.Add(Image
+			{
+				.Path = Move(fullPath),
+			});
+		}
+	}
+
+	Array<Texture> textures(storage);
+	const JSON::Value* texturesValue = rootObject.TryGet("textures"_key);
+	if (texturesValue)
+	{
+		const JSON::Array textureArray = texturesValue->GetArray();
+		textures.Reserve(textureArray.GetCount());
+		for (const JSON::Value& textureValue : textureArray)
+		{
+			const JSON::Object textureObject = textureValue.GetObject();
+
+			const usize image = textureObject["source"_key].GetUnsigned();
+
+			const JSON::Value* samplerValue = textureObject.TryGet("sampler"_key);
+			const usize sampler = samplerValue ? samplerValue->GetUnsigned()
+											   : INDEX_NONE;
+
+			textures.Add(Texture
+			{
+				.Image = image,
+				.Sampler = sampler,
+			});
+		}
+	}
+
+	const JSON::Array materialArray = rootObject["materials"_key].GetArray();
+	Array<Material> materials(materialArray.GetCount(), storage);
+	for (const JSON::Value& materialValue : materialArray)
+	{
+		Material material =
+		{
+			.NormalMapTexture = INDEX_NONE,
+			.EmissiveTexture = INDEX_NONE,
+			.EmissiveStrength = 1.0f,
+			.AlphaMode = AlphaMode::Opaque,
+			.AlphaCutoff = 0.0f,
+			.DoubleSided = false,
+		};
+
+		const JSON::Object materialObject = materialValue.GetObject();
+
+		const JSON::Value* pbrMetallicRoughnessValue = materialObject.TryGet("pbrMetallicRoughness"_key);
+		if (pbrMetallicRoughnessValue)
+		{
+			material.IsSpecularGlossiness = false;
+
+			material.MetallicRoughness.BaseColorTexture = INDEX_NONE;
+			material.MetallicRoughness.BaseColorFactor = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+			material.MetallicRoughness.MetallicRoughnessTexture = INDEX_NONE;
+			material.MetallicRoughness.MetallicFactor = 1.0f;
+			material.MetallicRoughness.RoughnessFactor = 1.0f;
+
+			const JSON::Object pbrMetallicRoughnessObject = pbrMetallicRoughnessValue->GetObject();
+
+			const JSON::Value* baseColorTextureValue = pbrMetallicRoughnessObject.TryGet("baseColorTexture"_key);
+			if (baseColorTextureValue)
+			{
+				const JSON::Object baseColorTextureObject = baseColorTextureValue->GetObject();
+				material.MetallicRoughness.BaseColorTexture = baseColorTextureObject["index"_key].GetUnsigned();
+			}
+			const JSON::Value* baseColorFactorValue = pbrMetallicRoughnessObject.TryGet("baseColorFactor"_key);
+			if (baseColorFactorValue)
+			{
+				const JSON::Array baseColorFactorArray = baseColorFactorValue->GetArray();
+				material.MetallicRoughness.BaseColorFactor = ToFloat4(baseColorFactorArray);
+			}
+
+			const JSON::Value* metallicRoughnessTextureValue = pbrMetallicRoughnessObject.TryGet("metallicRoughnessTexture"_key);
+			if (metallicRoughnessTextureValue)
+			{
+				const JSON::Object metallicRoughnessTextureObject = metallicRoughnessTextureValue->GetObject();
+				material.MetallicRoughness.MetallicRoughnessTexture = metallicRoughnessTextureObject["index"_key].GetUnsigned();
+			}
+			const JSON::Value* metallicFactorValue = pbrMetallicRoughnessObject.TryGet("metallicFactor"_key);
+			if (metallicFactorValue)
+			{
+				material.MetallicRoughness.MetallicFactor = static_cast<float32>(metallicFactorValue->GetDecimal());
+			}
+			const JSON::Value* roughnessFactorValue = pbrMetallicRoughnessObject.TryGet("roughnessFactor"_key);
+			if (roughnessFactorValue)
+			{
+				material.MetallicRoughness.RoughnessFactor = static_cast<float32>(roughnessFactorValue->GetDecimal());
+			}
+		}
+
+		const JSON::Value* extensionsValue = materialObject.TryGet("extensions"_key);
+		if (extensionsValue)
+		{
+			const JSON::Object extensionsObject = extensionsValue->GetObject();
+
+			const JSON::Value* pbrSpecularGlossinessValue = extensionsObject.TryGet("KHR_materials_pbrSpecularGlossiness"_key);
+			if (pbrSpecularGlossinessValue)
+			{
+				CHECK(!materialObject.HasKey("pbrMetallicRoughness"_key));
+				CHECK(!materialObject.HasKey("KHR_materials_specular"_key));
+
+				material.IsSpecularGlossiness = true;
+
+				material.SpecularGlossiness.DiffuseTexture = INDEX_NONE;
+				material.SpecularGlossiness.DiffuseFactor = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+				material.SpecularGlossiness.SpecularGlossinessTexture = INDEX_NONE;
+				material.SpecularGlossiness.SpecularFactor = { 1.0f, 1.0f, 1.0f };
+				material.SpecularGlossiness.GlossinessFactor = 1.0f;
+
+				const JSON::Object pbrSpecularGlossinessObject = pbrSpecularGlossinessValue->GetObject();
+
+				const JSON::Value* diffuseTextureValue = pbrSpecularGlossinessObject.TryGet("diffuseTexture"_key);
+				if (diffuseTextureValue)
+				{
+					const JSON::Object diffuseTextureObject = diffuseTextureValue->GetObject();
+					material.MetallicRoughness.BaseColorTexture = diffuseTextureObject["index"_key].GetUnsigned();
+				}
+				const JSON::Value* diffuseFactorValue = pbrSpecularGlossinessObject.TryGet("diffuseFactor"_key);
+				if (diffuseFactorValue)
+				{
+					const JSON::Array diffuseFactorArray = diffuseFactorValue->GetArray();
+					material.MetallicRoughness.BaseColorFactor = ToFloat4(diffuseFactorArray);
+				}
+
+				const JSON::Value* specularGlossinessTextureValue = pbrSpecularGlossinessObject.TryGet("specularGlossinessTexture"_key);
+				if (specularGlossinessTextureValue)
+				{
+					const JSON::Object specularGlossinessTextureObject = specularGlossinessTextureValue->GetObject();
+					material.SpecularGlossiness.SpecularGlossinessTexture = specularGlossinessTextureObject["index"_key].GetUnsigned();
+				}
+				const JSON::Value* specularFactorValue = pbrSpecularGlossinessObject.TryGet("specularFactor"_key);
+				if (specularFactorValue)
+				{
+					const JSON::Array specularFactorArray = specularFactorValue->GetArray();
+					material.SpecularGlossiness.SpecularFactor = ToFloat3(specularFactorArray);
+				}
+				const JSON::Value* roughnessFactorValue = pbrSpecularGlossinessObject.TryGet("roughnessFactor"_key);
+				if (roughnessFactorValue)
+				{
+					material.MetallicRoughness.RoughnessFactor = static_cast<float32>(roughnessFactorValue->GetDecimal());
+				}
+			}
+
+			const JSON::Value* specularValue = extensionsObject.TryGet("KHR_materials_specular"_key);
+			if (specularValue)
+			{
+				static bool specularWarningOnce = false;
+				if (!specularWarningOnce)
+				{
+					Platform::Log("GLTF::LoadScene: KHR_materials_specular implementation isn't specification compliant!\n");
+					specularWarningOnce = true;
+				}
+
+				CHECK(!materialObject.HasKey("KHR_materials_pbrSpecularGlossiness"_key));
+
+				material.IsSpecularGlossiness = false;
+
+				const JSON::Object specularObject = specularValue->GetObject();
+
+				const JSON::Value* specularTextureValue = specularObject.TryGet("specularTexture"_key);
+				if (specularTextureValue)
+				{
+					const JSON::Object specularTextureObject = specularTextureValue->GetObject();
+					material.MetallicRoughness.MetallicRoughnessTexture = specularTextureObject["index"_key].GetUnsigned();
+				}
+			}
+
+			const JSON::Value* emissiveStrengthExtensionValue = extensionsObject.TryGet("KHR_materials_emissive_strength"_key);
+			if (emissiveStrengthExtensionValue)
 			{
-				.Attributes = Move(attributes),
-				.Indices = indices,
-				.Material = material,
+				const JSON::Object emissiveStrength = emissiveStrengthExtensionValue->GetObject();
+
+				const JSON::Value* emissiveStrengthValue = emissiveStrength.TryGet("emissiveStrength"_key);
+				if (emissiveStrengthValue)
+				{
+					material.EmissiveStrength = static_cast<float32>(emissiveStrengthValue->GetDecimal());
+				}
+			}
+		}
+
+		const JSON::Value* normalTextureValue = materialObject.TryGet("normalTexture"_key);
+		if (normalTextureValue)
+		{
+			const JSON::Object normalTextureObject = normalTextureValue->GetObject();
+			material.NormalMapTexture = normalTextureObject["index"_key].GetUnsigned();
+		}
+
+		const JSON::Value* emissiveTextureValue = materialObject.TryGet("emissiveTexture"_key);
+		if (emissiveTextureValue)
+		{
+			const JSON::Object emissiveTextureObject = emissiveTextureValue->GetObject();
+			material.EmissiveTexture = emissiveTextureObject["index"_key].GetUnsigned();
+		}
+		const JSON::Value* emissiveFactorValue = materialObject.TryGet("emissiveFactor"_key);
+		if (emissiveFactorValue)
+		{
+			const JSON::Array emissiveFactorArray = emissiveFactorValue->GetArray();
+			material.EmissiveFactor = ToFloat3(emissiveFactorArray);
+		}
+
+		const JSON::Value* alphaModeValue = materialObject.TryGet("alphaMode"_key);
+		if (alphaModeValue)
+		{
+			material.AlphaMode = ParseAlphaMode(alphaModeValue->GetString());
+			if (material.AlphaMode == AlphaMode::Mask)
+			{
+				material.AlphaCutoff = 0.5f;
+			}
+		}
+
+		const JSON::Value* alphaCutoffValue = materialObject.TryGet("alphaCutoff"_key);
+		if (alphaCutoffValue)
+		{
+			material.AlphaCutoff = static_cast<float32>(alphaCutoffValue->GetDecimal());
+		}
+
+		const JSON::Value* doubleSidedValue = materialObject.TryGet("doubleSided"_key);
+		if (doubleSidedValue)
+		{
+			material.DoubleSided = doubleSidedValue->GetBoolean();
+		}
+
+		materials.Add(material);
+	}
+
+	Array<Sampler> samplers(storage);
+	const JSON::Value* samplersValue = rootObject.TryGet("samplers"_key);
+	if (samplersValue)
+	{
+		const JSON::Array samplerArray = samplersValue->GetArray();
+		samplers.Reserve(samplerArray.GetCount());
+		for (const JSON::Value& samplerValue : samplerArray)
+		{
+			const JSON::Object samplerObject = samplerValue.GetObject();
+
+			const JSON::Value* minificationValue = samplerObject.TryGet("minFilter"_key);
+			const Filter minification = minificationValue ? ParseFilter(minificationValue->GetUnsigned(), false)
+														  : Filter::Linear;
+			const JSON::Value* magnificationValue = samplerObject.TryGet("magFilter"_key);
+			const Filter magnification = magnificationValue ? ParseFilter(magnificationValue->GetUnsigned(), true)
+															: Filter::Linear;
+
+			const JSON::Value* horizontalValue = samplerObject.TryGet("wrapS"_key);
+			const Address horizontal = horizontalValue ? ParseAddress(horizontalValue->GetUnsigned())
+													   : Address::Repeat;
+			const JSON::Value* verticalValue = samplerObject.TryGet("wrapT"_key);
+			const Address vertical = verticalValue ? ParseAddress(verticalValue->GetUnsigned())
+												   : Address::Repeat;
+
+			samplers.Add(Sampler
+			{
+				.MinificationFilter = minification,
+				.MagnificationFilter = magnification,
+				.HorizontalAddress = horizontal,
+				.VerticalAddress = vertical,
 			});
 		}
-
-		meshes.Emplace(Move(primitives));
 	}
 
-	Array<Image> images(Allocator);
-	if (rootObject.HasKey("images"_view))
+	const JSON::Array accessorArray = rootObject["accessors"_key].GetArray();
+	Array<Accessor> accessors(accessorArray.GetCount(), storage);
+	for (const JSON::Value& accessorValue : accessorArray)
+	{
+		const JSON::Object accessorObject = accessorValue.GetObject();
+
+		const usize bufferView = accessorObject["bufferView"_key].GetUnsigned();
+		const usize count = accessorObject["count"_key].GetUnsigned();
+		const StringView accessorTypeString = accessorObject["type"_key].GetString();
+		const usize componentTypeNumber = accessorObject["componentType"_key].GetUnsigned();
+
+		const JSON::Value* offsetValue = accessorObject.TryGet("byteOffset"_key);
+		const usize offset = offsetValue ? offsetValue->GetUnsigned()
+										 : 0;
+
+		const JSON::Value* normalizedValue = accessorObject.TryGet("normalized"_key);
+		const bool normalized = normalizedValue ? normalizedValue->GetBoolean()
+												: false;
+
+		// Only bounds of three components are kept, which is what positions have.
+		const JSON::Value* minimumValue = accessorObject.TryGet("min"_key);
+		const JSON::Value* maximumValue = accessorObject.TryGet("max"_key);
+		const bool hasMinMax = minimumValue && maximumValue &&
+							   minimumValue->GetArray().GetCount() == 3 && maximumValue->GetArray().GetCount() == 3;
+
+		accessors.Add(Accessor
+		{
+			.BufferView = bufferView,
+			.Count = count,
+			.Offset = offset,
+			.ComponentType = ParseComponentType(componentTypeNumber),
+			.AccessorType = ParseAccessorType(accessorTypeString),
+			.Normalized = normalized,
+			.HasMinMax = hasMinMax,
+			.Min = hasMinMax ? ToFloat3(minimumValue->GetArray()) : float32x3 {},
+			.Max = hasMinMax ? ToFloat3(maximumValue->GetArray()) : float32x3 {},
+		});
+	}
+
+	bool twoChannelNormalMaps = false;
+	const JSON::Value* extrasValue = rootObject.TryGet("extras"_key);
+	if (extrasValue)
+	{
+		const JSON::Object extrasObject = extrasValue->GetObject();
+
+		const JSON::Value* twoChannelNormalMapsValue = extrasObject.TryGet("twoChannelNormalMaps"_key);
+		if (twoChannelNormalMapsValue)
+		{
+			twoChannelNormalMaps = twoChannelNormalMapsValue->GetBoolean();
+		}
+	}
+
+	Scene scene =
+	{
+		.Storage = storage,
+		.TopLevelNodes = Move(topLevelNodes),
+		.Nodes = Move(nodes),
+		.ChildNodes = Move(childNodes),
+		.Buffers = Move(buffers),
+		.BufferViews = Move(bufferViews),
+		.Meshes = Move(meshes),
+		.Primitives = Move(primitives),
+		.Images = Move(images),
+		.Textures = Move(textures),
+		.Samplers = Move(samplers),
+		.Materials = Move(materials),
+		.Accessors = Move(accessors),
+		.TwoChannelNormalMaps = twoChannelNormalMaps,
+	};
+	FinishScene(&scene, references, vertexLayout);
+	return scene;
+}
+
+static void ExpectToken(JSON::Reader* reader, JSON::Token token)
+{
+	VERIFY(reader->NextToken() == token, "Unexpected JSON value type!");
+}
+
+static const JSON::Value& ReadValue(JSON::Reader* reader)
+{
+	ExpectToken(reader, JSON::Token::Value);
+	return reader->GetValue();
+}
+
+static float32 ReadFloat(JSON::Reader* reader)
+{
+	return static_cast<float32>(ReadValue(reader).GetDecimal());
+}
+
+// Members are dispatched by the hashes of their keys, which an unknown key can share with a known one. Each case checks
+// the name before reading the value, and skips the value of a key that only shares the hash.
+static bool ConfirmKey(JSON::Reader* reader, JSON::Key key)
+{
+	if (reader->IsKey(key))
+	{
+		return true;
+	}
+	reader->SkipValue();
+	return false;
+}
+
+// Moves into the next object of an array that was just entered, or returns false at the end of the array.
+static bool EnterNextObject(JSON::Reader* reader)
+{
+	const JSON::Token token = reader->NextToken();
+	if (token == JSON::Token::EndArray)
+	{
+		return false;
+	}
+	VERIFY(token == JSON::Token::BeginObject, "Unexpected JSON value type!");
+	return true;
+}
+
+// Reads the next scalar of an array that was just entered, or returns null at the end of the array.
+static const JSON::Value* ReadNextElement(JSON::Reader* reader)
+{
+	const JSON::Token token = reader->NextToken();
+	if (token == JSON::Token::EndArray)
+	{
+		return nullptr;
+	}
+	VERIFY(token == JSON::Token::Value, "Unexpected JSON value type!");
+	return &reader->GetValue();
+}
+
+// Reads an array of numbers into the values and returns how many there were, which can be more than fit.
+static usize ReadFloats(JSON::Reader* reader, float32* values, usize capacity)
+{
+	ExpectToken(reader, JSON::Token::BeginArray);
+
+	usize count = 0;
+	while (const JSON::Value* value = ReadNextElement(reader))
+	{
+		if (count < capacity)
+		{
+			values[count] = static_cast<float32>(value->GetDecimal());
+		}
+		++count;
+	}
+	return count;
+}
+
+static float32x3 ReadFloat3(JSON::Reader* reader)
+{
+	float32 values[3];
+	VERIFY(ReadFloats(reader, values, 3) == 3, "Expected GLTF float array to have 3 components!");
+	return float32x3 { values[0], values[1], values[2] };
+}
+
+static float32x4 ReadFloat4(JSON::Reader* reader)
+{
+	float32 values[4];
+	VERIFY(ReadFloats(reader, values, 4) == 4, "Expected GLTF float array to have 4 components!");
+	return float32x4 { values[0], values[1], values[2], values[3] };
+}
+
+static usize ReadTextureIndex(JSON::Reader* reader)
+{
+	usize texture = INDEX_NONE;
+
+	ExpectToken(reader, JSON::Token::BeginObject);
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		if (reader->IsKey("index"_key))
+		{
+			texture = ReadValue(reader).GetUnsigned();
+		}
+		else
+		{
+			reader->SkipValue();
+		}
+	}
+	VERIFY(texture != INDEX_NONE, "Key not present in JSON object!");
+	return texture;
+}
+
+// Reads the object of the given extension out of an extensions object, and skips the others.
+template<typename Function>
+static void ReadExtension(JSON::Reader* reader, JSON::Key extension, Function readExtensionObject)
+{
+	ExpectToken(reader, JSON::Token::BeginObject);
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		if (!reader->IsKey(extension))
+		{
+			reader->SkipValue();
+			continue;
+		}
+
+		ExpectToken(reader, JSON::Token::BeginObject);
+		readExtensionObject();
+	}
+}
+
+static void ReadScenes(JSON::Reader* reader, Array<usize>* topLevelNodes)
+{
+	usize sceneCount = 0;
+
+	ExpectToken(reader, JSON::Token::BeginArray);
+	while (EnterNextObject(reader))
+	{
+		++sceneCount;
+		while (reader->NextToken() != JSON::Token::EndObject)
+		{
+			if (!reader->IsKey("nodes"_key))
+			{
+				reader->SkipValue();
+				continue;
+			}
+
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (const JSON::Value* nodeValue = ReadNextElement(reader))
+			{
+				topLevelNodes->Add(nodeValue->GetUnsigned());
+			}
+		}
+	}
+	VERIFY(sceneCount == 1, "GLTF file contains multiple scenes!");
+}
+
+// Expects the reader to have just entered the camera object.
+static Camera ReadCamera(JSON::Reader* reader)
+{
+	bool perspective = false;
+	bool hasPerspective = false;
+
+	float32 fieldOfViewYRadians = -1.0f;
+	float32 aspectRatio = 16.0f / 9.0f;
+	float32 near = -1.0f;
+	float32 far = 1000.0f;
+
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
+		{
+		case "type"_key.GetHash():
+			if (!ConfirmKey(reader, "type"_key))
+			{
+				break;
+			}
+			perspective = ReadValue(reader).GetString() == "perspective"_view;
+			break;
+		case "perspective"_key.GetHash():
+			if (!ConfirmKey(reader, "perspective"_key))
+			{
+				break;
+			}
+			hasPerspective = true;
+
+			ExpectToken(reader, JSON::Token::BeginObject);
+			while (reader->NextToken() != JSON::Token::EndObject)
+			{
+				switch (reader->GetKeyHash())
+				{
+				case "yfov"_key.GetHash():
+					if (!ConfirmKey(reader, "yfov"_key))
+					{
+						break;
+					}
+					fieldOfViewYRadians = ReadFloat(reader);
+					break;
+				case "aspectRatio"_key.GetHash():
+					if (!ConfirmKey(reader, "aspectRatio"_key))
+					{
+						break;
+					}
+					aspectRatio = ReadFloat(reader);
+					break;
+				case "znear"_key.GetHash():
+					if (!ConfirmKey(reader, "znear"_key))
+					{
+						break;
+					}
+					near = ReadFloat(reader);
+					break;
+				case "zfar"_key.GetHash():
+					if (!ConfirmKey(reader, "zfar"_key))
+					{
+						break;
+					}
+					far = ReadFloat(reader);
+					break;
+				default:
+					reader->SkipValue();
+					break;
+				}
+			}
+			break;
+		default:
+			reader->SkipValue();
+			break;
+		}
+	}
+	VERIFY(perspective && hasPerspective, "Expected GLTF camera to be perspective!");
+	VERIFY(fieldOfViewYRadians >= 0.0f && near >= 0.0f, "Key not present in JSON object!");
+
+	return Camera
+	{
+		.FieldOfViewYRadians = fieldOfViewYRadians,
+		.AspectRatio = aspectRatio,
+		.Near = near,
+		.Far = far,
+	};
+}
+
+// Expects the reader to have just entered the extensions object of the file.
+static void ReadSceneExtensions(JSON::Reader* reader, Array<Light>* lightTemplates)
+{
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		if (!reader->IsKey("KHR_lights_punctual"_key))
+		{
+			reader->SkipValue();
+			continue;
+		}
+
+		ExpectToken(reader, JSON::Token::BeginObject);
+		while (reader->NextToken() != JSON::Token::EndObject)
+		{
+			if (!reader->IsKey("lights"_key))
+			{
+				reader->SkipValue();
+				continue;
+			}
+
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				Light light =
+				{
+					.Type = LightType::Directional,
+					.Intensity = 1.0f,
+					.RGB = { 1.0f, 1.0f, 1.0f },
+				};
+
+				bool hasType = false;
+				while (reader->NextToken() != JSON::Token::EndObject)
+				{
+					switch (reader->GetKeyHash())
+					{
+					case "type"_key.GetHash():
+						if (!ConfirmKey(reader, "type"_key))
+						{
+							break;
+						}
+						light.Type = ParseLightType(ReadValue(reader).GetString());
+						hasType = true;
+						break;
+					case "intensity"_key.GetHash():
+						if (!ConfirmKey(reader, "intensity"_key))
+						{
+							break;
+						}
+						light.Intensity = ReadFloat(reader);
+						break;
+					case "color"_key.GetHash():
+						if (!ConfirmKey(reader, "color"_key))
+						{
+							break;
+						}
+						light.RGB = ReadFloat3(reader);
+						break;
+					default:
+						reader->SkipValue();
+						break;
+					}
+				}
+				VERIFY(hasType, "Key not present in JSON object!");
+
+				lightTemplates->Add(light);
+			}
+		}
+	}
+}
+
+// Expects the reader to have just entered the node object.
+// Expects the reader to have just entered the EXT_mesh_gpu_instancing object of the node.
+static MeshInstancing ReadMeshInstancing(JSON::Reader* reader, usize nodeIndex)
+{
+	MeshInstancing meshInstancing =
+	{
+		.Node = nodeIndex,
+		.Translation = INDEX_NONE,
+		.Rotation = INDEX_NONE,
+		.Scale = INDEX_NONE,
+	};
+
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		if (!reader->IsKey("attributes"_key))
+		{
+			reader->SkipValue();
+			continue;
+		}
+
+		ExpectToken(reader, JSON::Token::BeginObject);
+		while (reader->NextToken() != JSON::Token::EndObject)
+		{
+			switch (reader->GetKeyHash())
+			{
+			case "TRANSLATION"_key.GetHash():
+				if (!ConfirmKey(reader, "TRANSLATION"_key))
+				{
+					break;
+				}
+				meshInstancing.Translation = ReadValue(reader).GetUnsigned();
+				break;
+			case "ROTATION"_key.GetHash():
+				if (!ConfirmKey(reader, "ROTATION"_key))
+				{
+					break;
+				}
+				meshInstancing.Rotation = ReadValue(reader).GetUnsigned();
+				break;
+			case "SCALE"_key.GetHash():
+				if (!ConfirmKey(reader, "SCALE"_key))
+				{
+					break;
+				}
+				meshInstancing.Scale = ReadValue(reader).GetUnsigned();
+				break;
+			default:
+				reader->SkipValue();
+				break;
+			}
+		}
+	}
+	return meshInstancing;
+}
+
+static Node ReadNode(JSON::Reader* reader, usize nodeIndex, Array<usize>* childNodes, ManifestReferences* references)
+{
+	Node node =
+	{
+		.LocalToWorld = Matrix::Identity,
+		.Parent = INDEX_NONE,
+		.FirstChildNode = childNodes->GetCount(),
+		.ChildNodeCount = 0,
+		.Mesh = INDEX_NONE,
+		.Camera = INDEX_NONE,
+		.Light = INDEX_NONE,
+		.FirstInstance = 0,
+		.InstanceCount = 0,
+	};
+
+	// The parts of the transform can come in any order, so they are only put together once the node is read.
+	float32 translation[3] = { 0.0f, 0.0f, 0.0f };
+	float32 rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	float32 scale[3] = { 1.0f, 1.0f, 1.0f };
+	bool hasTransformParts = false;
+	bool hasMatrix = false;
+
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
+		{
+		case "translation"_key.GetHash():
+			if (!ConfirmKey(reader, "translation"_key))
+			{
+				break;
+			}
+			VERIFY(ReadFloats(reader, translation, 3) == 3, "Invalid GLTF translation!");
+			hasTransformParts = true;
+			break;
+		case "rotation"_key.GetHash():
+			if (!ConfirmKey(reader, "rotation"_key))
+			{
+				break;
+			}
+			VERIFY(ReadFloats(reader, rotation, 4) == 4, "Invalid GLTF rotation!");
+			hasTransformParts = true;
+			break;
+		case "scale"_key.GetHash():
+			if (!ConfirmKey(reader, "scale"_key))
+			{
+				break;
+			}
+			VERIFY(ReadFloats(reader, scale, 3) == 3, "Invalid GLTF scale!");
+			hasTransformParts = true;
+			break;
+		case "matrix"_key.GetHash():
+			if (!ConfirmKey(reader, "matrix"_key))
+			{
+				break;
+			}
+			VERIFY(ReadFloats(reader, &node.LocalToWorld.M00, 16) == 16, "Invalid GLTF matrix!");
+			hasMatrix = true;
+			break;
+		case "children"_key.GetHash():
+			if (!ConfirmKey(reader, "children"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (const JSON::Value* childValue = ReadNextElement(reader))
+			{
+				childNodes->Add(childValue->GetUnsigned());
+			}
+			break;
+		case "mesh"_key.GetHash():
+			if (!ConfirmKey(reader, "mesh"_key))
+			{
+				break;
+			}
+			node.Mesh = ReadValue(reader).GetUnsigned();
+			break;
+		case "camera"_key.GetHash():
+			if (!ConfirmKey(reader, "camera"_key))
+			{
+				break;
+			}
+			node.Camera = ReadValue(reader).GetUnsigned();
+			references->CameraNodes.Add(nodeIndex);
+			break;
+		case "extensions"_key.GetHash():
+			if (!ConfirmKey(reader, "extensions"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginObject);
+			while (reader->NextToken() != JSON::Token::EndObject)
+			{
+				switch (reader->GetKeyHash())
+				{
+				case "KHR_lights_punctual"_key.GetHash():
+					if (!ConfirmKey(reader, "KHR_lights_punctual"_key))
+					{
+						break;
+					}
+					references->LightNodes.Add(nodeIndex);
+
+					ExpectToken(reader, JSON::Token::BeginObject);
+					while (reader->NextToken() != JSON::Token::EndObject)
+					{
+						if (reader->IsKey("light"_key))
+						{
+							node.Light = ReadValue(reader).GetUnsigned();
+						}
+						else
+						{
+							reader->SkipValue();
+						}
+					}
+					VERIFY(node.Light != INDEX_NONE, "Key not present in JSON object!");
+					break;
+				case "EXT_mesh_gpu_instancing"_key.GetHash():
+					if (!ConfirmKey(reader, "EXT_mesh_gpu_instancing"_key))
+					{
+						break;
+					}
+					ExpectToken(reader, JSON::Token::BeginObject);
+					references->MeshInstancings.Add(ReadMeshInstancing(reader, nodeIndex));
+					break;
+				default:
+					reader->SkipValue();
+					break;
+				}
+			}
+			break;
+		default:
+			reader->SkipValue();
+			break;
+		}
+	}
+	VERIFY(!(hasTransformParts && hasMatrix), "Invalid GLTF node property combination!");
+
+	if (hasTransformParts)
 	{
-		const JSON::Array& imageArray = rootObject["images"_view].GetArray();
-		images.Reserve(imageArray.GetCount());
-		for (const JSON::Value& imageValue : imageArray)
-		{
-			const JSON::Object& imageObject = imageValue.GetObject();
+		node.LocalToWorld = ToLocalToParent(Vector(translation[0], translation[1], translation[2]),
+											Quaternion(rotation[0], rotation[1], rotation[2], rotation[3]),
+											Vector(scale[0], scale[1], scale[2]));
+	}
+	node.ChildNodeCount = childNodes->GetCount() - node.FirstChildNode;
+	return node;
+}
 
-			const String& imagePath = imageObject["uri"_view].GetString();
-			String fullPath = ResolveFilePath(filePath, imagePath);
+// Expects the reader to have just entered the buffer object.
+static Buffer ReadBuffer(JSON::Reader* reader, StringView filePath, const Buffer& binaryChunk, usize bufferIndex, Arena* storage)
+{
+	usize bufferSize = INDEX_NONE;
+	StringView uri;
+	bool hasUri = false;
+	bool fallback = false;
 
-			images.Add(Image
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
+		{
+		case "byteLength"_key.GetHash():
+			if (!ConfirmKey(reader, "byteLength"_key))
 			{
-				.Path = Move(fullPath),
+				break;
+			}
+			bufferSize = ReadValue(reader).GetUnsigned();
+			break;
+		case "uri"_key.GetHash():
+			if (!ConfirmKey(reader, "uri"_key))
+			{
+				break;
+			}
+			uri = ReadValue(reader).GetString();
+			hasUri = true;
+			break;
+		case "extensions"_key.GetHash():
+			if (!ConfirmKey(reader, "extensions"_key))
+			{
+				break;
+			}
+			ReadExtension(reader, "EXT_meshopt_compression"_key, [&]
+			{
+				while (reader->NextToken() != JSON::Token::EndObject)
+				{
+					if (reader->IsKey("fallback"_key))
+					{
+						fallback = ReadValue(reader).GetBoolean();
+					}
+					else
+					{
+						reader->SkipValue();
+					}
+				}
 			});
+			break;
+		default:
+			reader->SkipValue();
+			break;
 		}
 	}
+	VERIFY(bufferSize != INDEX_NONE, "Key not present in JSON object!");
 
-	Array<Texture> textures(Allocator);
-	if (rootObject.HasKey("textures"_view))
-	{
-		const JSON::Array& textureArray = rootObject["textures"_view].GetArray();
-		textures.Reserve(textureArray.GetCount());
-		for (const JSON::Value& textureValue : textureArray)
-		{
-			const JSON::Object& textureObject = textureValue.GetObject();
-
-			const usize image = static_cast<usize>(textureObject["source"_view].GetDecimal());
+	return LoadBuffer(filePath, binaryChunk, bufferIndex, bufferSize, hasUri ? &uri : nullptr, fallback, storage);
+}
 
-			const usize sampler = textureObject.HasKey("sampler"_view) ? static_cast<usize>(textureObject["sampler"_view].GetDecimal())
-																	   : INDEX_NONE;
+// Expects the reader to have just entered the EXT_meshopt_compression object of the buffer view.
+static CompressedBufferView ReadCompressedBufferView(JSON::Reader* reader, usize bufferViewIndex)
+{
+	CompressedBufferView compressedBufferView =
+	{
+		.BufferView = bufferViewIndex,
+		.SourceBuffer = INDEX_NONE,
+		.SourceOffset = 0,
+		.SourceSize = INDEX_NONE,
+		.Count = INDEX_NONE,
+		.Stride = INDEX_NONE,
+		.Mode = Meshopt::Mode::Attributes,
+		.Filter = Meshopt::Filter::None,
+	};
 
-			textures.Add(Texture
+	bool hasMode = false;
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
+		{
+		case "buffer"_key.GetHash():
+			if (!ConfirmKey(reader, "buffer"_key))
 			{
-				.Image = image,
-				.Sampler = sampler,
-			});
+				break;
+			}
+			compressedBufferView.SourceBuffer = ReadValue(reader).GetUnsigned();
+			break;
+		case "byteOffset"_key.GetHash():
+			if (!ConfirmKey(reader, "byteOffset"_key))
+			{
+				break;
+			}
+			compressedBufferView.SourceOffset = ReadValue(reader).GetUnsigned();
+			break;
+		case "byteLength"_key.GetHash():
+			if (!ConfirmKey(reader, "byteLength"_key))
+			{
+				break;
+			}
+			compressedBufferView.SourceSize = ReadValue(reader).GetUnsigned();
+			break;
+		case "byteStride"_key.GetHash():
+			if (!ConfirmKey(reader, "byteStride"_key))
+			{
+				break;
+			}
+			compressedBufferView.Stride = ReadValue(reader).GetUnsigned();
+			break;
+		case "count"_key.GetHash():
+			if (!ConfirmKey(reader, "count"_key))
+			{
+				break;
+			}
+			compressedBufferView.Count = ReadValue(reader).GetUnsigned();
+			break;
+		case "mode"_key.GetHash():
+			if (!ConfirmKey(reader, "mode"_key))
+			{
+				break;
+			}
+			compressedBufferView.Mode = ParseMeshoptMode(ReadValue(reader).GetString());
+			hasMode = true;
+			break;
+		case "filter"_key.GetHash():
+			if (!ConfirmKey(reader, "filter"_key))
+			{
+				break;
+			}
+			compressedBufferView.Filter = ParseMeshoptFilter(ReadValue(reader).GetString());
+			break;
+		default:
+			reader->SkipValue();
+			break;
 		}
 	}
+	VERIFY(compressedBufferView.SourceBuffer != INDEX_NONE && compressedBufferView.SourceSize != INDEX_NONE &&
+		   compressedBufferView.Count != INDEX_NONE && compressedBufferView.Stride != INDEX_NONE && hasMode,
+		   "Key not present in JSON object!");
+	return compressedBufferView;
+}
 
-	const JSON::Array& materialArray = rootObject["materials"_view].GetArray();
-	Array<Material> materials(materialArray.GetCount(), Allocator);
-	for (const JSON::Value& materialValue : materialArray)
+// Expects the reader to have just entered the buffer view object.
+static BufferView ReadBufferView(JSON::Reader* reader, usize bufferViewIndex, Array<CompressedBufferView>* compressedBufferViews)
+{
+	BufferView bufferView =
 	{
-		Material material =
-		{
-			.NormalMapTexture = INDEX_NONE,
-			.EmissiveTexture = INDEX_NONE,
-			.EmissiveStrength = 1.0f,
-			.AlphaMode = AlphaMode::Opaque,
-			.AlphaCutoff = 0.0f,
-			.DoubleSided = false,
-		};
-
-		const JSON::Object& materialObject = materialValue.GetObject();
+		.Buffer = INDEX_NONE,
+		.Size = INDEX_NONE,
+		.Offset = 0,
+		.Stride = 0,
+		.Target = TargetType::ArrayBuffer,
+	};
 
-		if (materialObject.HasKey("pbrMetallicRoughness"_view))
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
 		{
-			material.IsSpecularGlossiness = false;
-
-			material.MetallicRoughness.BaseColorTexture = INDEX_NONE;
-			material.MetallicRoughness.BaseColorFactor = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-			material.MetallicRoughness.MetallicRoughnessTexture = INDEX_NONE;
-			material.MetallicRoughness.MetallicFactor = 1.0f;
-			material.MetallicRoughness.RoughnessFactor = 1.0f;
-
-			const JSON::Object& pbrMetallicRoughnessObject = materialObject["pbrMetallicRoughness"_view].GetObject();
-
-			if (pbrMetallicRoughnessObject.HasKey("baseColorTexture"_view))
+		case "buffer"_key.GetHash():
+			if (!ConfirmKey(reader, "buffer"_key))
 			{
-				const JSON::Object& baseColorTextureObject = pbrMetallicRoughnessObject["baseColorTexture"_view].GetObject();
-				material.MetallicRoughness.BaseColorTexture = static_cast<usize>(baseColorTextureObject["index"_view].GetDecimal());
+				break;
 			}
-			if (pbrMetallicRoughnessObject.HasKey("baseColorFactor"_view))
+			bufferView.Buffer = ReadValue(reader).GetUnsigned();
+			break;
+		case "byteLength"_key.GetHash():
+			if (!ConfirmKey(reader, "byteLength"_key))
 			{
-				const JSON::Array& baseColorFactorArray = pbrMetallicRoughnessObject["baseColorFactor"_view].GetArray();
-				material.MetallicRoughness.BaseColorFactor = ToFloat4(baseColorFactorArray);
+				break;
 			}
-
-			if (pbrMetallicRoughnessObject.HasKey("metallicRoughnessTexture"_view))
+			bufferView.Size = ReadValue(reader).GetUnsigned();
+			break;
+		case "byteOffset"_key.GetHash():
+			if (!ConfirmKey(reader, "byteOffset"_key))
 			{
-				const JSON::Object& metallicRoughnessTextureObject = pbrMetallicRoughnessObject["metallicRoughnessTexture"_view].GetObject();
-				material.MetallicRoughness.MetallicRoughnessTexture = static_cast<usize>(metallicRoughnessTextureObject["index"_view].GetDecimal());
+				break;
 			}
-			if (pbrMetallicRoughnessObject.HasKey("metallicFactor"_view))
+			bufferView.Offset = ReadValue(reader).GetUnsigned();
+			break;
+		case "byteStride"_key.GetHash():
+			if (!ConfirmKey(reader, "byteStride"_key))
+			{
+				break;
+			}
+			bufferView.Stride = ReadValue(reader).GetUnsigned();
+			break;
+		case "target"_key.GetHash():
+			if (!ConfirmKey(reader, "target"_key))
 			{
-				material.MetallicRoughness.MetallicFactor = static_cast<float32>(pbrMetallicRoughnessObject["metallicFactor"_view].GetDecimal());
+				break;
 			}
-			if (pbrMetallicRoughnessObject.HasKey("roughnessFactor"_view))
+			bufferView.Target = ParseTargetType(ReadValue(reader).GetUnsigned());
+			break;
+		case "extensions"_key.GetHash():
+			if (!ConfirmKey(reader, "extensions"_key))
 			{
-				material.MetallicRoughness.RoughnessFactor = static_cast<float32>(pbrMetallicRoughnessObject["roughnessFactor"_view].GetDecimal());
+				break;
 			}
+			ReadExtension(reader, "EXT_meshopt_compression"_key, [&]
+			{
+				compressedBufferViews->Add(ReadCompressedBufferView(reader, bufferViewIndex));
+			});
+			break;
+		default:
+			reader->SkipValue();
+			break;
 		}
+	}
+	VERIFY(bufferView.Buffer != INDEX_NONE && bufferView.Size != INDEX_NONE, "Key not present in JSON object!");
 
-		if (materialObject.HasKey("extensions"_view))
-		{
-			const JSON::Object& extensionsObject = materialObject["extensions"_view].GetObject();
+	const usize stride = bufferView.Stride;
+	VERIFY(stride == 0 || (stride >= 4 && stride <= 252 && stride % 4 == 0), "Invalid GLTF buffer view stride!");
+	return bufferView;
+}
+
+// Expects the reader to have just entered the primitive object.
+static Primitive ReadPrimitive(JSON::Reader* reader)
+{
+	Primitive primitive =
+	{
+		.Attributes = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE },
+		.Indices = INDEX_NONE,
+		.Material = INDEX_NONE,
+	};
+	static_assert(static_cast<usize>(AttributeType::Count) == 4);
 
-			if (extensionsObject.HasKey("KHR_materials_pbrSpecularGlossiness"_view))
+	bool hasAttributes = false;
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
+		{
+		case "mode"_key.GetHash():
+			if (!ConfirmKey(reader, "mode"_key))
+			{
+				break;
+			}
+			VERIFY(ReadValue(reader).GetUnsigned() == 4, "Unexpected GLTF primitive type!");
+			break;
+		case "indices"_key.GetHash():
+			if (!ConfirmKey(reader, "indices"_key))
+			{
+				break;
+			}
+			primitive.Indices = ReadValue(reader).GetUnsigned();
+			break;
+		case "material"_key.GetHash():
+			if (!ConfirmKey(reader, "material"_key))
+			{
+				break;
+			}
+			primitive.Material = ReadValue(reader).GetUnsigned();
+			break;
+		case "attributes"_key.GetHash():
+			if (!ConfirmKey(reader, "attributes"_key))
 			{
-				CHECK(!materialObject.HasKey("pbrMetallicRoughness"_view));
-				CHECK(!materialObject.HasKey("KHR_materials_specular"_view));
+				break;
+			}
+			hasAttributes = true;
 
-				material.IsSpecularGlossiness = true;
+			ExpectToken(reader, JSON::Token::BeginObject);
+			while (reader->NextToken() != JSON::Token::EndObject)
+			{
+				AttributeType attributeType;
+				switch (reader->GetKeyHash())
+				{
+				case "POSITION"_key.GetHash():
+					if (!ConfirmKey(reader, "POSITION"_key))
+					{
+						break;
+					}
+					attributeType = AttributeType::Position;
+					break;
+				case "NORMAL"_key.GetHash():
+					if (!ConfirmKey(reader, "NORMAL"_key))
+					{
+						break;
+					}
+					attributeType = AttributeType::Normal;
+					break;
+				case "TANGENT"_key.GetHash():
+					if (!ConfirmKey(reader, "TANGENT"_key))
+					{
+						break;
+					}
+					attributeType = AttributeType::Tangent;
+					break;
+				case "TEXCOORD_0"_key.GetHash():
+					if (!ConfirmKey(reader, "TEXCOORD_0"_key))
+					{
+						break;
+					}
+					attributeType = AttributeType::TexCoord0;
+					break;
+				default:
+					reader->SkipValue();
+					continue;
+				}
+				primitive.Attributes[static_cast<usize>(attributeType)] = ReadValue(reader).GetUnsigned();
+			}
+			break;
+		default:
+			reader->SkipValue();
+			break;
+		}
+	}
+	VERIFY(primitive.Indices != INDEX_NONE && primitive.Material != INDEX_NONE && hasAttributes, "Key not present in JSON object!");
+	return primitive;
+}
 
-				material.SpecularGlossiness.DiffuseTexture = INDEX_NONE;
-				material.SpecularGlossiness.DiffuseFactor = { 1.0f, 1.0f, 1.0f, 1.0f };
+// Expects the reader to have just entered the mesh object.
+static Mesh ReadMesh(JSON::Reader* reader, Array<Primitive>* primitives)
+{
+	const usize firstPrimitive = primitives->GetCount();
 
-				material.SpecularGlossiness.SpecularGlossinessTexture = INDEX_NONE;
-				material.SpecularGlossiness.SpecularFactor = { 1.0f, 1.0f, 1.0f };
-				material.SpecularGlossiness.GlossinessFactor = 1.0f;
+	bool hasPrimitives = false;
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		if (!reader->IsKey("primitives"_key))
+		{
+			reader->SkipValue();
+			continue;
+		}
 
-				const JSON::Object& pbrSpecularGlossinessObject = extensionsObject["KHR_materials_pbrSpecularGlossiness"_view].GetObject();
+		hasPrimitives = true;
 
-				if (pbrSpecularGlossinessObject.HasKey("diffuseTexture"_view))
-				{
-					const JSON::Object& diffuseTextureObject = pbrSpecularGlossinessObject["diffuseTexture"_view].GetObject();
-					material.MetallicRoughness.BaseColorTexture = static_cast<usize>(diffuseTextureObject["index"_view].GetDecimal());
-				}
-				if (pbrSpecularGlossinessObject.HasKey("diffuseFactor"_view))
-				{
-					const JSON::Array& diffuseFactorArray = pbrSpecularGlossinessObject["diffuseFactor"_view].GetArray();
-					material.MetallicRoughness.BaseColorFactor = ToFloat4(diffuseFactorArray);
-				}
+		ExpectToken(reader, JSON::Token::BeginArray);
+		while (EnterNextObject(reader))
+		{
+			primitives->Add(ReadPrimitive(reader));
+		}
+	}
+	VERIFY(hasPrimitives, "Key not present in JSON object!");
 
-				if (pbrSpecularGlossinessObject.HasKey("specularGlossinessTexture"_view))
-				{
-					const JSON::Object& specularGlossinessTextureObject = pbrSpecularGlossinessObject["specularGlossinessTexture"_view].GetObject();
-					material.SpecularGlossiness.SpecularGlossinessTexture = static_cast<usize>(specularGlossinessTextureObject["index"_view].GetDecimal());
-				}
-				if (pbrSpecularGlossinessObject.HasKey("specularFactor"_view))
-				{
-					const JSON::Array& specularFactorArray = pbrSpecularGlossinessObject["specularFactor"_view].GetArray();
-					material.SpecularGlossiness.SpecularFactor = ToFloat3(specularFactorArray);
-				}
-				if (pbrSpecularGlossinessObject.HasKey("roughnessFactor"_view))
-				{
-					material.MetallicRoughness.RoughnessFactor = static_cast<float32>(pbrSpecularGlossinessObject["roughnessFactor"_view].GetDecimal());
-				}
-			}
+	return Mesh
+	{
+		.FirstPrimitive = firstPrimitive,
+		.PrimitiveCount = primitives->GetCount() - firstPrimitive,
+	};
+}
 
-			if (extensionsObject.HasKey("KHR_materials_specular"_view))
-			{
-				static bool specularWarningOnce = false;
-				if (!specularWarningOnce)
-				{
-					Platform::Log("GLTF::LoadScene: KHR_materials_specular implementation isn't specification compliant!\n");
-					specularWarningOnce = true;
-				}
+// Expects the reader to have just entered the image object.
+static Image ReadImage(JSON::Reader* reader, StringView filePath, Arena* storage)
+{
+	StringView imagePath;
+	bool hasImagePath = false;
 
-				CHECK(!materialObject.HasKey("KHR_materials_pbrSpecularGlossiness"_view));
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		if (reader->IsKey("uri"_key))
+		{
+			imagePath = ReadValue(reader).GetString();
+			hasImagePath = true;
+		}
+		else
+		{
+			reader->SkipValue();
+		}
+	}
+	VERIFY(hasImagePath, "Key not present in JSON object!");
 
-				material.IsSpecularGlossiness = false;
+	return Image
+	{
+		.Path = ResolveFilePath(filePath, imagePath, storage),
+	};
+}
 
-				const JSON::Object& specularObject = extensionsObject["KHR_materials_specular"_view].GetObject();
+// Expects the reader to have just entered the texture object.
+static Texture ReadTexture(JSON::Reader* reader)
+{
+	Texture texture =
+	{
+		.Image = INDEX_NONE,
+		.Sampler = INDEX_NONE,
+	};
 
-				if (specularObject.HasKey("specularTexture"_view))
-				{
-					const JSON::Object& specularTextureObject = specularObject["specularTexture"_view].GetObject();
-					material.MetallicRoughness.MetallicRoughnessTexture = static_cast<usize>(specularTextureObject["index"_view].GetDecimal());
-				}
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
+		{
+		case "source"_key.GetHash():
+			if (!ConfirmKey(reader, "source"_key))
+			{
+				break;
 			}
-
-			if (extensionsObject.HasKey("KHR_materials_emissive_strength"_view))
+			texture.Image = ReadValue(reader).GetUnsigned();
+			break;
+		case "sampler"_key.GetHash():
+			if (!ConfirmKey(reader, "sampler"_key))
 			{
-				const JSON::Object& emissiveStrength = extensionsObject["KHR_materials_emissive_strength"_view].GetObject();
-
-				if (emissiveStrength.HasKey("emissiveStrength"_view))
-				{
-					material.EmissiveStrength = static_cast<float32>(emissiveStrength["emissiveStrength"_view].GetDecimal());
-				}
+				break;
 			}
+			texture.Sampler = ReadValue(reader).GetUnsigned();
+			break;
+		default:
+			reader->SkipValue();
+			break;
 		}
+	}
+	VERIFY(texture.Image != INDEX_NONE, "Key not present in JSON object!");
+	return texture;
+}
 
-		if (materialObject.HasKey("normalTexture"_view))
-		{
-			const JSON::Object& normalTextureObject = materialObject["normalTexture"_view].GetObject();
-			material.NormalMapTexture = static_cast<usize>(normalTextureObject["index"_view].GetDecimal());
-		}
+// Expects the reader to have just entered the pbrMetallicRoughness object.
+static void ReadMetallicRoughness(JSON::Reader* reader, MetallicRoughness* metallicRoughness)
+{
+	*metallicRoughness =
+	{
+		.BaseColorTexture = INDEX_NONE,
+		.BaseColorFactor = { 1.0f, 1.0f, 1.0f, 1.0f },
+		.MetallicRoughnessTexture = INDEX_NONE,
+		.MetallicFactor = 1.0f,
+		.RoughnessFactor = 1.0f,
+	};
 
-		if (materialObject.HasKey("emissiveTexture"_view))
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
 		{
-			const JSON::Object& emissiveTextureObject = materialObject["emissiveTexture"_view].GetObject();
-			material.EmissiveTexture = static_cast<usize>(emissiveTextureObject["index"_view].GetDecimal());
+		case "baseColorTexture"_key.GetHash():
+			if (!ConfirmKey(reader, "baseColorTexture"_key))
+			{
+				break;
+			}
+			metallicRoughness->BaseColorTexture = ReadTextureIndex(reader);
+			break;
+		case "baseColorFactor"_key.GetHash():
+			if (!ConfirmKey(reader, "baseColorFactor"_key))
+			{
+				break;
+			}
+			metallicRoughness->BaseColorFactor = ReadFloat4(reader);
+			break;
+		case "metallicRoughnessTexture"_key.GetHash():
+			if (!ConfirmKey(reader, "metallicRoughnessTexture"_key))
+			{
+				break;
+			}
+			metallicRoughness->MetallicRoughnessTexture = ReadTextureIndex(reader);
+			break;
+		case "metallicFactor"_key.GetHash():
+			if (!ConfirmKey(reader, "metallicFactor"_key))
+			{
+				break;
+			}
+			metallicRoughness->MetallicFactor = ReadFloat(reader);
+			break;
+		case "roughnessFactor"_key.GetHash():
+			if (!ConfirmKey(reader, "roughnessFactor"_key))
+			{
+				break;
+			}
+			metallicRoughness->RoughnessFactor = ReadFloat(reader);
+			break;
+		default:
+			reader->SkipValue();
+			break;
 		}
-		if (materialObject.HasKey("emissiveFactor"_view))
+	}
+}
+
+// Expects the reader to have just entered the KHR_materials_pbrSpecularGlossiness object. The diffuse texture,
+// diffuse factor and roughness factor land in the metallic-roughness members, as in the document path.
+static void ReadSpecularGlossiness(JSON::Reader* reader, Material* material)
+{
+	material->SpecularGlossiness =
+	{
+		.DiffuseTexture = INDEX_NONE,
+		.DiffuseFactor = { 1.0f, 1.0f, 1.0f, 1.0f },
+		.SpecularGlossinessTexture = INDEX_NONE,
+		.SpecularFactor = { 1.0f, 1.0f, 1.0f },
+		.GlossinessFactor = 1.0f,
+	};
+
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
 		{
-			const JSON::Array& emissiveFactorArray = materialObject["emissiveFactor"_view].GetArray();
-			material.EmissiveFactor = ToFloat3(emissiveFactorArray);
+		case "diffuseTexture"_key.GetHash():
+			if (!ConfirmKey(reader, "diffuseTexture"_key))
+			{
+				break;
+			}
+			material->MetallicRoughness.BaseColorTexture = ReadTextureIndex(reader);
+			break;
+		case "diffuseFactor"_key.GetHash():
+			if (!ConfirmKey(reader, "diffuseFactor"_key))
+			{
+				break;
+			}
+			material->MetallicRoughness.BaseColorFactor = ReadFloat4(reader);
+			break;
+		case "specularGlossinessTexture"_key.GetHash():
+			if (!ConfirmKey(reader, "specularGlossinessTexture"_key))
+			{
+				break;
+			}
+			material->SpecularGlossiness.SpecularGlossinessTexture = ReadTextureIndex(reader);
+			break;
+		case "specularFactor"_key.GetHash():
+			if (!ConfirmKey(reader, "specularFactor"_key))
+			{
+				break;
+			}
+			material->SpecularGlossiness.SpecularFactor = ReadFloat3(reader);
+			break;
+		case "roughnessFactor"_key.GetHash():
+			if (!ConfirmKey(reader, "roughnessFactor"_key))
+			{
+				break;
+			}
+			material->MetallicRoughness.RoughnessFactor = ReadFloat(reader);
+			break;
+		default:
+			reader->SkipValue();
+			break;
 		}
+	}
+}
+
+// Expects the reader to have just entered the material object.
+static Material ReadMaterial(JSON::Reader* reader)
+{
+	Material material =
+	{
+		.NormalMapTexture = INDEX_NONE,
+		.EmissiveTexture = INDEX_NONE,
+		.EmissiveStrength = 1.0f,
+		.AlphaMode = AlphaMode::Opaque,
+		.AlphaCutoff = 0.0f,
+		.DoubleSided = false,
+	};
 
-		if (materialObject.HasKey("alphaMode"_view))
+	// Members can come in any order, so the ones that override others are only applied once the object is read.
+	bool hasMetallicRoughness = false;
+	bool hasSpecularGlossiness = false;
+	bool hasSpecular = false;
+	usize specularTexture = INDEX_NONE;
+	bool hasAlphaCutoff = false;
+	float32 alphaCutoff = 0.0f;
+
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
 		{
-			const String& alphaModeString = materialObject["alphaMode"_view].GetString();
+		case "pbrMetallicRoughness"_key.GetHash():
+			if (!ConfirmKey(reader, "pbrMetallicRoughness"_key))
+			{
+				break;
+			}
+			hasMetallicRoughness = true;
 
-			if (alphaModeString == "OPAQUE"_view)
+			ExpectToken(reader, JSON::Token::BeginObject);
+			ReadMetallicRoughness(reader, &material.MetallicRoughness);
+			break;
+		case "extensions"_key.GetHash():
+			if (!ConfirmKey(reader, "extensions"_key))
 			{
-				material.AlphaMode = AlphaMode::Opaque;
+				break;
 			}
-			else if (alphaModeString == "MASK"_view)
+			ExpectToken(reader, JSON::Token::BeginObject);
+			while (reader->NextToken() != JSON::Token::EndObject)
 			{
-				material.AlphaMode = AlphaMode::Mask;
-
-				material.AlphaCutoff = 0.5f;
+				switch (reader->GetKeyHash())
+				{
+				case "KHR_materials_pbrSpecularGlossiness"_key.GetHash():
+					if (!ConfirmKey(reader, "KHR_materials_pbrSpecularGlossiness"_key))
+					{
+						break;
+					}
+					hasSpecularGlossiness = true;
+
+					ExpectToken(reader, JSON::Token::BeginObject);
+					ReadSpecularGlossiness(reader, &material);
+					break;
+				case "KHR_materials_specular"_key.GetHash():
+					if (!ConfirmKey(reader, "KHR_materials_specular"_key))
+					{
+						break;
+					}
+					hasSpecular = true;
+
+					ExpectToken(reader, JSON::Token::BeginObject);
+					while (reader->NextToken() != JSON::Token::EndObject)
+					{
+						if (reader->IsKey("specularTexture"_key))
+						{
+							specularTexture = ReadTextureIndex(reader);
+						}
+						else
+						{
+							reader->SkipValue();
+						}
+					}
+					break;
+				case "KHR_materials_emissive_strength"_key.GetHash():
+					if (!ConfirmKey(reader, "KHR_materials_emissive_strength"_key))
+					{
+						break;
+					}
+					ExpectToken(reader, JSON::Token::BeginObject);
+					while (reader->NextToken() != JSON::Token::EndObject)
+					{
+						if (reader->IsKey("emissiveStrength"_key))
+						{
+							material.EmissiveStrength = ReadFloat(reader);
+						}
+						else
+						{
+							reader->SkipValue();
+						}
+					}
+					break;
+				default:
+					reader->SkipValue();
+					break;
+				}
+			}
+			break;
+		case "normalTexture"_key.GetHash():
+			if (!ConfirmKey(reader, "normalTexture"_key))
+			{
+				break;
+			}
+			material.NormalMapTexture = ReadTextureIndex(reader);
+			break;
+		case "emissiveTexture"_key.GetHash():
+			if (!ConfirmKey(reader, "emissiveTexture"_key))
+			{
+				break;
+			}
+			material.EmissiveTexture = ReadTextureIndex(reader);
+			break;
+		case "emissiveFactor"_key.GetHash():
+			if (!ConfirmKey(reader, "emissiveFactor"_key))
+			{
+				break;
+			}
+			material.EmissiveFactor = ReadFloat3(reader);
+			break;
+		case "alphaMode"_key.GetHash():
+			if (!ConfirmKey(reader, "alphaMode"_key))
+			{
+				break;
 			}
-			else if (alphaModeString == "BLEND"_view)
+			material.AlphaMode = ParseAlphaMode(ReadValue(reader).GetString());
+			break;
+		case "alphaCutoff"_key.GetHash():
+			if (!ConfirmKey(reader, "alphaCutoff"_key))
 			{
-				material.AlphaMode = AlphaMode::Blend;
+				break;
 			}
-			else
+			alphaCutoff = ReadFloat(reader);
+			hasAlphaCutoff = true;
+			break;
+		case "doubleSided"_key.GetHash():
+			if (!ConfirmKey(reader, "doubleSided"_key))
 			{
-				VERIFY(false, "Unexpected GLTF alpha mode!");
+				break;
 			}
+			material.DoubleSided = ReadValue(reader).GetBoolean();
+			break;
+		default:
+			reader->SkipValue();
+			break;
 		}
+	}
 
-		if (materialObject.HasKey("alphaCutoff"_view))
+	if (hasSpecularGlossiness)
+	{
+		CHECK(!hasMetallicRoughness);
+		material.IsSpecularGlossiness = true;
+	}
+	if (hasSpecular)
+	{
+		static bool specularWarningOnce = false;
+		if (!specularWarningOnce)
 		{
-			material.AlphaCutoff = static_cast<float32>(materialObject["alphaCutoff"_view].GetDecimal());
+			Platform::Log("GLTF::LoadScene: KHR_materials_specular implementation isn't specification compliant!\n");
+			specularWarningOnce = true;
 		}
 
-		if (materialObject.HasKey("doubleSided"_view))
+		material.IsSpecularGlossiness = false;
+		if (specularTexture != INDEX_NONE)
 		{
-			material.DoubleSided = materialObject["doubleSided"_view].GetBoolean();
+			material.MetallicRoughness.MetallicRoughnessTexture = specularTexture;
 		}
+	}
 
-		materials.Add(material);
+	if (hasAlphaCutoff)
+	{
+		material.AlphaCutoff = alphaCutoff;
+	}
+	else if (material.AlphaMode == AlphaMode::Mask)
+	{
+		material.AlphaCutoff = 0.5f;
 	}
+	return material;
+}
 
-	const auto toFilter = [](usize filter, bool magnification) -> Filter
+// Expects the reader to have just entered the sampler object.
+static Sampler ReadSampler(JSON::Reader* reader)
+{
+	Sampler sampler =
 	{
-		if (magnification)
-		{
-			CHECK(filter == 9728 || filter == 9729);
-		}
+		.MinificationFilter = Filter::Linear,
+		.MagnificationFilter = Filter::Linear,
+		.HorizontalAddress = Address::Repeat,
+		.VerticalAddress = Address::Repeat,
+	};
 
-		switch (filter)
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
 		{
-		case 9728:
-			return Filter::Nearest;
-		case 9729:
-			return Filter::Linear;
-		case 9984:
-			return Filter::NearestMipMapNearest;
-		case 9985:
-			return Filter::LinearMipMapNearest;
-		case 9986:
-			return Filter::NearestMipMapLinear;
-		case 9987:
-			return Filter::LinearMipMapLinear;
+		case "minFilter"_key.GetHash():
+			if (!ConfirmKey(reader, "minFilter"_key))
+			{
+				break;
+			}
+			sampler.MinificationFilter = ParseFilter(ReadValue(reader).GetUnsigned(), false);
+			break;
+		case "magFilter"_key.GetHash():
+			if (!ConfirmKey(reader, "magFilter"_key))
+			{
+				break;
+			}
+			sampler.MagnificationFilter = ParseFilter(ReadValue(reader).GetUnsigned(), true);
+			break;
+		case "wrapS"_key.GetHash():
+			if (!ConfirmKey(reader, "wrapS"_key))
+			{
+				break;
+			}
+			sampler.HorizontalAddress = ParseAddress(ReadValue(reader).GetUnsigned());
+			break;
+		case "wrapT"_key.GetHash():
+			if (!ConfirmKey(reader, "wrapT"_key))
+			{
+				break;
+			}
+			sampler.VerticalAddress = ParseAddress(ReadValue(reader).GetUnsigned());
+			break;
 		default:
-			CHECK(false);
+			reader->SkipValue();
+			break;
 		}
-		return Filter::Nearest;
+	}
+	return sampler;
+}
+
+// Expects the reader to have just entered the accessor object.
+static Accessor ReadAccessor(JSON::Reader* reader)
+{
+	Accessor accessor =
+	{
+		.BufferView = INDEX_NONE,
+		.Count = INDEX_NONE,
+		.Offset = 0,
+		.ComponentType = ComponentType::Int8,
+		.AccessorType = AccessorType::Scalar,
+		.Normalized = false,
+		.HasMinMax = false,
+		.Min = {},
+		.Max = {},
 	};
 
-	const auto toAddress = [](usize address) -> Address
+	bool hasComponentType = false;
+	bool hasAccessorType = false;
+
+	// Only bounds of three components are kept, which is what positions have.
+	float32 minimum[3];
+	float32 maximum[3];
+	usize minimumCount = 0;
+	usize maximumCount = 0;
+	while (reader->NextToken() != JSON::Token::EndObject)
 	{
-		switch (address)
+		switch (reader->GetKeyHash())
 		{
-		case 10497:
-			return Address::Repeat;
-		case 33071:
-			return Address::ClampToEdge;
-		case 33648:
-			return Address::MirroredRepeat;
+		case "bufferView"_key.GetHash():
+			if (!ConfirmKey(reader, "bufferView"_key))
+			{
+				break;
+			}
+			accessor.BufferView = ReadValue(reader).GetUnsigned();
+			break;
+		case "count"_key.GetHash():
+			if (!ConfirmKey(reader, "count"_key))
+			{
+				break;
+			}
+			accessor.Count = ReadValue(reader).GetUnsigned();
+			break;
+		case "byteOffset"_key.GetHash():
+			if (!ConfirmKey(reader, "byteOffset"_key))
+			{
+				break;
+			}
+			accessor.Offset = ReadValue(reader).GetUnsigned();
+			break;
+		case "componentType"_key.GetHash():
+			if (!ConfirmKey(reader, "componentType"_key))
+			{
+				break;
+			}
+			accessor.ComponentType = ParseComponentType(ReadValue(reader).GetUnsigned());
+			hasComponentType = true;
+			break;
+		case "type"_key.GetHash():
+			if (!ConfirmKey(reader, "type"_key))
+			{
+				break;
+			}
+			accessor.AccessorType = ParseAccessorType(ReadValue(reader).GetString());
+			hasAccessorType = true;
+			break;
+		case "normalized"_key.GetHash():
+			if (!ConfirmKey(reader, "normalized"_key))
+			{
+				break;
+			}
+			accessor.Normalized = ReadValue(reader).GetBoolean();
+			break;
+		case "min"_key.GetHash():
+			if (!ConfirmKey(reader, "min"_key))
+			{
+				break;
+			}
+			minimumCount = ReadFloats(reader, minimum, 3);
+			break;
+		case "max"_key.GetHash():
+			if (!ConfirmKey(reader, "max"_key))
+			{
+				break;
+			}
+			maximumCount = ReadFloats(reader, maximum, 3);
+			break;
 		default:
-			CHECK(false);
+			reader->SkipValue();
+			break;
 		}
-		return Address::Repeat;
-	};
+	}
+	VERIFY(accessor.BufferView != INDEX_NONE && accessor.Count != INDEX_NONE && hasComponentType && hasAccessorType, "Key not present in JSON object!");
 
-	Array<Sampler> samplers(Allocator);
-	if (rootObject.HasKey("samplers"_view))
+	if (minimumCount == 3 && maximumCount == 3)
 	{
-		const JSON::Array& samplerArray = rootObject["samplers"_view].GetArray();
-		samplers.Reserve(samplerArray.GetCount());
-		for (const JSON::Value& samplerValue : samplerArray)
-		{
-			const JSON::Object& samplerObject = samplerValue.GetObject();
-
-			const Filter minification = samplerObject.HasKey("minFilter"_view) ? toFilter(static_cast<usize>(samplerObject["minFilter"_view].GetDecimal()), false)
-																			   : Filter::Linear;
-			const Filter magnification = samplerObject.HasKey("magFilter"_view) ? toFilter(static_cast<usize>(samplerObject["magFilter"_view].GetDecimal()), true)
-																				: Filter::Linear;
-
-			const Address horizontal = samplerObject.HasKey("wrapS"_view) ? toAddress(static_cast<usize>(samplerObject["wrapS"_view].GetDecimal()))
-																		  : Address::Repeat;
-			const Address vertical = samplerObject.HasKey("wrapT"_view) ? toAddress(static_cast<usize>(samplerObject["wrapT"_view].GetDecimal()))
-																		: Address::Repeat;
+		accessor.HasMinMax = true;
+		accessor.Min = float32x3 { minimum[0], minimum[1], minimum[2] };
+		accessor.Max = float32x3 { maximum[0], maximum[1], maximum[2] };
+	}
+	return accessor;
+}
 
-			samplers.Add(Sampler
-			{
-				.MinificationFilter = minification,
-				.MagnificationFilter = magnification,
-				.HorizontalAddress = horizontal,
-				.VerticalAddress = vertical,
-			});
+// Expects the reader to have just entered the extras object of the file.
+static bool ReadTwoChannelNormalMaps(JSON::Reader* reader)
+{
+	bool twoChannelNormalMaps = false;
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		if (reader->IsKey("twoChannelNormalMaps"_key))
+		{
+			twoChannelNormalMaps = ReadValue(reader).GetBoolean();
+		}
+		else
+		{
+			reader->SkipValue();
 		}
 	}
+	return twoChannelNormalMaps;
+}
 
-	const JSON::Array& accessorArray = rootObject["accessors"_view].GetArray();
-	Array<Accessor> accessors(accessorArray.GetCount(), Allocator);
-	for (const JSON::Value& accessorValue : accessorArray)
+// Element counts aren't known until each array ends, so elements gather in scratch arrays and are then moved into the
+// storage in one allocation each.
+template<typename T>
+static Array<T> MoveToStorage(Array<T>* scratch, Arena* storage)
+{
+	Array<T> elements(scratch->GetCount(), storage);
+	for (T& element : *scratch)
 	{
-		const JSON::Object& accessorObject = accessorValue.GetObject();
+		elements.Add(Move(element));
+	}
+	return elements;
+}
 
-		const usize bufferView = static_cast<usize>(accessorObject["bufferView"_view].GetDecimal());
-		const usize count = static_cast<usize>(accessorObject["count"_view].GetDecimal());
-		const String& accessorTypeString = accessorObject["type"_view].GetString();
-		const usize componentTypeNumber = static_cast<usize>(accessorObject["componentType"_view].GetDecimal());
+// Fills the scene straight from the tokens of the manifest, without building a document first. Members are told apart
+// by the hash of their key, so each one costs a hash and a jump rather than a lookup per member the loader asks for.
+static Scene ReadScene(StringView filePath, JSON::Reader* reader, const Buffer& binaryChunk, VertexLayout vertexLayout, float64 parseStart)
+{
+	Arena* storage = Allocator->Create<Arena>(StorageBlockSize, Allocator);
+
+	ManifestReferences references =
+	{
+		.CameraTemplates = Array<Camera>(Allocator),
+		.CameraNodes = Array<usize>(Allocator),
+		.LightTemplates = Array<Light>(Allocator),
+		.LightNodes = Array<usize>(Allocator),
+		.MeshInstancings = Array<MeshInstancing>(Allocator),
+		.CompressedBufferViews = Array<CompressedBufferView>(Allocator),
+	};
 
-		const usize offset = accessorObject.HasKey("byteOffset"_view) ? static_cast<usize>(accessorObject["byteOffset"_view].GetDecimal())
-																	  : 0;
+	Array<usize> topLevelNodes(Allocator);
+	Array<Node> nodes(Allocator);
+	Array<usize> childNodes(Allocator);
+	Array<Buffer> buffers(Allocator);
+	Array<BufferView> bufferViews(Allocator);
+	Array<Mesh> meshes(Allocator);
+	Array<Primitive> primitives(Allocator);
+	Array<Image> images(Allocator);
+	Array<Texture> textures(Allocator);
+	Array<Sampler> samplers(Allocator);
+	Array<Material> materials(Allocator);
+	Array<Accessor> accessors(Allocator);
+	bool twoChannelNormalMaps = false;
 
-		ComponentType componentType = ComponentType::Int8;
-		switch (componentTypeNumber)
+	ExpectToken(reader, JSON::Token::BeginObject);
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		switch (reader->GetKeyHash())
 		{
-		case 5120:
-			componentType = ComponentType::Int8;
+		case "scenes"_key.GetHash():
+			if (!ConfirmKey(reader, "scenes"_key))
+			{
+				break;
+			}
+			ReadScenes(reader, &topLevelNodes);
+			break;
+		case "cameras"_key.GetHash():
+			if (!ConfirmKey(reader, "cameras"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				references.CameraTemplates.Add(ReadCamera(reader));
+			}
+			break;
+		case "extensions"_key.GetHash():
+			if (!ConfirmKey(reader, "extensions"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginObject);
+			ReadSceneExtensions(reader, &references.LightTemplates);
+			break;
+		case "nodes"_key.GetHash():
+			if (!ConfirmKey(reader, "nodes"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				nodes.Add(ReadNode(reader, nodes.GetCount(), &childNodes, &references));
+			}
+			break;
+		case "buffers"_key.GetHash():
+			if (!ConfirmKey(reader, "buffers"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				buffers.Add(ReadBuffer(reader, filePath, binaryChunk, buffers.GetCount(), storage));
+			}
+			break;
+		case "bufferViews"_key.GetHash():
+			if (!ConfirmKey(reader, "bufferViews"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				bufferViews.Add(ReadBufferView(reader, bufferViews.GetCount(), &references.CompressedBufferViews));
+			}
+			break;
+		case "meshes"_key.GetHash():
+			if (!ConfirmKey(reader, "meshes"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				meshes.Add(ReadMesh(reader, &primitives));
+			}
+			break;
+		case "images"_key.GetHash():
+			if (!ConfirmKey(reader, "images"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				images.Add(ReadImage(reader, filePath, storage));
+			}
 			break;
-		case 5121:
-			componentType = ComponentType::UInt8;
+		case "textures"_key.GetHash():
+			if (!ConfirmKey(reader, "textures"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				textures.Add(ReadTexture(reader));
+			}
 			break;
-		case 5122:
-			componentType = ComponentType::Int16;
+		case "materials"_key.GetHash():
+			if (!ConfirmKey(reader, "materials"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				materials.Add(ReadMaterial(reader));
+			}
 			break;
-		case 5123:
-			componentType = ComponentType::UInt16;
+		case "samplers"_key.GetHash():
+			if (!ConfirmKey(reader, "samplers"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				samplers.Add(ReadSampler(reader));
+			}
 			break;
-		case 5125:
-			componentType = ComponentType::UInt32;
+		case "accessors"_key.GetHash():
+			if (!ConfirmKey(reader, "accessors"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginArray);
+			while (EnterNextObject(reader))
+			{
+				accessors.Add(ReadAccessor(reader));
+			}
 			break;
-		case 5126:
-			componentType = ComponentType::Float32;
+		case "extras"_key.GetHash():
+			if (!ConfirmKey(reader, "extras"_key))
+			{
+				break;
+			}
+			ExpectToken(reader, JSON::Token::BeginObject);
+			twoChannelNormalMaps = ReadTwoChannelNormalMaps(reader);
 			break;
 		default:
-			VERIFY(false, "Unexpected GLTF component type!");
+			reader->SkipValue();
 			break;
 		}
+	}
+	ExpectToken(reader, JSON::Token::End);
 
-		AccessorType accessorType = AccessorType::Scalar;
-		if (accessorTypeString == "SCALAR"_view)
-		{
-			accessorType = AccessorType::Scalar;
-		}
-		else if (accessorTypeString == "VEC2"_view)
-		{
-			accessorType = AccessorType::Vector2;
-		}
-		else if (accessorTypeString == "VEC3"_view)
-		{
-			accessorType = AccessorType::Vector3;
-		}
-		else if (accessorTypeString == "VEC4"_view)
-		{
-			accessorType = AccessorType::Vector4;
-		}
-		else if (accessorTypeString == "MAT2"_view)
-		{
-			accessorType = AccessorType::Matrix2;
-		}
-		else if (accessorTypeString == "MAT3"_view)
-		{
-			accessorType = AccessorType::Matrix3;
-		}
-		else if (accessorTypeString == "MAT4"_view)
-		{
-			accessorType = AccessorType::Matrix4;
-		}
-		else
+	const float64 parseEnd = Platform::GetTime();
+	Platform::LogFormatted("GLTF::LoadScene: Read manifest in %.2fms\n", (parseEnd - parseStart) * 1000.0);
+
+	Scene scene =
+	{
+		.Storage = storage,
+		.TopLevelNodes = MoveToStorage(&topLevelNodes, storage),
+		.Nodes = MoveToStorage(&nodes, storage),
+		.ChildNodes = MoveToStorage(&childNodes, storage),
+		.Buffers = MoveToStorage(&buffers, storage),
+		.BufferViews = MoveToStorage(&bufferViews, storage),
+		.Meshes = MoveToStorage(&meshes, storage),
+		.Primitives = MoveToStorage(&primitives, storage),
+		.Images = MoveToStorage(&images, storage),
+		.Textures = MoveToStorage(&textures, storage),
+		.Samplers = MoveToStorage(&samplers, storage),
+		.Materials = MoveToStorage(&materials, storage),
+		.Accessors = MoveToStorage(&accessors, storage),
+		.TwoChannelNormalMaps = twoChannelNormalMaps,
+	};
+	FinishScene(&scene, references, vertexLayout);
+	return scene;
+}
+
+Scene LoadScene(StringView filePath, VertexLayout vertexLayout, ManifestParser manifestParser)
+{
+	const float64 parseStart = Platform::GetTime();
+
+	// Strings the reader hands out point into the manifest, which only has to last until the scene is read.
+	Arena manifestStorage(StorageBlockSize, Allocator);
+
+	if (!IsBinaryFile(filePath))
+	{
+		if (manifestParser == ManifestParser::Document)
 		{
-			VERIFY(false, "Unexpected GLTF accessor type!");
+			const JSON::Document document = JSON::Load(filePath);
+			LogParsedManifest(document, parseStart);
+
+			return ParseScene(filePath, document.GetRoot(), Buffer {}, vertexLayout);
 		}
 
-		accessors.Add(Accessor
-		{
-			.BufferView = bufferView,
-			.Count = count,
-			.Offset = offset,
-			.ComponentType = componentType,
-			.AccessorType = accessorType,
-		});
+		JSON::Reader reader(filePath, &manifestStorage);
+		return ReadScene(filePath, &reader, Buffer {}, vertexLayout, parseStart);
 	}
 
-	bool twoChannelNormalMaps = false;
-	if (rootObject.HasKey("extras"_view))
+	usize fileSize;
+	const uint8* fileData = File::Map(filePath, &fileSize);
+	const BinaryFile binaryFile = ParseBinaryFile(fileData, fileSize);
+
+	Scene scene;
+	if (manifestParser == ManifestParser::Document)
+	{
+		const JSON::Document document = JSON::Parse(binaryFile.Manifest);
+		LogParsedManifest(document, parseStart);
+
+		scene = ParseScene(filePath, document.GetRoot(), binaryFile.BinaryChunk, vertexLayout);
+	}
+	else
 	{
-		const JSON::Object& extrasObject = rootObject["extras"_view].GetObject();
+		JSON::Reader reader(binaryFile.Manifest.GetData(), binaryFile.Manifest.GetLength(), &manifestStorage);
+		scene = ReadScene(filePath, &reader, binaryFile.BinaryChunk, vertexLayout, parseStart);
+	}
+
+	// Nothing but the manifest was needed from the file if no buffer kept the BIN chunk.
+	if (scene.Buffers.IsEmpty() || scene.Buffers[0].MappedFile != fileData)
+	{
+		File::Unmap(fileData);
+	}
+	return scene;
+}
+
+static bool IsNodeUsed(const Node& node)
+{
+	return node.Mesh != INDEX_NONE || node.Camera != INDEX_NONE || node.Light != INDEX_NONE;
+}
 
-		if (extrasObject.HasKey("twoChannelNormalMaps"_view))
+// Nothing in a scene moves once it is loaded, so each kept node becomes a root placed by its world transform. Nodes are
+// compacted in place, so flattening takes nothing more from the storage.
+void FlattenNodeHierarchy(Scene* scene)
+{
+	const usize nodeCount = scene->Nodes.GetCount();
+
+	scene->TopLevelNodes.Clear();
+	scene->ChildNodes.Clear();
+
+	usize keptNodeCount = 0;
+	for (usize nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		if (!IsNodeUsed(scene->Nodes[nodeIndex]))
 		{
-			twoChannelNormalMaps = extrasObject["twoChannelNormalMaps"_view].GetBoolean();
+			continue;
 		}
+
+		Node flattenedNode = scene->Nodes[nodeIndex];
+		flattenedNode.LocalToWorld = scene->NodeLocalToWorlds[nodeIndex];
+		flattenedNode.Parent = INDEX_NONE;
+		flattenedNode.FirstChildNode = 0;
+		flattenedNode.ChildNodeCount = 0;
+
+		scene->Nodes[keptNodeCount] = flattenedNode;
+		scene->NodeLocalToWorlds[keptNodeCount] = scene->NodeLocalToWorlds[nodeIndex];
+		scene->NodeWorldBounds[keptNodeCount] = scene->NodeWorldBounds[nodeIndex];
+		scene->TopLevelNodes.Add(keptNodeCount);
+		++keptNodeCount;
 	}
 
-	return Scene
+	while (scene->Nodes.GetCount() > keptNodeCount)
 	{
-		.TopLevelNodes = Move(topLevelNodes),
-		.Nodes = Move(nodes),
-		.Buffers = Move(buffers),
-		.BufferViews = Move(bufferViews),
-		.Meshes = Move(meshes),
-		.Images = Move(images),
-		.Textures = Move(textures),
-		.Samplers = Move(samplers),
-		.Materials = Move(materials),
-		.Accessors = Move(accessors),
-		.Cameras = Move(cameras),
-		.Lights = Move(lights),
-		.TwoChannelNormalMaps = twoChannelNormalMaps,
-	};
+		scene->Nodes.Remove(scene->Nodes.GetCount() - 1);
+		scene->NodeLocalToWorlds.Remove(scene->NodeLocalToWorlds.GetCount() - 1);
+		scene->NodeWorldBounds.Remove(scene->NodeWorldBounds.GetCount() - 1);
+	}
+
+	Platform::LogFormatted("GLTF::FlattenNodeHierarchy: Kept %zu of %zu nodes\n", keptNodeCount, nodeCount);
 }
 
 void UnloadScene(Scene* scene)
 {
-	for (Buffer& buffer : scene->Buffers)
+	for (const Buffer& buffer : scene->Buffers)
 	{
-		Allocator->Deallocate(buffer.Data, buffer.Size);
+		if (buffer.MappedFile)
+		{
+			File::Unmap(buffer.MappedFile);
+		}
 	}
+
+	// The arrays still point into the storage, so they are let go of before it is freed.
+	Arena* storage = scene->Storage;
+	*scene = Scene {};
+	Allocator->Destroy(storage);
 }
 
-Matrix CalculateLocalToWorld(const Scene& scene, usize nodeIndex)
+float32 DecodeComponent(const uint8* data, ComponentType componentType, bool normalized)
 {
-	return InternalCalculateLocalToWorld(scene.Nodes, nodeIndex);
+	switch (componentType)
+	{
+	case ComponentType::Int8:
+	{
+		int8 value;
+		Platform::MemoryCopy(&value, data, sizeof(value));
+		return normalized ? Max(value / 127.0f, -1.0f) : value;
+	}
+	case ComponentType::UInt8:
+		return normalized ? *data / 255.0f : *data;
+	case ComponentType::Int16:
+	{
+		int16 value;
+		Platform::MemoryCopy(&value, data, sizeof(value));
+		return normalized ? Max(value / 32767.0f, -1.0f) : value;
+	}
+	case ComponentType::UInt16:
+	{
+		uint16 value;
+		Platform::MemoryCopy(&value, data, sizeof(value));
+		return normalized ? value / 65535.0f : value;
+	}
+	case ComponentType::Float32:
+	{
+		float32 value;
+		Platform::MemoryCopy(&value, data, sizeof(value));
+		return value;
+	}
+	default:
+		CHECK(false);
+		return 0.0f;
+	}
 }
 
 }
@@ -1,10 +1,12 @@
 #pragma once
 
+#include "Arena.hpp"
+
 #include "RHI/HLSL.hpp"
 
 #include "Luft/Array.hpp"
-#include "Luft/HashTable.hpp"
 #include "Luft/Math.hpp"
+#include "Luft/String.hpp"
 
 namespace GLTF
 {
@@ -48,22 +50,25 @@ enum class AttributeType : uint8
 	Normal,
 	Tangent,
 	TexCoord0,
-};
 
-}
+	Count,
+};
 
-template<>
-class Hash<GLTF::AttributeType>
+enum class VertexLayout : uint8
 {
-public:
-	uint64 operator()(const GLTF::AttributeType key) const
-	{
-		return StringHash(&key, sizeof(key));
-	}
+	// Streams are read where the file keeps them, interleaved or not.
+	AsStored,
+	// Position, texture coordinate, normal and index streams are copied into one buffer, each tightly packed.
+	Packed,
 };
 
-namespace GLTF
+enum class ManifestParser : uint8
 {
+	// Tokens of the manifest are read straight into the scene.
+	Streaming,
+	// The manifest is parsed into a document first, which the scene is then looked up from. Kept for comparison.
+	Document,
+};
 
 enum class Filter : uint8
 {
@@ -95,17 +100,26 @@ struct Node
 	Matrix LocalToWorld;
 
 	usize Parent;
-	Array<usize> ChildNodes;
+	usize FirstChildNode;
+	usize ChildNodeCount;
 
 	usize Mesh;
 	usize Camera;
 	usize Light;
+
+	// Placements of the mesh from EXT_mesh_gpu_instancing. A node without any places its mesh once, where it is.
+	usize FirstInstance;
+	usize InstanceCount;
 };
 
 struct Buffer
 {
-	uint8* Data;
+	const uint8* Data;
 	usize Size;
+
+	// Start of the mapped file the data lies in, which is the whole .bin file or a whole .glb file. Null when the data
+	// was made at load time and lives in the scene storage.
+	const uint8* MappedFile;
 };
 
 struct BufferView
@@ -113,19 +127,41 @@ struct BufferView
 	usize Buffer;
 	usize Size;
 	usize Offset;
+
+	// Distance between the starts of two elements, or 0 if the elements are tightly packed.
+	usize Stride;
+
 	TargetType Target;
 };
 
+// A box and a sphere that each hold everything bounded. Empty bounds have Min above Max and a negative radius.
+struct Bounds
+{
+	float32x3 Min;
+	float32x3 Max;
+
+	float32x3 Center;
+	float32 Radius;
+};
+
 struct Primitive
 {
-	HashTable<AttributeType, usize> Attributes;
+	// Accessor of each attribute type, or INDEX_NONE if the primitive doesn't have it.
+	usize Attributes[static_cast<usize>(AttributeType::Count)];
 	usize Indices;
 	usize Material;
+
+	// First primitive with the same positions and indices, which is this one unless its geometry is repeated.
+	usize Geometry;
+
+	// Of the positions, in mesh space.
+	Bounds Bounds;
 };
 
 struct Mesh
 {
-	Array<Primitive> Primitives;
+	usize FirstPrimitive;
+	usize PrimitiveCount;
 };
 
 struct Accessor
@@ -135,10 +171,20 @@ struct Accessor
 	usize Offset;
 	ComponentType ComponentType;
 	AccessorType AccessorType;
+
+	// Integer components stand for values in [0, 1] when unsigned or [-1, 1] when signed.
+	bool Normalized;
+
+	// Smallest and largest components of three-component accessors, as the file gives them.
+	bool HasMinMax;
+	float32x3 Min;
+	float32x3 Max;
 };
 
+// Size ends at the last element, so for an interleaved stream it doesn't count the stride padding after it.
 struct AccessorView
 {
+	usize Buffer;
 	usize Size;
 	usize Stride;
 	usize Offset;
@@ -231,14 +277,35 @@ struct Light
 	float32x3 RGB;
 };
 
+// Every array is allocated from the scene storage, so that loading a scene makes a handful of allocations and
+// unloading it frees them all at once.
 struct Scene
 {
+	Arena* Storage;
+
 	Array<usize> TopLevelNodes;
 	Array<Node> Nodes;
 
+	// The children of every node, with the children of each node in one run.
+	Array<usize> ChildNodes;
+
+	// Node transforms combined with those of all their parents, indexed like the nodes.
+	Array<Matrix> NodeLocalToWorlds;
+
+	// Bounds of the mesh of each node in world space, indexed like the nodes. Empty for nodes without a mesh, and around
+	// every placement for instanced nodes.
+	Array<Bounds> NodeWorldBounds;
+
+	// Instance transforms combined with the world transform of their node, with the placements of each node in one run.
+	Array<Matrix> InstanceLocalToWorlds;
+
+	// Bounds of the mesh at each placement in world space, indexed like the placements.
+	Array<Bounds> InstanceWorldBounds;
+
 	Array<Buffer> Buffers;
 	Array<BufferView> BufferViews;
 	Array<Mesh> Meshes;
+	Array<Primitive> Primitives;
 
 	Array<Image> Images;
 	Array<Texture> Textures;
@@ -253,10 +320,25 @@ struct Scene
 	bool TwoChannelNormalMaps;
 };
 
-Scene LoadScene(StringView filePath);
+Scene LoadScene(StringView filePath, VertexLayout vertexLayout, ManifestParser manifestParser = ManifestParser::Streaming);
 void UnloadScene(Scene* scene);
 
-Matrix CalculateLocalToWorld(const Scene& scene, usize nodeIndex);
+// Optionally run after LoadScene. Bakes every node into its world transform and drops the nodes that only group others.
+// Node indices change, and anything placed at the nodes, such as cameras, lights and mesh instances, stays where it is.
+// The renderer already skips grouping nodes, so this only shortens the node walks of loading.
+void FlattenNodeHierarchy(Scene* scene);
+
+// Reads one component of an element as a float, taking normalized integers to [0, 1] or [-1, 1].
+float32 DecodeComponent(const uint8* data, ComponentType componentType, bool normalized);
+
+inline usize GetAttribute(const Primitive& primitive, AttributeType attributeType)
+{
+	CHECK(static_cast<usize>(attributeType) < static_cast<usize>(AttributeType::Count));
+
+	const usize accessor = primitive.Attributes[static_cast<usize>(attributeType)];
+	VERIFY(accessor != INDEX_NONE, "GLTF primitive is missing an attribute!");
+	return accessor;
+}
 
 inline usize GetAccessorSize(AccessorType accessorType)
 {
@@ -302,11 +384,12 @@ inline AccessorView GetAccessorView(const Scene& scene, usize accessorIndex)
 
 	const Buffer& buffer = scene.Buffers[bufferView.Buffer];
 	const usize offset = accessor.Offset + bufferView.Offset;
-	const usize stride = GetElementSize(accessor.AccessorType, accessor.ComponentType);
-	const usize size = accessor.Count * stride;
+	const usize elementSize = GetElementSize(accessor.AccessorType, accessor.ComponentType);
+	const usize stride = bufferView.Stride ? bufferView.Stride : elementSize;
+	const usize size = accessor.Count == 0 ? 0 : (accessor.Count - 1) * stride + elementSize;
 	CHECK(offset + size <= buffer.Size);
 
-	return AccessorView { size, stride, offset };
+	return AccessorView { bufferView.Buffer, size, stride, offset };
 }
 
 }
@@ -1,18 +1,71 @@
 #pragma once
 
+#include "Arena.hpp"
+#include "File.hpp"
+
 #include "Luft/Array.hpp"
-#include "Luft/HashTable.hpp"
+#include "Luft/NoCopy.hpp"
 #include "Luft/String.hpp"
 
 namespace JSON
 {
 
+class Array;
+class KeyTable;
 class Object;
-class Value;
+struct BlockMasks;
+struct Member;
 
 inline Allocator* Allocator = &GlobalAllocator::Get();
 
-using Array = Array<Value>;
+// FNV-1a, so that key literals can be hashed at compile time.
+constexpr uint64 HashKey(const char* name, usize length)
+{
+	uint64 hash = 0xCBF29CE484222325ull;
+	for (usize index = 0; index < length; ++index)
+	{
+		hash ^= static_cast<uint8>(name[index]);
+		hash *= 0x100000001B3ull;
+	}
+	return hash;
+}
+
+class Key
+{
+public:
+	constexpr Key(const char* name, usize length)
+		: Name(name)
+		, Length(length)
+		, Hash(HashKey(name, length))
+	{
+	}
+
+	Key(StringView name)
+		: Key(name.GetData(), name.GetLength())
+	{
+	}
+
+	StringView GetName() const
+	{
+		return StringView(Name, Length);
+	}
+
+	constexpr uint64 GetHash() const
+	{
+		return Hash;
+	}
+
+private:
+	const char* Name;
+	usize Length;
+	uint64 Hash;
+};
+
+enum class StringMode : uint8
+{
+	Copy,
+	ZeroCopy,
+};
 
 enum class Tag : uint8
 {
@@ -21,10 +74,13 @@ enum class Tag : uint8
 	Array,
 	String,
 	Decimal,
+	Integer,
 	Boolean,
 	Null,
 };
 
+// Arrays and objects point at contiguous runs of elements or members in the document storage, and the count
+// (or string length) sits next to the payload, so every value fits in 16 bytes.
 class Value
 {
 public:
@@ -35,77 +91,91 @@ public:
 
 	explicit Value(Tag null)
 		: NullValue(nullptr)
+		, Count(0)
 		, Tag(Tag::Null)
 	{
 		CHECK(null == Tag::Null);
 	}
 
-	explicit Value(Object* owning)
-		: ObjectValue(owning)
+	Value(const Member* members, usize memberCount)
+		: ObjectValue(members)
+		, Count(static_cast<uint32>(memberCount))
 		, Tag(Tag::Object)
 	{
+		VERIFY(memberCount <= MaximumCount, "JSON object has too many members!");
 	}
 
-	explicit Value(Array&& array)
-		: ArrayValue(Move(array))
+	Value(const Value* elements, usize elementCount)
+		: ArrayValue(elements)
+		, Count(static_cast<uint32>(elementCount))
 		, Tag(Tag::Array)
 	{
+		VERIFY(elementCount <= MaximumCount, "JSON array has too many elements!");
 	}
 
-	explicit Value(String&& string)
-		: StringValue(Move(string))
+	explicit Value(StringView string)
+		: StringValue(string.GetData())
+		, Count(static_cast<uint32>(string.GetLength()))
 		, Tag(Tag::String)
 	{
+		VERIFY(string.GetLength() <= MaximumCount, "JSON string is too long!");
 	}
 
 	explicit Value(float64 decimal)
 		: DecimalValue(decimal)
+		, Count(0)
 		, Tag(Tag::Decimal)
 	{
 	}
 
+	explicit Value(int64 integer)
+		: IntegerValue(integer)
+		, Count(0)
+		, Tag(Tag::Integer)
+	{
+	}
+
 	explicit Value(bool boolean)
 		: BooleanValue(boolean)
+		, Count(0)
 		, Tag(Tag::Boolean)
 	{
 	}
 
-	~Value();
-
-	Value(const Value& copy);
-	Value& operator=(const Value& copy);
-
-	Value(Value&& move);
-	Value& operator=(Value&& move);
-
 	Tag GetTag() const
 	{
 		return Tag;
 	}
 
-	const Object& GetObject() const
+	Object GetObject() const;
+	Array GetArray() const;
+
+	StringView GetString() const
 	{
-		VERIFY(Tag == Tag::Object, "Unexpected JSON value type!");
-		CHECK(ObjectValue);
-		return *ObjectValue;
+		VERIFY(Tag == Tag::String, "Unexpected JSON value type!");
+		return StringView(StringValue, Count);
 	}
 
-	const Array& GetArray() const
+	float64 GetDecimal() const
 	{
-		VERIFY(Tag == Tag::Array, "Unexpected JSON value type!");
-		return ArrayValue;
+		if (Tag == Tag::Integer)
+		{
+			return static_cast<float64>(IntegerValue);
+		}
+		VERIFY(Tag == Tag::Decimal, "Unexpected JSON value type!");
+		return DecimalValue;
 	}
 
-	const String& GetString() const
+	int64 GetInteger() const
 	{
-		VERIFY(Tag == Tag::String, "Unexpected JSON value type!");
-		return StringValue;
+		VERIFY(Tag == Tag::Integer, "Unexpected JSON value type!");
+		return IntegerValue;
 	}
 
-	float64 GetDecimal() const
+	usize GetUnsigned() const
 	{
-		VERIFY(Tag == Tag::Decimal, "Unexpected JSON value type!");
-		return DecimalValue;
+		VERIFY(Tag == Tag::Integer && IntegerValue >= 0, "Unexpected JSON value type!");
+		return static_cast<usize>(IntegerValue);
 	}
 
 	bool GetBoolean() const
@@ -115,52 +185,346 @@ public:
 	}
 
 private:
+	// Counts and string lengths are kept in 32 bits to fit the value in 16 bytes.
+	static constexpr usize MaximumCount = 0xFFFFFFFF;
+
 	union
 	{
-		Object* ObjectValue;
-		Array ArrayValue;
-		String StringValue;
+		const Member* ObjectValue;
+		const Value* ArrayValue;
+		const char* StringValue;
 		float64 DecimalValue;
+		int64 IntegerValue;
 		bool BooleanValue;
 		void* NullValue;
 	};
+	uint32 Count;
 	Tag Tag;
 };
+static_assert(sizeof(Value) == 16);
 
+// Each distinct key among the objects built together is stored once, and members point at that record, so
+// finding a member compares records instead of names.
+struct InternedKey
+{
+	const char* Name;
+	uint32 NameLength;
+	uint32 Hash;
+	const KeyTable* Table;
+
+	StringView GetName() const
+	{
+		return StringView(Name, NameLength);
+	}
+};
+
+struct Member
+{
+	const InternedKey* Key;
+	Value Value;
+
+	StringView GetName() const
+	{
+		return Key->GetName();
+	}
+};
+static_assert(sizeof(Member) == 24);
+
+class Array
+{
+public:
+	Array(const Value* elements, usize count)
+		: Elements(elements)
+		, Count(count)
+	{
+	}
+
+	const Value& operator[](usize index) const
+	{
+		VERIFY(index < Count, "Index out of bounds of JSON array!");
+		return Elements[index];
+	}
+
+	usize GetCount() const
+	{
+		return Count;
+	}
+
+	const Value* begin() const
+	{
+		return Elements;
+	}
+
+	const Value* end() const
+	{
+		return Elements + Count;
+	}
+
+private:
+	const Value* Elements;
+	usize Count;
+};
+
+// Objects with more than a few members have an open-addressing table of member indices right after the members.
 class Object
 {
 public:
-	Object()
-		: Objects(1, Allocator)
+	Object(const Member* members, usize count)
+		: Members(members)
+		, Count(count)
+	{
+	}
+
+	const Value* TryGet(Key key) const;
+
+	const Value& operator[](Key key) const
 	{
+		const Value* value = TryGet(key);
+		VERIFY(value, "Key not present in JSON object!");
+		return *value;
 	}
 
-	explicit Object(HashTable<String, Value>&& objects)
-		: Objects(Move(objects))
+	bool HasKey(Key key) const
 	{
+		return TryGet(key) != nullptr;
 	}
 
-	Value& operator[](StringView key)
+	usize GetCount() const
 	{
-		VERIFY(HasKey(key), "Key not present in JSON object!");
-		return Objects[key];
+		return Count;
 	}
 
-	const Value& operator[](StringView key) const
+	const Member* begin() const
 	{
-		VERIFY(HasKey(key), "Key not present in JSON object!");
-		return Objects[key];
+		return Members;
 	}
 
-	bool HasKey(StringView key) const
+	const Member* end() const
 	{
-		return Objects.Contains(key);
+		return Members + Count;
 	}
 
 private:
-	HashTable<String, Value> Objects;
+	const Member* Members;
+	usize Count;
 };
 
-Object Load(StringView filePath);
+inline Object Value::GetObject() const
+{
+	VERIFY(Tag == Tag::Object, "Unexpected JSON value type!");
+	return Object(ObjectValue, Count);
+}
 
+inline Array Value::GetArray() const
+{
+	VERIFY(Tag == Tag::Array, "Unexpected JSON value type!");
+	return Array(ArrayValue, Count);
+}
+
+// Carries the string and escape state from one 64-byte block to the next, so the structural index can be built as
+// the file comes in.
+struct StructuralIndexer
+{
+	BlockMasks (*ClassifyBlock)(const uint8* block);
+
+	uint64 PreviousEscaped;
+	uint64 PreviousInString;
+	uint64 PreviousScalar;
+};
+
+enum class Token : uint8
+{
+	End,
+	BeginObject,
+	EndObject,
+	BeginArray,
+	EndArray,
+	Key,
+	Value,
+};
+
+// Pulls one token at a time off the structural index without building a document, so loaders can read straight
+// into their own structures. Numbers are parsed in place, and keys and strings point into the file buffer unless
+// they are escaped or copied, in which case they go to the storage arena. Keys are never copied, so in copy mode
+// they only live as long as the reader. Skipped subtrees are only checked for
+// balanced brackets. The file is read and indexed in chunks as tokens are pulled, so parsing one chunk overlaps
+// with reading the next.
+class Reader : public NoCopy
+{
+public:
+	Reader(StringView filePath, Arena* storage, StringMode stringMode = StringMode::ZeroCopy);
+
+	// Reads text that is already in memory, which has to outlive the reader and any strings it hands out.
+	Reader(const char* text, usize textSize, Arena* storage, StringMode stringMode = StringMode::ZeroCopy);
+
+	// Reads the elements of an array split by SkipArrayElements, from the first structural up to the end one, as if
+	// they were the rest of that array. The parent has to outlive this reader but isn't touched by it, so readers
+	// over disjoint ranges can run on different threads.
+	Reader(const Reader& parent, usize firstStructural, usize endStructural, Arena* storage);
+
+	~Reader();
+
+	Token NextToken();
+
+	// Skips the next value, including everything nested in it.
+	void SkipValue();
+
+	// Skips the rest of the array that was just entered, without handing out its closing bracket. Records the
+	// structural each element starts at, followed by the one of the closing bracket. Only the separators between
+	// the elements are checked.
+	void SkipArrayElements(::Array<usize>* elementStructurals);
+
+	StringView GetKey() const
+	{
+		return CurrentKey;
+	}
+
+	// Hashed like Key, so that members can be told apart by switching on the hashes of key literals.
+	uint64 GetKeyHash() const
+	{
+		return HashKey(CurrentKey.GetData(), CurrentKey.GetLength());
+	}
+
+	// Different keys can share a hash, so a member matched by GetKeyHash is confirmed with this before it is read.
+	bool IsKey(Key key) const
+	{
+		return CurrentKey == key.GetName();
+	}
+
+	const Value& GetValue() const
+	{
+		return CurrentValue;
+	}
+
+private:
+	static constexpr usize ChunkSize = MB(1);
+
+	Token Read(bool skip);
+	bool HasStructural();
+	usize NextStructural();
+	void IndexNextChunk();
+
+	Arena* Storage;
+	StringMode StringMode;
+
+	// Null for readers over text in memory or over a range of another reader's array elements.
+	File::ChunkedReader* Input;
+	StringView Buffer;
+	usize IndexedSize;
+
+	StructuralIndexer Indexer;
+	::Array<uint32> Structurals;
+	usize StructuralIndex;
+
+	// Brackets of the containers still open, innermost last.
+	::Array<char> Scopes;
+	bool HasKey;
+	bool HasValue;
+
+	StringView CurrentKey;
+	Value CurrentValue;
+};
+
+class Document
+{
+public:
+	Document(Arena&& storage, Value root)
+		: Storage(Move(storage))
+		, Root(root)
+	{
+	}
+
+	Object GetRoot() const
+	{
+		return Root.GetObject();
+	}
+
+	const Arena& GetStorage() const
+	{
+		return Storage;
+	}
+
+private:
+	Arena Storage;
+	Value Root;
+};
+
+// Whether the arrays directly in the root object are built in batches of elements on the job workers. Automatic does
+// so when there are any workers, and Always does even without them, running the batches one after another.
+enum class Batching : uint8
+{
+	Automatic,
+	Never,
+	Always,
+};
+
+Document Load(StringView filePath, StringMode stringMode = StringMode::ZeroCopy, Batching batching = Batching::Automatic);
+
+// Builds a document from text in memory. Unless strings are copied, the text has to outlive the document.
+Document Parse(StringView text, StringMode stringMode = StringMode::ZeroCopy, Batching batching = Batching::Automatic);
+
+enum class Format : uint8
+{
+	Compact,
+	Pretty,
+};
+
+// Streams JSON text into a growable buffer. Decimals are written with the fewest digits that read back to the same
+// value, and always with a fraction or an exponent, so that Load hands back exactly what was written. Pretty output
+// puts every member and element on its own line, indented with tabs.
+class Writer : public NoCopy
+{
+public:
+	explicit Writer(Format format = Format::Compact);
+	~Writer();
+
+	void BeginObject();
+	void EndObject();
+	void BeginArray();
+	void EndArray();
+
+	void WriteKey(StringView key);
+
+	void WriteString(StringView string);
+	void WriteDecimal(float64 decimal);
+	void WriteInteger(int64 integer);
+	void WriteBoolean(bool boolean);
+	void WriteNull();
+
+	void WriteValue(const Value& value);
+	void WriteObject(Object object);
+	void WriteArray(Array array);
+
+	// Only valid until the next write.
+	StringView GetText() const
+	{
+		return StringView(Text, Size);
+	}
+
+private:
+	static constexpr usize InitialCapacity = 64 * 1024;
+
+	void BeginValue();
+	void EndValue();
+	void WriteLineBreak();
+	void WriteQuoted(StringView string);
+	char* Reserve(usize size);
+
+	Format Format;
+
+	char* Text;
+	usize Size;
+	usize Capacity;
+
+	// Brackets of the containers still open, innermost last.
+	::Array<char> Scopes;
+	bool HasKey;
+	bool HasValue;
+};
+
+}
+
+consteval JSON::Key operator""_key(const char* name, usize length)
+{
+	return JSON::Key(name, length);
 }
@@ -0,0 +1,217 @@
+#include "Jobs.hpp"
+
+#if defined(_WIN32)
+#define JOBS_WIN32 1
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <stdlib.h>
+#endif
+
+namespace Jobs
+{
+
+class HeapAllocator final : public Allocator
+{
+public:
+	void* Allocate(usize size) override
+	{
+#if JOBS_WIN32
+		void* data = HeapAlloc(GetProcessHeap(), 0, size);
+#else
+		void* data = malloc(size);
+#endif
+		VERIFY(data, "Failed to allocate job worker memory!");
+		return data;
+	}
+
+	void Deallocate(void* data, usize) override
+	{
+#if JOBS_WIN32
+		HeapFree(GetProcessHeap(), 0, data);
+#else
+		free(data);
+#endif
+	}
+};
+
+static HeapAllocator WorkerAllocator;
+
+Allocator* GetWorkerAllocator()
+{
+	return &WorkerAllocator;
+}
+
+#if JOBS_WIN32
+
+static constexpr usize MaximumWorkerCount = MAXIMUM_WAIT_OBJECTS;
+
+struct Batch
+{
+	ParallelForFunction Function;
+	void* Context;
+	LONG64 Count;
+
+	volatile LONG64 NextIndex;
+	volatile LONG64 WorkersRunning;
+};
+
+static HANDLE Workers[MaximumWorkerCount] = {};
+static usize WorkerCount = 0;
+
+static HANDLE WorkAvailable = nullptr;
+static HANDLE WorkFinished = nullptr;
+static volatile LONG QuitRequested = 0;
+
+static Batch CurrentBatch = {};
+
+static void RunBatch()
+{
+	while (true)
+	{
+		const LONG64 index = InterlockedIncrement64(&CurrentBatch.NextIndex) - 1;
+		if (index >= CurrentBatch.Count)
+		{
+			return;
+		}
+		CurrentBatch.Function(CurrentBatch.Context, static_cast<usize>(index));
+	}
+}
+
+static DWORD WINAPI RunWorker(void*)
+{
+	while (true)
+	{
+		WaitForSingleObject(WorkAvailable, INFINITE);
+		if (QuitRequested)
+		{
+			return 0;
+		}
+
+		RunBatch();
+
+		// Every woken worker checks out, so a late one can never pick up the next batch while it is being written.
+		if (InterlockedDecrement64(&CurrentBatch.WorkersRunning) == 0)
+		{
+			SetEvent(WorkFinished);
+		}
+	}
+}
+
+usize GetDefaultWorkerCount()
+{
+	const usize processorCount = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+	return Min(processorCount > 1 ? processorCount - 1 : 0, MaximumWorkerCount);
+}
+
+void Init(usize workerCount)
+{
+	CHECK(!WorkAvailable);
+	VERIFY(workerCount <= MaximumWorkerCount, "Too many job workers!");
+
+	WorkAvailable = CreateSemaphoreA(nullptr, 0, static_cast<LONG>(MaximumWorkerCount), nullptr);
+	WorkFinished = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+	VERIFY(WorkAvailable && WorkFinished, "Failed to create job events!");
+
+	QuitRequested = 0;
+	for (usize workerIndex = 0; workerIndex < workerCount; ++workerIndex)
+	{
+		Workers[workerIndex] = CreateThread(nullptr, 0, RunWorker, nullptr, 0, nullptr);
+		VERIFY(Workers[workerIndex], "Failed to create job worker!");
+	}
+	WorkerCount = workerCount;
+}
+
+void Shutdown()
+{
+	if (!WorkAvailable)
+	{
+		return;
+	}
+
+	InterlockedExchange(&QuitRequested, 1);
+	if (WorkerCount != 0)
+	{
+		ReleaseSemaphore(WorkAvailable, static_cast<LONG>(WorkerCount), nullptr);
+		WaitForMultipleObjects(static_cast<DWORD>(WorkerCount), Workers, TRUE, INFINITE);
+	}
+
+	for (usize workerIndex = 0; workerIndex < WorkerCount; ++workerIndex)
+	{
+		CloseHandle(Workers[workerIndex]);
+		Workers[workerIndex] = nullptr;
+	}
+	WorkerCount = 0;
+
+	CloseHandle(WorkAvailable);
+	CloseHandle(WorkFinished);
+	WorkAvailable = nullptr;
+	WorkFinished = nullptr;
+}
+
+usize GetWorkerCount()
+{
+	return WorkerCount;
+}
+
+void ParallelFor(usize count, ParallelForFunction function, void* context)
+{
+	CHECK(function);
+
+	const usize helperCount = Min(WorkerCount, count != 0 ? count - 1 : 0);
+	if (helperCount == 0)
+	{
+		for (usize index = 0; index < count; ++index)
+		{
+			function(context, index);
+		}
+		return;
+	}
+
+	CurrentBatch.Function = function;
+	CurrentBatch.Context = context;
+	CurrentBatch.Count = static_cast<LONG64>(count);
+	CurrentBatch.NextIndex = 0;
+	CurrentBatch.WorkersRunning = static_cast<LONG64>(helperCount);
+
+	ReleaseSemaphore(WorkAvailable, static_cast<LONG>(helperCount), nullptr);
+	RunBatch();
+	WaitForSingleObject(WorkFinished, INFINITE);
+}
+
+#else
+
+// Without threads every call runs on the calling thread, so there are never any workers.
+
+usize GetDefaultWorkerCount()
+{
+	return 0;
+}
+
+void Init(usize)
+{
+}
+
+void Shutdown()
+{
+}
+
+usize GetWorkerCount()
+{
+	return 0;
+}
+
+void ParallelFor(usize count, ParallelForFunction function, void* context)
+{
+	CHECK(function);
+
+	for (usize index = 0; index < count; ++index)
+	{
+		function(context, index);
+	}
+}
+
+#endif
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Luft/Base.hpp"
+
+namespace Jobs
+{
+
+using ParallelForFunction = void (*)(void* context, usize index);
+
+usize GetDefaultWorkerCount();
+
+void Init(usize workerCount);
+void Shutdown();
+
+usize GetWorkerCount();
+
+// Calls the function once for every index below the count, spread over the workers and the calling thread, and
+// returns once all calls have finished. Only one thread may issue work at a time, and the function must not issue
+// work itself. The function may only allocate through the worker allocator, since GlobalAllocator isn't safe to call
+// from several threads at once.
+void ParallelFor(usize count, ParallelForFunction function, void* context);
+
+// Backed by the system heap, which can be called from any thread.
+Allocator* GetWorkerAllocator();
+
+}
@@ -0,0 +1,649 @@
+#include "Meshopt.hpp"
+
+#include "Luft/Math.hpp"
+#include "Luft/Platform.hpp"
+
+#include <math.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MESHOPT_SIMD_X86 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MESHOPT_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Meshopt
+{
+
+static constexpr uint8 VertexHeader = 0xA0;
+static constexpr uint8 IndexHeader = 0xE1;
+static constexpr uint8 SequenceHeader = 0xD1;
+
+static constexpr usize ByteGroupSize = 16;
+static constexpr usize VertexBlockSizeBytes = 8192;
+static constexpr usize VertexBlockMaxSize = 256;
+static constexpr usize VertexMaxStride = 256;
+static constexpr usize VertexTailMaxSize = 32;
+
+static constexpr usize IndexCodeAuxSize = 16;
+static constexpr usize SequenceTailSize = 4;
+
+static usize GetVertexBlockSize(usize stride)
+{
+	const usize blockSize = (VertexBlockSizeBytes / stride) & ~(ByteGroupSize - 1);
+	return Min(blockSize, VertexBlockMaxSize);
+}
+
+// Unpacks sixteen fields of 2 or 4 bits, most significant first, into a byte each. Returns a mask of the fields that
+// hold the escape value, which stand for a whole byte stored after the group.
+static uint32 UnpackByteGroup(const uint8* data, usize bits, uint8* output)
+{
+	const uint8 escape = static_cast<uint8>((1 << bits) - 1);
+
+#if MESHOPT_SIMD_X86
+	__m128i fields;
+	if (bits == 2)
+	{
+		uint32 packed;
+		Platform::MemoryCopy(&packed, data, sizeof(packed));
+
+		// Shifting 16-bit lanes is fine, as the mask drops the bits that cross into the other byte.
+		const __m128i bytes = _mm_cvtsi32_si128(static_cast<int32>(packed));
+		const __m128i mask = _mm_set1_epi8(3);
+		const __m128i fields6 = _mm_and_si128(_mm_srli_epi16(bytes, 6), mask);
+		const __m128i fields4 = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+		const __m128i fields2 = _mm_and_si128(_mm_srli_epi16(bytes, 2), mask);
+		const __m128i fields0 = _mm_and_si128(bytes, mask);
+		fields = _mm_unpacklo_epi16(_mm_unpacklo_epi8(fields6, fields4), _mm_unpacklo_epi8(fields2, fields0));
+	}
+	else
+	{
+		const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+		const __m128i mask = _mm_set1_epi8(15);
+		fields = _mm_unpacklo_epi8(_mm_and_si128(_mm_srli_epi16(bytes, 4), mask), _mm_and_si128(bytes, mask));
+	}
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(output), fields);
+
+	return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(fields, _mm_set1_epi8(static_cast<char>(escape)))));
+#elif MESHOPT_SIMD_NEON
+	uint8x16_t fields;
+	if (bits == 2)
+	{
+		uint32 packed;
+		Platform::MemoryCopy(&packed, data, sizeof(packed));
+
+		const uint8x8_t bytes = vreinterpret_u8_u32(vdup_n_u32(packed));
+		const uint8x8_t mask = vdup_n_u8(3);
+		const uint8x8_t high = vzip1_u8(vshr_n_u8(bytes, 6), vand_u8(vshr_n_u8(bytes, 4), mask));
+		const uint8x8_t low = vzip1_u8(vand_u8(vshr_n_u8(bytes, 2), mask), vand_u8(bytes, mask));
+		const uint16x4_t high16 = vreinterpret_u16_u8(high);
+		const uint16x4_t low16 = vreinterpret_u16_u8(low);
+		fields = vcombine_u8(vreinterpret_u8_u16(vzip1_u16(high16, low16)), vreinterpret_u8_u16(vzip2_u16(high16, low16)));
+	}
+	else
+	{
+		const uint8x8_t bytes = vld1_u8(data);
+		const uint8x8_t high = vshr_n_u8(bytes, 4);
+		const uint8x8_t low = vand_u8(bytes, vdup_n_u8(15));
+		fields = vcombine_u8(vzip1_u8(high, low), vzip2_u8(high, low));
+	}
+	vst1q_u8(output, fields);
+
+	static constexpr uint8 bitValues[] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	const uint8x16_t escapeBits = vandq_u8(vceqq_u8(fields, vdupq_n_u8(escape)), vld1q_u8(bitValues));
+	return static_cast<uint32>(vaddv_u8(vget_low_u8(escapeBits))) | (static_cast<uint32>(vaddv_u8(vget_high_u8(escapeBits))) << 8);
+#else
+	uint32 escapeMask = 0;
+	for (usize fieldIndex = 0; fieldIndex < ByteGroupSize; ++fieldIndex)
+	{
+		const usize bitOffset = fieldIndex * bits;
+		const uint8 field = (data[bitOffset / 8] >> (8 - bits - bitOffset % 8)) & escape;
+		output[fieldIndex] = field;
+		escapeMask |= static_cast<uint32>(field == escape) << fieldIndex;
+	}
+	return escapeMask;
+#endif
+}
+
+static const uint8* DecodeByteGroup(const uint8* data, const uint8* dataEnd, usize bitsLog2, uint8* output)
+{
+	switch (bitsLog2)
+	{
+	case 0:
+		Platform::MemorySet(output, 0, ByteGroupSize);
+		return data;
+	case 1:
+	case 2:
+	{
+		const usize bits = usize { 1 } << bitsLog2;
+		const usize packedSize = ByteGroupSize * bits / 8;
+		VERIFY(static_cast<usize>(dataEnd - data) >= packedSize, "Invalid meshopt vertex data!");
+
+		const uint32 escapeMask = UnpackByteGroup(data, bits, output);
+		data += packedSize;
+
+		for (usize fieldIndex = 0; escapeMask >> fieldIndex; ++fieldIndex)
+		{
+			if (escapeMask & (1u << fieldIndex))
+			{
+				VERIFY(data < dataEnd, "Invalid meshopt vertex data!");
+				output[fieldIndex] = *data++;
+			}
+		}
+		return data;
+	}
+	case 3:
+		VERIFY(static_cast<usize>(dataEnd - data) >= ByteGroupSize, "Invalid meshopt vertex data!");
+		Platform::MemoryCopy(output, data, ByteGroupSize);
+		return data + ByteGroupSize;
+	default:
+		CHECK(false);
+		return data;
+	}
+}
+
+// Decodes the bytes at one offset within the vertex for every vertex of a block. Each group of sixteen has a 2-bit
+// width in the header that precedes them.
+static const uint8* DecodeBytes(const uint8* data, const uint8* dataEnd, uint8* output, usize alignedCount)
+{
+	const usize groupCount = alignedCount / ByteGroupSize;
+	const usize headerSize = (groupCount + 3) / 4;
+	VERIFY(static_cast<usize>(dataEnd - data) >= headerSize, "Invalid meshopt vertex data!");
+
+	const uint8* header = data;
+	data += headerSize;
+
+	for (usize groupIndex = 0; groupIndex < groupCount; ++groupIndex)
+	{
+		const usize bitsLog2 = (header[groupIndex / 4] >> ((groupIndex % 4) * 2)) & 3;
+		data = DecodeByteGroup(data, dataEnd, bitsLog2, output + groupIndex * ByteGroupSize);
+	}
+	return data;
+}
+
+// Undoes the zigzag encoded deltas of four neighbouring bytes of the vertex, each running on from the same byte of the
+// previous vertex, and writes them back in place.
+static void AccumulateDeltas(const uint8 (&deltas)[4][VertexBlockMaxSize], usize count, uint8* vertices, usize stride, uint8* previous)
+{
+#if MESHOPT_SIMD_X86
+	__m128i previousBytes[4];
+	for (usize channel = 0; channel < 4; ++channel)
+	{
+		previousBytes[channel] = _mm_set1_epi8(static_cast<char>(previous[channel]));
+	}
+
+	for (usize first = 0; first < count; first += ByteGroupSize)
+	{
+		__m128i channels[4];
+		for (usize channel = 0; channel < 4; ++channel)
+		{
+			const __m128i encoded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(deltas[channel] + first));
+			const __m128i sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(encoded, _mm_set1_epi8(1)));
+			__m128i values = _mm_xor_si128(_mm_and_si128(_mm_srli_epi16(encoded, 1), _mm_set1_epi8(127)), sign);
+
+			values = _mm_add_epi8(values, _mm_slli_si128(values, 1));
+			values = _mm_add_epi8(values, _mm_slli_si128(values, 2));
+			values = _mm_add_epi8(values, _mm_slli_si128(values, 4));
+			values = _mm_add_epi8(values, _mm_slli_si128(values, 8));
+			values = _mm_add_epi8(values, previousBytes[channel]);
+
+			previousBytes[channel] = _mm_set1_epi8(static_cast<char>(_mm_extract_epi16(values, 7) >> 8));
+			channels[channel] = values;
+		}
+
+		const __m128i pairs01Low = _mm_unpacklo_epi8(channels[0], channels[1]);
+		const __m128i pairs01High = _mm_unpackhi_epi8(channels[0], channels[1]);
+		const __m128i pairs23Low = _mm_unpacklo_epi8(channels[2], channels[3]);
+		const __m128i pairs23High = _mm_unpackhi_epi8(channels[2], channels[3]);
+
+		alignas(16) uint32 words[ByteGroupSize];
+		_mm_store_si128(reinterpret_cast<__m128i*>(words + 0), _mm_unpacklo_epi16(pairs01Low, pairs23Low));
+		_mm_store_si128(reinterpret_cast<__m128i*>(words + 4), _mm_unpackhi_epi16(pairs01Low, pairs23Low));
+		_mm_store_si128(reinterpret_cast<__m128i*>(words + 8), _mm_unpacklo_epi16(pairs01High, pairs23High));
+		_mm_store_si128(reinterpret_cast<__m128i*>(words + 12), _mm_unpackhi_epi16(pairs01High, pairs23High));
+
+		const usize groupCount = Min(ByteGroupSize, count - first);
+		for (usize vertexIndex = 0; vertexIndex < groupCount; ++vertexIndex)
+		{
+			Platform::MemoryCopy(vertices + (first + vertexIndex) * stride, &words[vertexIndex], sizeof(uint32));
+		}
+	}
+
+	for (usize channel = 0; channel < 4; ++channel)
+	{
+		previous[channel] = static_cast<uint8>(_mm_cvtsi128_si32(previousBytes[channel]));
+	}
+#elif MESHOPT_SIMD_NEON
+	uint8x16_t previousBytes[4];
+	for (usize channel = 0; channel < 4; ++channel)
+	{
+		previousBytes[channel] = vdupq_n_u8(previous[channel]);
+	}
+
+	const uint8x16_t zero = vdupq_n_u8(0);
+	for (usize first = 0; first < count; first += ByteGroupSize)
+	{
+		uint8x16_t channels[4];
+		for (usize channel = 0; channel < 4; ++channel)
+		{
+			const uint8x16_t encoded = vld1q_u8(deltas[channel] + first);
+			const uint8x16_t sign = vsubq_u8(zero, vandq_u8(encoded, vdupq_n_u8(1)));
+			uint8x16_t values = veorq_u8(vshrq_n_u8(encoded, 1), sign);
+
+			values = vaddq_u8(values, vextq_u8(zero, values, 15));
+			values = vaddq_u8(values, vextq_u8(zero, values, 14));
+			values = vaddq_u8(values, vextq_u8(zero, values, 12));
+			values = vaddq_u8(values, vextq_u8(zero, values, 8));
+			values = vaddq_u8(values, previousBytes[channel]);
+
+			previousBytes[channel] = vdupq_laneq_u8(values, 15);
+			channels[channel] = values;
+		}
+
+		const uint16x8_t pairs01Low = vreinterpretq_u16_u8(vzip1q_u8(channels[0], channels[1]));
+		const uint16x8_t pairs01High = vreinterpretq_u16_u8(vzip2q_u8(channels[0], channels[1]));
+		const uint16x8_t pairs23Low = vreinterpretq_u16_u8(vzip1q_u8(channels[2], channels[3]));
+		const uint16x8_t pairs23High = vreinterpretq_u16_u8(vzip2q_u8(channels[2], channels[3]));
+
+		alignas(16) uint32 words[ByteGroupSize];
+		vst1q_u32(words + 0, vreinterpretq_u32_u16(vzip1q_u16(pairs01Low, pairs23Low)));
+		vst1q_u32(words + 4, vreinterpretq_u32_u16(vzip2q_u16(pairs01Low, pairs23Low)));
+		vst1q_u32(words + 8, vreinterpretq_u32_u16(vzip1q_u16(pairs01High, pairs23High)));
+		vst1q_u32(words + 12, vreinterpretq_u32_u16(vzip2q_u16(pairs01High, pairs23High)));
+
+		const usize groupCount = Min(ByteGroupSize, count - first);
+		for (usize vertexIndex = 0; vertexIndex < groupCount; ++vertexIndex)
+		{
+			Platform::MemoryCopy(vertices + (first + vertexIndex) * stride, &words[vertexIndex], sizeof(uint32));
+		}
+	}
+
+	for (usize channel = 0; channel < 4; ++channel)
+	{
+		previous[channel] = vgetq_lane_u8(previousBytes[channel], 0);
+	}
+#else
+	for (usize channel = 0; channel < 4; ++channel)
+	{
+		uint8 value = previous[channel];
+		for (usize vertexIndex = 0; vertexIndex < count; ++vertexIndex)
+		{
+			const uint8 encoded = deltas[channel][vertexIndex];
+			value += static_cast<uint8>((encoded >> 1) ^ -(encoded & 1));
+			vertices[vertexIndex * stride + channel] = value;
+		}
+		previous[channel] = value;
+	}
+#endif
+}
+
+static const uint8* DecodeVertexBlock(const uint8* data, const uint8* dataEnd, uint8* vertices, usize count, usize stride, uint8* previousVertex)
+{
+	const usize alignedCount = NextMultipleOf(count, ByteGroupSize);
+
+	uint8 deltas[4][VertexBlockMaxSize];
+	for (usize offset = 0; offset < stride; offset += 4)
+	{
+		for (usize channel = 0; channel < 4; ++channel)
+		{
+			data = DecodeBytes(data, dataEnd, deltas[channel], alignedCount);
+		}
+		AccumulateDeltas(deltas, count, vertices + offset, stride, previousVertex + offset);
+	}
+	return data;
+}
+
+// Vertices come in blocks that store each byte of the vertex as deltas from the vertex before. The stream ends with a
+// tail holding the vertex the first deltas start from.
+static void DecodeVertexBuffer(uint8* destination, usize count, usize stride, const uint8* data, usize size)
+{
+	VERIFY(stride > 0 && stride <= VertexMaxStride && stride % 4 == 0, "Invalid meshopt vertex stride!");
+
+	const usize tailSize = Max(stride, VertexTailMaxSize);
+	VERIFY(size >= 1 + tailSize && data[0] == VertexHeader, "Invalid meshopt vertex data!");
+
+	uint8 previousVertex[VertexMaxStride];
+	Platform::MemoryCopy(previousVertex, data + size - stride, stride);
+
+	const uint8* dataEnd = data + size - tailSize;
+	const uint8* block = data + 1;
+
+	const usize blockSize = GetVertexBlockSize(stride);
+	for (usize first = 0; first < count; first += blockSize)
+	{
+		block = DecodeVertexBlock(block, dataEnd, destination + first * stride, Min(blockSize, count - first), stride, previousVertex);
+	}
+	VERIFY(block == dataEnd, "Invalid meshopt vertex data!");
+}
+
+static uint32 DecodeVariableLength(const uint8** data)
+{
+	const uint8* bytes = *data;
+
+	uint32 value = bytes[0] & 127;
+	usize byteCount = 1;
+	for (uint32 shift = 7; bytes[byteCount - 1] >= 128 && byteCount < 5; shift += 7)
+	{
+		value |= static_cast<uint32>(bytes[byteCount] & 127) << shift;
+		++byteCount;
+	}
+
+	*data += byteCount;
+	return value;
+}
+
+static uint32 DecodeIndex(const uint8** data, uint32 last)
+{
+	const uint32 value = DecodeVariableLength(data);
+	return last + ((value >> 1) ^ (0u - (value & 1)));
+}
+
+static void WriteIndex(uint8* destination, usize index, usize indexSize, uint32 value)
+{
+	if (indexSize == sizeof(uint16))
+	{
+		const uint16 narrowValue = static_cast<uint16>(value);
+		Platform::MemoryCopy(destination + index * sizeof(uint16), &narrowValue, sizeof(uint16));
+	}
+	else
+	{
+		Platform::MemoryCopy(destination + index * sizeof(uint32), &value, sizeof(uint32));
+	}
+}
+
+static void WriteTriangle(uint8* destination, usize firstIndex, usize indexSize, uint32 a, uint32 b, uint32 c)
+{
+	WriteIndex(destination, firstIndex + 0, indexSize, a);
+	WriteIndex(destination, firstIndex + 1, indexSize, b);
+	WriteIndex(destination, firstIndex + 2, indexSize, c);
+}
+
+struct TriangleState
+{
+	uint32 Edges[16][2];
+	uint32 Vertices[16];
+	usize EdgeOffset;
+	usize VertexOffset;
+	uint32 Next;
+	uint32 Last;
+};
+
+static void PushEdge(TriangleState* state, uint32 a, uint32 b)
+{
+	state->Edges[state->EdgeOffset][0] = a;
+	state->Edges[state->EdgeOffset][1] = b;
+	state->EdgeOffset = (state->EdgeOffset + 1) & 15;
+}
+
+static void PushVertex(TriangleState* state, uint32 vertex, bool advance = true)
+{
+	state->Vertices[state->VertexOffset] = vertex;
+	state->VertexOffset = (state->VertexOffset + advance) & 15;
+}
+
+// Every triangle has a code byte that reuses an edge or vertices from the recent triangles, or a new vertex. Indices
+// that can't be reused are stored as deltas from the last one, and the stream ends with a table of common codes.
+static void DecodeIndexBuffer(uint8* destination, usize count, usize indexSize, const uint8* data, usize size)
+{
+	VERIFY(count % 3 == 0, "Invalid meshopt index count!");
+	VERIFY(indexSize == sizeof(uint16) || indexSize == sizeof(uint32), "Invalid meshopt index stride!");
+
+	const usize triangleCount = count / 3;
+	VERIFY(size >= 1 + triangleCount + IndexCodeAuxSize && data[0] == IndexHeader, "Invalid meshopt index data!");
+
+	const uint8* codes = data + 1;
+	const uint8* codeAuxTable = data + size - IndexCodeAuxSize;
+	const uint8* current = codes + triangleCount;
+
+	TriangleState state;
+	Platform::MemorySet(&state, 0xFF, sizeof(state));
+	state.EdgeOffset = 0;
+	state.VertexOffset = 0;
+	state.Next = 0;
+	state.Last = 0;
+
+	for (usize triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		// A triangle reads at most 16 bytes, which the code table behind the data leaves room for.
+		VERIFY(current <= codeAuxTable, "Invalid meshopt index data!");
+
+		const uint8 code = codes[triangleIndex];
+		if (code < 0xF0)
+		{
+			const usize edgeIndex = (state.EdgeOffset - 1 - (code >> 4)) & 15;
+			const uint32 a = state.Edges[edgeIndex][0];
+			const uint32 b = state.Edges[edgeIndex][1];
+
+			const uint32 vertexCode = code & 15;
+			uint32 c;
+			if (vertexCode == 0)
+			{
+				c = state.Next++;
+				PushVertex(&state, c);
+			}
+			else if (vertexCode < 13)
+			{
+				c = state.Vertices[(state.VertexOffset - 1 - vertexCode) & 15];
+				PushVertex(&state, c, false);
+			}
+			else
+			{
+				// 13 and 14 stand for the index right before and after the last one.
+				c = vertexCode == 15 ? DecodeIndex(&current, state.Last) : state.Last + (vertexCode == 13 ? -1 : 1);
+				state.Last = c;
+				PushVertex(&state, c);
+			}
+
+			WriteTriangle(destination, triangleIndex * 3, indexSize, a, b, c);
+
+			PushEdge(&state, c, b);
+			PushEdge(&state, a, c);
+		}
+		else
+		{
+			uint32 a;
+			uint32 bCode;
+			uint32 cCode;
+			if (code < 0xFE)
+			{
+				const uint8 codeAux = codeAuxTable[code & 15];
+				a = state.Next++;
+				bCode = codeAux >> 4;
+				cCode = codeAux & 15;
+			}
+			else
+			{
+				const uint8 codeAux = *current++;
+				if (codeAux == 0)
+				{
+					state.Next = 0;
+				}
+				a = code == 0xFE ? state.Next++ : 0;
+				bCode = codeAux >> 4;
+				cCode = codeAux & 15;
+			}
+
+			uint32 b = bCode == 0 ? state.Next++ : state.Vertices[(state.VertexOffset - bCode) & 15];
+			uint32 c = cCode == 0 ? state.Next++ : state.Vertices[(state.VertexOffset - cCode) & 15];
+
+			if (code == 0xFF)
+			{
+				a = DecodeIndex(&current, state.Last);
+				state.Last = a;
+			}
+			if (code >= 0xFE && bCode == 15)
+			{
+				b = DecodeIndex(&current, state.Last);
+				state.Last = b;
+			}
+			if (code >= 0xFE && cCode == 15)
+			{
+				c = DecodeIndex(&current, state.Last);
+				state.Last = c;
+			}
+
+			WriteTriangle(destination, triangleIndex * 3, indexSize, a, b, c);
+
+			PushVertex(&state, a);
+			PushVertex(&state, b, bCode == 0 || bCode == 15);
+			PushVertex(&state, c, cCode == 0 || cCode == 15);
+
+			PushEdge(&state, b, a);
+			PushEdge(&state, c, b);
+			PushEdge(&state, a, c);
+		}
+	}
+	VERIFY(current == codeAuxTable, "Invalid meshopt index data!");
+}
+
+// Every index is a delta from one of two earlier indices, with the low bit choosing which.
+static void DecodeIndexSequence(uint8* destination, usize count, usize indexSize, const uint8* data, usize size)
+{
+	VERIFY(indexSize == sizeof(uint16) || indexSize == sizeof(uint32), "Invalid meshopt index stride!");
+	VERIFY(size >= 1 + SequenceTailSize && data[0] == SequenceHeader, "Invalid meshopt index data!");
+
+	const uint8* current = data + 1;
+	const uint8* dataEnd = data + size - SequenceTailSize;
+
+	uint32 last[2] = { 0, 0 };
+	for (usize index = 0; index < count; ++index)
+	{
+		// An index reads at most 5 bytes, which the tail leaves room for.
+		VERIFY(current < dataEnd, "Invalid meshopt index data!");
+
+		const uint32 value = DecodeVariableLength(&current);
+		const uint32 baseline = value & 1;
+		const uint32 delta = value >> 1;
+
+		last[baseline] += (delta >> 1) ^ (0u - (delta & 1));
+		WriteIndex(destination, index, indexSize, last[baseline]);
+	}
+	VERIFY(current == dataEnd, "Invalid meshopt index data!");
+}
+
+static int32 RoundToInt(float32 value)
+{
+	return static_cast<int32>(value + (value >= 0.0f ? 0.5f : -0.5f));
+}
+
+// Normals and tangents stored as octahedral coordinates, with the third component holding the scale they were
+// stored at, are turned back into unit vectors. The fourth component is left alone.
+template<typename T>
+static void DecodeOctahedral(uint8* data, usize count, float32 maximum)
+{
+	for (usize elementIndex = 0; elementIndex < count; ++elementIndex)
+	{
+		T components[4];
+		Platform::MemoryCopy(components, data + elementIndex * sizeof(components), sizeof(components));
+
+		float32 x = components[0];
+		float32 y = components[1];
+		const float32 z = components[2] - fabsf(x) - fabsf(y);
+
+		const float32 fold = Min(z, 0.0f);
+		x += x >= 0.0f ? fold : -fold;
+		y += y >= 0.0f ? fold : -fold;
+
+		const float32 scale = maximum / sqrtf(x * x + y * y + z * z);
+		components[0] = static_cast<T>(RoundToInt(x * scale));
+		components[1] = static_cast<T>(RoundToInt(y * scale));
+		components[2] = static_cast<T>(RoundToInt(z * scale));
+
+		Platform::MemoryCopy(data + elementIndex * sizeof(components), components, sizeof(components));
+	}
+}
+
+// Rotations store three components of the quaternion, with the largest one left out and rebuilt from the others. The
+// fourth component holds which one was left out and the scale the others were stored at.
+static void DecodeQuaternions(uint8* data, usize count)
+{
+	static constexpr float32 scale = 0.70710678f;
+
+	for (usize elementIndex = 0; elementIndex < count; ++elementIndex)
+	{
+		int16 components[4];
+		Platform::MemoryCopy(components, data + elementIndex * sizeof(components), sizeof(components));
+
+		const float32 componentScale = scale / static_cast<float32>(components[3] | 3);
+		const float32 x = components[0] * componentScale;
+		const float32 y = components[1] * componentScale;
+		const float32 z = components[2] * componentScale;
+		const float32 w = sqrtf(Max(1.0f - x * x - y * y - z * z, 0.0f));
+
+		const usize largest = components[3] & 3;
+		components[(largest + 1) & 3] = static_cast<int16>(RoundToInt(x * 32767.0f));
+		components[(largest + 2) & 3] = static_cast<int16>(RoundToInt(y * 32767.0f));
+		components[(largest + 3) & 3] = static_cast<int16>(RoundToInt(z * 32767.0f));
+		components[(largest + 0) & 3] = static_cast<int16>(RoundToInt(w * 32767.0f));
+
+		Platform::MemoryCopy(data + elementIndex * sizeof(components), components, sizeof(components));
+	}
+}
+
+// Floats stored as a 24-bit mantissa and an 8-bit exponent.
+static void DecodeExponential(uint8* data, usize count)
+{
+	for (usize valueIndex = 0; valueIndex < count; ++valueIndex)
+	{
+		int32 encoded;
+		Platform::MemoryCopy(&encoded, data + valueIndex * sizeof(encoded), sizeof(encoded));
+
+		const int32 mantissa = static_cast<int32>(static_cast<uint32>(encoded) << 8) >> 8;
+		const int32 exponent = encoded >> 24;
+
+		const uint32 powerBits = static_cast<uint32>(exponent + 127) << 23;
+		float32 power;
+		Platform::MemoryCopy(&power, &powerBits, sizeof(power));
+
+		const float32 value = power * static_cast<float32>(mantissa);
+		Platform::MemoryCopy(data + valueIndex * sizeof(value), &value, sizeof(value));
+	}
+}
+
+void Decode(uint8* destination, usize count, usize stride, Mode mode, Filter filter, const uint8* data, usize size)
+{
+	switch (mode)
+	{
+	case Mode::Attributes:
+		DecodeVertexBuffer(destination, count, stride, data, size);
+		break;
+	case Mode::Triangles:
+		DecodeIndexBuffer(destination, count, stride, data, size);
+		break;
+	case Mode::Indices:
+		DecodeIndexSequence(destination, count, stride, data, size);
+		break;
+	default:
+		CHECK(false);
+	}
+
+	switch (filter)
+	{
+	case Filter::None:
+		break;
+	case Filter::Octahedral:
+		VERIFY(mode == Mode::Attributes && (stride == 4 || stride == 8), "Invalid meshopt octahedral filter stride!");
+		if (stride == 4)
+		{
+			DecodeOctahedral<int8>(destination, count, 127.0f);
+		}
+		else
+		{
+			DecodeOctahedral<int16>(destination, count, 32767.0f);
+		}
+		break;
+	case Filter::Quaternion:
+		VERIFY(mode == Mode::Attributes && stride == 8, "Invalid meshopt quaternion filter stride!");
+		DecodeQuaternions(destination, count);
+		break;
+	case Filter::Exponential:
+		VERIFY(mode == Mode::Attributes && stride % 4 == 0, "Invalid meshopt exponential filter stride!");
+		DecodeExponential(destination, count * stride / 4);
+		break;
+	default:
+		CHECK(false);
+	}
+}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Luft/Base.hpp"
+
+// Decoders for the vertex and index codecs of EXT_meshopt_compression.
+namespace Meshopt
+{
+
+enum class Mode : uint8
+{
+	Attributes,
+	Triangles,
+	Indices,
+};
+
+enum class Filter : uint8
+{
+	None,
+	Octahedral,
+	Quaternion,
+	Exponential,
+};
+
+// Decodes count elements of the given stride from an encoded stream into the destination, then undoes the filter.
+// Malformed streams fail verification.
+void Decode(uint8* destination, usize count, usize stride, Mode mode, Filter filter, const uint8* data, usize size);
+
+}
@@ -5,6 +5,11 @@
 #include "Luft/Array.hpp"
 #include "Luft/Math.hpp"
 
+namespace HLSL
+{
+#include "Shaders/Types.hlsli"
+}
+
 static constexpr RHI::ResourceFormat HDRFormat = RHI::ResourceFormat::RGBA32Float;
 
 struct ReadBuffer
@@ -33,6 +38,16 @@ struct WriteTexture
 	RHI::TextureView UnorderedAccessView;
 };
 
+// A box and a sphere that each hold everything bounded. Empty bounds have Min above Max and a negative radius.
+struct Bounds
+{
+	float32x3 Min;
+	float32x3 Max;
+
+	float32x3 Center;
+	float32 Radius;
+};
+
 struct Primitive
 {
 	usize GlobalIndex;
@@ -41,19 +56,25 @@ struct Primitive
 	usize PositionOffset;
 	usize PositionStride;
 	usize PositionSize;
+	HLSL::VertexFormat PositionFormat;
 
 	usize TextureCoordinateOffset;
 	usize TextureCoordinateStride;
 	usize TextureCoordinateSize;
+	HLSL::VertexFormat TextureCoordinateFormat;
 
 	usize NormalOffset;
 	usize NormalStride;
 	usize NormalSize;
+	HLSL::VertexFormat NormalFormat;
 
 	usize IndexOffset;
 	usize IndexStride;
 	usize IndexSize;
 
+	// In mesh space.
+	Bounds Bounds;
+
 	RHI::Resource AccelerationStructureResource;
 };
 
@@ -66,6 +87,18 @@ struct Node
 {
 	Matrix LocalToWorld;
 	usize MeshIndex;
+
+	Bounds WorldBounds;
+};
+
+// Every placement of one primitive, drawn together. Their draw calls are one run of the draw call buffer.
+struct DrawGroup
+{
+	usize MeshIndex;
+	usize MeshPrimitiveIndex;
+
+	usize FirstDrawCall;
+	usize DrawCallCount;
 };
 
 struct SpecularGlossiness
@@ -105,8 +138,3 @@ struct Material
 
 	bool DoubleSided;
 };
-
-namespace HLSL
-{
-#include "Shaders/Types.hlsli"
-}
@@ -2,6 +2,7 @@
 #include "CameraController.hpp"
 #include "DDS.hpp"
 #include "GLTF.hpp"
+#include "Jobs.hpp"
 #include "RenderContext.hpp"
 #include "RenderGraph.hpp"
 #include "ResourceUploader.hpp"
@@ -43,6 +44,74 @@ static ReadTexture CreateReadTexture(ResourceUploader::Lifetime lifetime,
 	return ReadTexture { texture, view };
 }
 
+struct BufferCopy
+{
+	const uint8* Source;
+	uint8* Destination;
+	usize Size;
+};
+
+static void CopyBuffer(void* context, usize index)
+{
+	const BufferCopy& copy = static_cast<const BufferCopy*>(context)[index];
+	Platform::MemoryCopy(copy.Destination, copy.Source, copy.Size);
+}
+
+static HLSL::VertexFormat GetVertexFormat(const GLTF::Accessor& accessor)
+{
+	switch (accessor.ComponentType)
+	{
+	case GLTF::ComponentType::Int8:
+		return accessor.Normalized ? HLSL::VertexFormat::Int8Normalized : HLSL::VertexFormat::Int8;
+	case GLTF::ComponentType::UInt8:
+		return accessor.Normalized ? HLSL::VertexFormat::UInt8Normalized : HLSL::VertexFormat::UInt8;
+	case GLTF::ComponentType::Int16:
+		return accessor.Normalized ? HLSL::VertexFormat::Int16Normalized : HLSL::VertexFormat::Int16;
+	case GLTF::ComponentType::UInt16:
+		return accessor.Normalized ? HLSL::VertexFormat::UInt16Normalized : HLSL::VertexFormat::UInt16;
+	case GLTF::ComponentType::Float32:
+		return HLSL::VertexFormat::Float32;
+	default:
+		VERIFY(false, "Unexpected GLTF vertex component type!");
+		return HLSL::VertexFormat::Float32;
+	}
+}
+
+static Bounds ToBounds(const GLTF::Bounds& bounds)
+{
+	return Bounds
+	{
+		.Min = bounds.Min,
+		.Max = bounds.Max,
+		.Center = bounds.Center,
+		.Radius = bounds.Radius,
+	};
+}
+
+static usize GetVertexCount(const GLTF::Scene& scene, const Primitive& primitive)
+{
+	const usize positionAccessor = GLTF::GetAttribute(scene.Primitives[primitive.GlobalIndex], GLTF::AttributeType::Position);
+	return scene.Accessors[positionAccessor].Count;
+}
+
+// Acceleration structures are built from 32-bit float positions only, so quantized positions are widened for them.
+static void DecodePositions(const GLTF::Scene& scene, usize accessorIndex, Array<float32>* positions)
+{
+	const GLTF::Accessor& accessor = scene.Accessors[accessorIndex];
+	const GLTF::AccessorView view = GLTF::GetAccessorView(scene, accessorIndex);
+	const usize componentSize = GLTF::GetComponentSize(accessor.ComponentType);
+
+	const uint8* data = scene.Buffers[view.Buffer].Data + view.Offset;
+	for (usize vertexIndex = 0; vertexIndex < accessor.Count; ++vertexIndex)
+	{
+		const uint8* vertex = data + vertexIndex * view.Stride;
+		for (usize componentIndex = 0; componentIndex < 3; ++componentIndex)
+		{
+			positions->Add(GLTF::DecodeComponent(vertex + componentIndex * componentSize, accessor.ComponentType, accessor.Normalized));
+		}
+	}
+}
+
 static ReadBuffer CreateReadBuffer(ResourceUploader::Lifetime lifetime,
 								   usize size,
 								   usize stride,
@@ -95,8 +164,10 @@ Renderer::Renderer(Platform::Window* window, bool validation)
 	, AverageTimeGPU(0.0)
 	, SceneMeshes(RendererAllocator)
 	, SceneNodes(RendererAllocator)
+	, SceneDrawGroups(RendererAllocator)
 	, SceneMaterials(RendererAllocator)
 	, SceneTwoChannelNormalMaps(false)
+	, ScenePrimitiveAccelerationStructureResources(RendererAllocator)
 {
 	CreateRenderContext(window, validation);
 
@@ -394,61 +465,33 @@ void Renderer::UpdateRasterization()
 		GlobalGraphics().ClearDepthStencil(DepthTextureView);
 		GlobalGraphics().SetRenderTarget(VisibilityTexture.RenderTargetView, DepthTextureView);
 
-		usize drawCallIndex = 0;
-		for (usize nodeIndex = 0; nodeIndex < SceneNodes.GetCount(); ++nodeIndex)
+		for (const DrawGroup& drawGroup : SceneDrawGroups)
 		{
-			const Node& node = SceneNodes[nodeIndex];
-			const Mesh& mesh = SceneMeshes[node.MeshIndex];
+			const Primitive& primitive = SceneMeshes[drawGroup.MeshIndex].Primitives[drawGroup.MeshPrimitiveIndex];
+			const usize indexCount = primitive.IndexSize / primitive.IndexStride;
 
-			for (const Primitive& primitive : mesh.Primitives)
+			const HLSL::VisibilityRootConstants rootConstants =
 			{
-				const HLSL::VisibilityRootConstants rootConstants =
-				{
-					.DrawCallIndex = static_cast<uint32>(drawCallIndex),
-					.PrimitiveIndex = static_cast<uint32>(primitive.GlobalIndex),
-					.NodeIndex = static_cast<uint32>(nodeIndex),
-					.ViewMode = ViewMode,
-				};
-
-				++drawCallIndex;
+				.FirstDrawCallIndex = static_cast<uint32>(drawGroup.FirstDrawCall),
+				.PrimitiveIndex = static_cast<uint32>(primitive.GlobalIndex),
+				.ViewMode = ViewMode,
+			};
 
-				const Material& material = SceneMaterials[primitive.MaterialIndex];
+			const Material& material = SceneMaterials[primitive.MaterialIndex];
 
-				GlobalGraphics().SetPipeline(material.DoubleSided ? VisibilityDoubleSidedPipeline : VisibilityPipeline);
-				GlobalGraphics().SetRootConstants(&rootConstants);
-				GlobalGraphics().SetConstantBuffer("Scene"_view, SceneBufferResources[GlobalDevice().GetFrameIndex()]);
+			GlobalGraphics().SetPipeline(material.DoubleSided ? VisibilityDoubleSidedPipeline : VisibilityPipeline);
+			GlobalGraphics().SetRootConstants(&rootConstants);
+			GlobalGraphics().SetConstantBuffer("Scene"_view, SceneBufferResources[GlobalDevice().GetFrameIndex()]);
 
-				GlobalGraphics().SetVertexBuffer(0,
-				{
-					.Resource = SceneVertexBuffer.Resource,
-					.Size = primitive.PositionSize,
-					.Stride = primitive.PositionStride,
-					.Offset = primitive.PositionOffset,
-				});
-				GlobalGraphics().SetVertexBuffer(1,
-				{
-					.Resource = SceneVertexBuffer.Resource,
-					.Size = primitive.TextureCoordinateSize,
-					.Stride = primitive.TextureCoordinateStride,
-					.Offset = primitive.TextureCoordinateOffset,
-				});
-				GlobalGraphics().SetVertexBuffer(2,
-				{
-					.Resource = SceneVertexBuffer.Resource,
-					.Size = primitive.NormalSize,
-					.Stride = primitive.NormalStride,
-					.Offset = primitive.NormalOffset,
-				});
-				GlobalGraphics().SetIndexBuffer(
-				{
-					.Resource = SceneVertexBuffer.Resource,
-					.Size = primitive.IndexSize,
-					.Stride = primitive.IndexStride,
-					.Offset = primitive.IndexOffset,
-				});
+			GlobalGraphics().SetIndexBuffer(
+			{
+				.Resource = SceneVertexBuffer.Resource,
+				.Size = primitive.IndexSize,
+				.Stride = primitive.IndexStride,
+				.Offset = primitive.IndexOffset,
+			});
 
-				GlobalGraphics().DrawIndexed(primitive.IndexSize / primitive.IndexStride);
-			}
+			GlobalGraphics().DrawIndexed(indexCount, drawGroup.DrawCallCount);
 		}
 	});
 
@@ -555,48 +598,171 @@ void Renderer::LoadScene(const GLTF::Scene& scene)
 
 	SceneTwoChannelNormalMaps = scene.TwoChannelNormalMaps;
 
-	VERIFY(scene.Buffers.GetCount() == 1, "GLTF file contains multiple buffers!");
-	const GLTF::Buffer& vertexBuffer = scene.Buffers[0];
+	// Every GLTF buffer a primitive reads from gets its own range of one vertex buffer, so the shaders keep addressing a
+	// single buffer. Buffers whose streams were all packed elsewhere are left out.
+	static constexpr usize bufferAlignment = 16;
+
+	Array<usize> bufferOffsets(scene.Buffers.GetCount(), RendererAllocator);
+	for (usize bufferIndex = 0; bufferIndex < scene.Buffers.GetCount(); ++bufferIndex)
+	{
+		bufferOffsets.Add(INDEX_NONE);
+	}
+	for (const GLTF::Primitive& primitive : scene.Primitives)
+	{
+		const usize accessors[] =
+		{
+			GLTF::GetAttribute(primitive, GLTF::AttributeType::Position),
+			GLTF::GetAttribute(primitive, GLTF::AttributeType::TexCoord0),
+			GLTF::GetAttribute(primitive, GLTF::AttributeType::Normal),
+			primitive.Indices,
+		};
+		for (const usize accessor : accessors)
+		{
+			bufferOffsets[GLTF::GetAccessorView(scene, accessor).Buffer] = 0;
+		}
+	}
+
+	usize vertexBufferSize = 0;
+	usize usedBufferCount = 0;
+	usize lastUsedBuffer = INDEX_NONE;
+	for (usize bufferIndex = 0; bufferIndex < scene.Buffers.GetCount(); ++bufferIndex)
+	{
+		if (bufferOffsets[bufferIndex] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		vertexBufferSize = NextMultipleOf(vertexBufferSize, bufferAlignment);
+		bufferOffsets[bufferIndex] = vertexBufferSize;
+		vertexBufferSize += scene.Buffers[bufferIndex].Size;
+
+		++usedBufferCount;
+		lastUsedBuffer = bufferIndex;
+	}
+	VERIFY(usedBufferCount > 0, "GLTF file contains no primitives!");
+	VERIFY(vertexBufferSize <= 0xFFFFFFFF, "GLTF buffers don't fit in 32-bit offsets!");
+
+	const uint8* vertexData = scene.Buffers[lastUsedBuffer].Data;
+	uint8* combinedVertexData = nullptr;
+	if (usedBufferCount > 1)
+	{
+		static constexpr usize copySize = MB(16);
+
+		combinedVertexData = static_cast<uint8*>(RendererAllocator->Allocate(vertexBufferSize));
+
+		Array<BufferCopy> copies(RendererAllocator);
+		for (usize bufferIndex = 0; bufferIndex < scene.Buffers.GetCount(); ++bufferIndex)
+		{
+			if (bufferOffsets[bufferIndex] == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const GLTF::Buffer& buffer = scene.Buffers[bufferIndex];
+			for (usize offset = 0; offset < buffer.Size; offset += copySize)
+			{
+				copies.Add(BufferCopy
+				{
+					.Source = buffer.Data + offset,
+					.Destination = combinedVertexData + bufferOffsets[bufferIndex] + offset,
+					.Size = Min(copySize, buffer.Size - offset),
+				});
+			}
+		}
+
+		// The buffers are mapped files, so copying them on the workers reads the files in parallel.
+		Jobs::ParallelFor(copies.GetCount(), CopyBuffer, copies.GetData());
+		vertexData = combinedVertexData;
+	}
 
-	GLTF::Buffer finalVertexBuffer = vertexBuffer;
 	SceneVertexBuffer = CreateReadBuffer(ResourceUploader::Lifetime::Scene,
-										 finalVertexBuffer.Size,
+										 vertexBufferSize,
 										 0,
 										 ResourceFlags::None,
 										 ViewType::ShaderResource,
-										 finalVertexBuffer.Data,
+										 vertexData,
 										 "Scene Vertex Buffer"_view);
 
 	ResourceUploader::Flush();
 
+	if (combinedVertexData)
+	{
+		RendererAllocator->Deallocate(combinedVertexData, vertexBufferSize);
+	}
+
+	Array<float32> decodedPositions(RendererAllocator);
+	Array<usize> decodedPositionOffsets(scene.Primitives.GetCount(), RendererAllocator);
+
+	// Primitives with the geometry of an earlier one take its acceleration structure, unless only one of them is
+	// opaque, as that is a flag of the geometry. Only primitives that build one have their positions decoded for it.
+	Array<usize> geometryPrimitives(scene.Primitives.GetCount(), RendererAllocator);
+	const auto isOpaque = [&scene](const GLTF::Primitive& primitive) -> bool
+	{
+		return scene.Materials[primitive.Material].AlphaMode == GLTF::AlphaMode::Opaque;
+	};
+
 	usize globalPrimitiveIndex = 0;
 	for (const GLTF::Mesh& mesh : scene.Meshes)
 	{
-		Array<Primitive> primitives(mesh.Primitives.GetCount(), RendererAllocator);
+		Array<Primitive> primitives(mesh.PrimitiveCount, RendererAllocator);
 
-		for (const GLTF::Primitive& primitive : mesh.Primitives)
+		for (usize primitiveIndex = mesh.FirstPrimitive; primitiveIndex < mesh.FirstPrimitive + mesh.PrimitiveCount; ++primitiveIndex)
 		{
-			const GLTF::AccessorView positionView = GLTF::GetAccessorView(scene, primitive.Attributes[GLTF::AttributeType::Position]);
-			const GLTF::AccessorView textureCoordinateView = GLTF::GetAccessorView(scene, primitive.Attributes[GLTF::AttributeType::TexCoord0]);
-			const GLTF::AccessorView normalView = GLTF::GetAccessorView(scene, primitive.Attributes[GLTF::AttributeType::Normal]);
+			const GLTF::Primitive& primitive = scene.Primitives[primitiveIndex];
+			const usize positionAccessor = GLTF::GetAttribute(primitive, GLTF::AttributeType::Position);
+			const usize textureCoordinateAccessor = GLTF::GetAttribute(primitive, GLTF::AttributeType::TexCoord0);
+			const usize normalAccessor = GLTF::GetAttribute(primitive, GLTF::AttributeType::Normal);
+
+			const GLTF::AccessorView positionView = GLTF::GetAccessorView(scene, positionAccessor);
+			const GLTF::AccessorView textureCoordinateView = GLTF::GetAccessorView(scene, textureCoordinateAccessor);
+			const GLTF::AccessorView normalView = GLTF::GetAccessorView(scene, normalAccessor);
 			const GLTF::AccessorView indexView = GLTF::GetAccessorView(scene, primitive.Indices);
 
+			// Attributes are fetched as whole words, which the 4-byte element alignment GLTF requires allows.
+			for (const GLTF::AccessorView& view : { positionView, textureCoordinateView, normalView })
+			{
+				VERIFY(view.Offset % 4 == 0 && view.Stride % 4 == 0, "GLTF vertex attribute isn't aligned to 4 bytes!");
+			}
+			// Index counts are taken from the size, which only divides evenly for tightly packed indices.
+			const GLTF::Accessor& indexAccessor = scene.Accessors[primitive.Indices];
+			VERIFY(indexView.Stride == GLTF::GetElementSize(indexAccessor.AccessorType, indexAccessor.ComponentType), "GLTF indices aren't tightly packed!");
+
+			// Primitives are stored mesh after mesh, so the global index of a primitive is its index in the scene.
+			const GLTF::Primitive& geometryPrimitive = scene.Primitives[primitive.Geometry];
+			const bool sharesAccelerationStructure = primitive.Geometry != primitiveIndex && isOpaque(geometryPrimitive) == isOpaque(primitive);
+			geometryPrimitives.Add(sharesAccelerationStructure ? primitive.Geometry : INDEX_NONE);
+
+			const HLSL::VertexFormat positionFormat = GetVertexFormat(scene.Accessors[positionAccessor]);
+			if (positionFormat == HLSL::VertexFormat::Float32 || sharesAccelerationStructure)
+			{
+				decodedPositionOffsets.Add(INDEX_NONE);
+			}
+			else
+			{
+				decodedPositionOffsets.Add(decodedPositions.GetDataSize());
+				DecodePositions(scene, positionAccessor, &decodedPositions);
+			}
+
 			primitives.Add(Primitive
 			{
 				.GlobalIndex = globalPrimitiveIndex,
 				.MaterialIndex = primitive.Material,
-				.PositionOffset = positionView.Offset,
+				.PositionOffset = bufferOffsets[positionView.Buffer] + positionView.Offset,
 				.PositionStride = positionView.Stride,
 				.PositionSize = positionView.Size,
-				.TextureCoordinateOffset = textureCoordinateView.Offset,
+				.PositionFormat = positionFormat,
+				.TextureCoordinateOffset = bufferOffsets[textureCoordinateView.Buffer] + textureCoordinateView.Offset,
 				.TextureCoordinateStride = textureCoordinateView.Stride,
 				.TextureCoordinateSize = textureCoordinateView.Size,
-				.NormalOffset = normalView.Offset,
+				.TextureCoordinateFormat = GetVertexFormat(scene.Accessors[textureCoordinateAccessor]),
+				.NormalOffset = bufferOffsets[normalView.Buffer] + normalView.Offset,
 				.NormalStride = normalView.Stride,
 				.NormalSize = normalView.Size,
-				.IndexOffset = indexView.Offset,
+				.NormalFormat = GetVertexFormat(scene.Accessors[normalAccessor]),
+				.IndexOffset = bufferOffsets[indexView.Buffer] + indexView.Offset,
 				.IndexStride = indexView.Stride,
 				.IndexSize = indexView.Size,
+				.Bounds = ToBounds(primitive.Bounds),
 				.AccelerationStructureResource = {},
 			});
 			++globalPrimitiveIndex;
@@ -618,10 +784,13 @@ void Renderer::LoadScene(const GLTF::Scene& scene)
 				.MaterialIndex = static_cast<uint32>(primitive.MaterialIndex),
 				.PositionOffset = static_cast<uint32>(primitive.PositionOffset),
 				.PositionStride = static_cast<uint32>(primitive.PositionStride),
+				.PositionFormat = primitive.PositionFormat,
 				.TextureCoordinateOffset = static_cast<uint32>(primitive.TextureCoordinateOffset),
 				.TextureCoordinateStride = static_cast<uint32>(primitive.TextureCoordinateStride),
+				.TextureCoordinateFormat = primitive.TextureCoordinateFormat,
 				.NormalOffset = static_cast<uint32>(primitive.NormalOffset),
 				.NormalStride = static_cast<uint32>(primitive.NormalStride),
+				.NormalFormat = primitive.NormalFormat,
 				.IndexOffset = static_cast<uint32>(primitive.IndexOffset),
 				.IndexStride = static_cast<uint32>(primitive.IndexStride),
 			});
@@ -637,23 +806,70 @@ void Renderer::LoadScene(const GLTF::Scene& scene)
 
 	Array<Resource> transientResources(RendererAllocator);
 
+	Resource decodedPositionResource = {};
+	if (!decodedPositions.IsEmpty())
+	{
+		decodedPositionResource = ResourceUploader::Upload(ResourceUploader::Lifetime::Scene, decodedPositions.GetData(),
+		{
+			.Type = ResourceType::Buffer,
+			.Flags = ResourceFlags::None,
+			.InitialLayout = BarrierLayout::Undefined,
+			.Size = decodedPositions.GetDataSize(),
+			.DebugName = "Scene Decoded Position Buffer"_view,
+		});
+		ResourceUploader::Flush();
+
+		transientResources.Add(decodedPositionResource);
+	}
+
 	GlobalGraphics().Begin();
 
+	Array<usize> primitiveAccelerationStructures(scene.Primitives.GetCount(), RendererAllocator);
+	usize sharedAccelerationStructureCount = 0;
+	usize sharedAccelerationStructureSize = 0;
+
 	for (Mesh& mesh : SceneMeshes)
 	{
 		for (Primitive& primitive : mesh.Primitives)
 		{
+			const usize geometryPrimitive = geometryPrimitives[primitive.GlobalIndex];
+			if (geometryPrimitive != INDEX_NONE)
+			{
+				const usize accelerationStructureIndex = primitiveAccelerationStructures[geometryPrimitive];
+				primitive.AccelerationStructureResource = ScenePrimitiveAccelerationStructureResources[accelerationStructureIndex];
+				primitiveAccelerationStructures.Add(accelerationStructureIndex);
+
+				++sharedAccelerationStructureCount;
+				sharedAccelerationStructureSize += primitive.AccelerationStructureResource.Size;
+				continue;
+			}
+
 			const GLTF::AlphaMode alphaMode = scene.Materials[primitive.MaterialIndex].AlphaMode;
 
-			const RayTracingAccelerationStructureTriangleGeometry geometry =
+			SubBuffer vertexBuffer =
+			{
+				.Resource = SceneVertexBuffer.Resource,
+				.Size = primitive.PositionSize,
+				.Stride = primitive.PositionStride,
+				.Offset = primitive.PositionOffset,
+			};
+			const usize decodedPositionOffset = decodedPositionOffsets[primitive.GlobalIndex];
+			if (decodedPositionOffset != INDEX_NONE)
 			{
-				.VertexBuffer = SubBuffer
+				static constexpr usize decodedPositionStride = 3 * sizeof(float32);
+
+				vertexBuffer = SubBuffer
 				{
-					.Resource = SceneVertexBuffer.Resource,
-					.Size = primitive.PositionSize,
-					.Stride = primitive.PositionStride,
-					.Offset = primitive.PositionOffset,
-				},
+					.Resource = decodedPositionResource,
+					.Size = GetVertexCount(scene, primitive) * decodedPositionStride,
+					.Stride = decodedPositionStride,
+					.Offset = decodedPositionOffset,
+				};
+			}
+
+			const RayTracingAccelerationStructureTriangleGeometry geometry =
+			{
+				.VertexBuffer = vertexBuffer,
 				.IndexBuffer = SubBuffer
 				{
 					.Resource = SceneVertexBuffer.Resource,
@@ -688,14 +904,22 @@ void Renderer::LoadScene(const GLTF::Scene& scene)
 			GlobalGraphics().BuildRayTracingAccelerationStructure(geometry, scratchResource, resultResource);
 
 			primitive.AccelerationStructureResource = resultResource;
+			primitiveAccelerationStructures.Add(ScenePrimitiveAccelerationStructureResources.GetCount());
+			ScenePrimitiveAccelerationStructureResources.Add(resultResource);
 		}
 	}
 
+	Platform::LogFormatted("Renderer::LoadScene: Built %zu primitive acceleration structures, sharing %zu (%zu KB)\n",
+						   ScenePrimitiveAccelerationStructureResources.GetCount(),
+						   sharedAccelerationStructureCount,
+						   sharedAccelerationStructureSize / 1024);
+
 	GlobalGraphics().GlobalBarrier({ BarrierStage::BuildRayTracingAccelerationStructure, BarrierStage::BuildRayTracingAccelerationStructure },
 								   { BarrierAccess::RayTracingAccelerationStructureWrite, BarrierAccess::RayTracingAccelerationStructureRead });
 
+	// Every placement of a mesh gets a node of its own, so a GLTF node with EXT_mesh_gpu_instancing gives one for each
+	// of its instances.
 	Array<RayTracingAccelerationStructureInstance> instances(RendererAllocator);
-	Array<HLSL::DrawCall> drawCallData(RendererAllocator);
 	for (usize nodeIndex = 0; nodeIndex < scene.Nodes.GetCount(); ++nodeIndex)
 	{
 		const GLTF::Node& node = scene.Nodes[nodeIndex];
@@ -704,31 +928,92 @@ void Renderer::LoadScene(const GLTF::Scene& scene)
 			continue;
 		}
 
-		const Matrix localToWorld = GLTF::CalculateLocalToWorld(scene, nodeIndex);
-
-		const Mesh& mesh = SceneMeshes[node.Mesh];
-		for (const Primitive& primitive : mesh.Primitives)
+		const bool instanced = node.InstanceCount > 0;
+		const usize placementCount = instanced ? node.InstanceCount : 1;
+		for (usize placementIndex = 0; placementIndex < placementCount; ++placementIndex)
 		{
-			instances.Add(RayTracingAccelerationStructureInstance
+			const Matrix& localToWorld = instanced ? scene.InstanceLocalToWorlds[node.FirstInstance + placementIndex]
+												   : scene.NodeLocalToWorlds[nodeIndex];
+			const GLTF::Bounds& worldBounds = instanced ? scene.InstanceWorldBounds[node.FirstInstance + placementIndex]
+														: scene.NodeWorldBounds[nodeIndex];
+
+			const Mesh& mesh = SceneMeshes[node.Mesh];
+			for (const Primitive& primitive : mesh.Primitives)
+			{
+				instances.Add(RayTracingAccelerationStructureInstance
+				{
+					.ID = static_cast<uint32>(primitive.GlobalIndex),
+					.LocalToWorld = localToWorld,
+					.Resource = primitive.AccelerationStructureResource,
+				});
+			}
+
+			SceneNodes.Add(Node
 			{
-				.ID = static_cast<uint32>(primitive.GlobalIndex),
 				.LocalToWorld = localToWorld,
-				.Resource = primitive.AccelerationStructureResource,
+				.MeshIndex = node.Mesh,
+				.WorldBounds = ToBounds(worldBounds),
 			});
+		}
+	}
+
+	// The placements of each primitive are drawn together, so their draw calls are ordered by primitive, with the
+	// placements of one primitive in one run.
+	Array<usize> primitiveFirstDrawCalls(scene.Primitives.GetCount(), RendererAllocator);
+	for (usize primitiveIndex = 0; primitiveIndex < scene.Primitives.GetCount(); ++primitiveIndex)
+	{
+		primitiveFirstDrawCalls.Add(0);
+	}
+	for (const Node& node : SceneNodes)
+	{
+		for (const Primitive& primitive : SceneMeshes[node.MeshIndex].Primitives)
+		{
+			++primitiveFirstDrawCalls[primitive.GlobalIndex];
+		}
+	}
 
-			drawCallData.Add(HLSL::DrawCall
+	usize drawCallCount = 0;
+	for (usize meshIndex = 0; meshIndex < SceneMeshes.GetCount(); ++meshIndex)
+	{
+		const Mesh& mesh = SceneMeshes[meshIndex];
+		for (usize meshPrimitiveIndex = 0; meshPrimitiveIndex < mesh.Primitives.GetCount(); ++meshPrimitiveIndex)
+		{
+			const Primitive& primitive = mesh.Primitives[meshPrimitiveIndex];
+			const usize placementCount = primitiveFirstDrawCalls[primitive.GlobalIndex];
+			primitiveFirstDrawCalls[primitive.GlobalIndex] = drawCallCount;
+			if (placementCount == 0)
 			{
-				.NodeIndex = static_cast<uint32>(SceneNodes.GetCount()),
-				.PrimitiveIndex = static_cast<uint32>(primitive.GlobalIndex),
+				continue;
+			}
+			VERIFY(placementCount <= 0xFFFFFFFF, "GLTF primitive is placed too many times!");
+
+			SceneDrawGroups.Add(DrawGroup
+			{
+				.MeshIndex = meshIndex,
+				.MeshPrimitiveIndex = meshPrimitiveIndex,
+				.FirstDrawCall = drawCallCount,
+				.DrawCallCount = placementCount,
 			});
+			drawCallCount += placementCount;
 		}
+	}
 
-		SceneNodes.Add(Node
+	Array<HLSL::DrawCall> drawCallData(drawCallCount, RendererAllocator);
+	drawCallData.AddUninitialized(drawCallCount);
+	for (usize nodeIndex = 0; nodeIndex < SceneNodes.GetCount(); ++nodeIndex)
+	{
+		for (const Primitive& primitive : SceneMeshes[SceneNodes[nodeIndex].MeshIndex].Primitives)
 		{
-			.LocalToWorld = localToWorld,
-			.MeshIndex = node.Mesh,
-		});
+			drawCallData[primitiveFirstDrawCalls[primitive.GlobalIndex]++] = HLSL::DrawCall
+			{
+				.NodeIndex = static_cast<uint32>(nodeIndex),
+				.PrimitiveIndex = static_cast<uint32>(primitive.GlobalIndex),
+			};
+		}
 	}
+
+	Platform::LogFormatted("Renderer::LoadScene: Drawing %zu placements of primitives in %zu draws\n", drawCallCount, SceneDrawGroups.GetCount());
+
 	SceneDrawCallBuffer = CreateReadBuffer(ResourceUploader::Lifetime::Scene,
 										   drawCallData.GetDataSize(),
 										   drawCallData.GetElementSize(),
@@ -1006,12 +1291,9 @@ void Renderer::UnloadScene()
 	DestroyReadBuffer(&SceneDirectionalLightBuffer);
 	DestroyReadBuffer(&ScenePointLightsBuffer);
 
-	for (Mesh& mesh : SceneMeshes)
+	for (Resource& accelerationStructureResource : ScenePrimitiveAccelerationStructureResources)
 	{
-		for (Primitive& primitive : mesh.Primitives)
-		{
-			GlobalDevice().Destroy(&primitive.AccelerationStructureResource);
-		}
+		GlobalDevice().Destroy(&accelerationStructureResource);
 	}
 	GlobalDevice().Destroy(&SceneAccelerationStructureResource);
 	GlobalDevice().Destroy(&SceneAccelerationStructure);
@@ -1034,6 +1316,8 @@ void Renderer::UnloadScene()
 
 	SceneMeshes.Clear();
 	SceneNodes.Clear();
+	SceneDrawGroups.Clear();
+	ScenePrimitiveAccelerationStructureResources.Clear();
 	SceneMaterials.Clear();
 }
 
@@ -67,6 +67,7 @@ private:
 
 	Array<Mesh> SceneMeshes;
 	Array<Node> SceneNodes;
+	Array<DrawGroup> SceneDrawGroups;
 	Array<Material> SceneMaterials;
 	bool SceneTwoChannelNormalMaps;
 
@@ -102,6 +103,9 @@ private:
 	RHI::Resource SceneLuminanceBufferResource;
 	RHI::BufferView SceneLuminanceBufferView;
 
+	// One for each distinct primitive geometry, which the primitives sharing it all refer to.
+	Array<RHI::Resource> ScenePrimitiveAccelerationStructureResources;
+
 	RHI::Resource SceneAccelerationStructureResource;
 	RHI::RayTracingAccelerationStructure SceneAccelerationStructure;
 
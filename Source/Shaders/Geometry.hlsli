@@ -18,23 +18,78 @@ void LoadTriangleIndices(ByteAddressBuffer vertexBuffer, Primitive primitive, ui
 	}
 }
 
+// Reads up to three components of a vertex attribute, widening quantized components and scaling normalized ones the
+// way KHR_mesh_quantization describes. Elements start on 4 bytes and are padded to them, so whole words can be read.
+float32x3 LoadVertexAttribute(ByteAddressBuffer vertexBuffer, uint32 address, VertexFormat format, uint32 componentCount)
+{
+	if (format == VertexFormat::Float32)
+	{
+		return componentCount == 3 ? vertexBuffer.Load<float32x3>(address)
+								   : float32x3(vertexBuffer.Load<float32x2>(address), 0.0f);
+	}
+
+	const bool is8Bit = format == VertexFormat::Int8 || format == VertexFormat::UInt8 ||
+						format == VertexFormat::Int8Normalized || format == VertexFormat::UInt8Normalized;
+	const bool isSigned = format == VertexFormat::Int8 || format == VertexFormat::Int16 ||
+						  format == VertexFormat::Int8Normalized || format == VertexFormat::Int16Normalized;
+	const bool isNormalized = format == VertexFormat::Int8Normalized || format == VertexFormat::UInt8Normalized ||
+							  format == VertexFormat::Int16Normalized || format == VertexFormat::UInt16Normalized;
+	const uint32 bitCount = is8Bit ? 8 : 16;
+
+	uint32x3 bits;
+	if (is8Bit)
+	{
+		const uint32 word = vertexBuffer.Load(address);
+		bits = (word >> uint32x3(0, 8, 16)) & 0xFF;
+	}
+	else
+	{
+		const uint32x2 words = componentCount == 3 ? vertexBuffer.Load2(address) : uint32x2(vertexBuffer.Load(address), 0);
+		bits = uint32x3(words.x & 0xFFFF, words.x >> 16, words.y & 0xFFFF);
+	}
+
+	const uint32 unusedBitCount = 32 - bitCount;
+	float32x3 values = isSigned ? float32x3(asint(bits << unusedBitCount) >> unusedBitCount) : float32x3(bits);
+	if (isNormalized)
+	{
+		const float32 maximum = float32((1u << (isSigned ? bitCount - 1 : bitCount)) - 1);
+		values = max(values / maximum, -1.0f);
+	}
+	return values;
+}
+
+float32x3 LoadVertexPosition(ByteAddressBuffer vertexBuffer, Primitive primitive, uint32 index)
+{
+	return LoadVertexAttribute(vertexBuffer, primitive.PositionOffset + index * primitive.PositionStride, primitive.PositionFormat, 3);
+}
+
+float32x2 LoadVertexTextureCoordinate(ByteAddressBuffer vertexBuffer, Primitive primitive, uint32 index)
+{
+	return LoadVertexAttribute(vertexBuffer, primitive.TextureCoordinateOffset + index * primitive.TextureCoordinateStride, primitive.TextureCoordinateFormat, 2).xy;
+}
+
+float32x3 LoadVertexNormal(ByteAddressBuffer vertexBuffer, Primitive primitive, uint32 index)
+{
+	return LoadVertexAttribute(vertexBuffer, primitive.NormalOffset + index * primitive.NormalStride, primitive.NormalFormat, 3);
+}
+
 void LoadTrianglePositions(ByteAddressBuffer vertexBuffer, Primitive primitive, uint32 indices[3], out float32x3 positionsLS[3])
 {
-	positionsLS[0] = vertexBuffer.Load<float32x3>(primitive.PositionOffset + indices[0] * primitive.PositionStride);
-	positionsLS[1] = vertexBuffer.Load<float32x3>(primitive.PositionOffset + indices[1] * primitive.PositionStride);
-	positionsLS[2] = vertexBuffer.Load<float32x3>(primitive.PositionOffset + indices[2] * primitive.PositionStride);
+	positionsLS[0] = LoadVertexPosition(vertexBuffer, primitive, indices[0]);
+	positionsLS[1] = LoadVertexPosition(vertexBuffer, primitive, indices[1]);
+	positionsLS[2] = LoadVertexPosition(vertexBuffer, primitive, indices[2]);
 }
 
 void LoadTriangleTextureCoordinates(ByteAddressBuffer vertexBuffer, Primitive primitive, uint32 indices[3], out float32x2 textureCoordinates[3])
 {
-	textureCoordinates[0] = vertexBuffer.Load<float32x2>(primitive.TextureCoordinateOffset + indices[0] * primitive.TextureCoordinateStride);
-	textureCoordinates[1] = vertexBuffer.Load<float32x2>(primitive.TextureCoordinateOffset + indices[1] * primitive.TextureCoordinateStride);
-	textureCoordinates[2] = vertexBuffer.Load<float32x2>(primitive.TextureCoordinateOffset + indices[2] * primitive.TextureCoordinateStride);
+	textureCoordinates[0] = LoadVertexTextureCoordinate(vertexBuffer, primitive, indices[0]);
+	textureCoordinates[1] = LoadVertexTextureCoordinate(vertexBuffer, primitive, indices[1]);
+	textureCoordinates[2] = LoadVertexTextureCoordinate(vertexBuffer, primitive, indices[2]);
 }
 
 void LoadTriangleNormals(ByteAddressBuffer vertexBuffer, Primitive primitive, uint32 indices[3], out float32x3 normalsLS[3])
 {
-	normalsLS[0] = vertexBuffer.Load<float32x3>(primitive.NormalOffset + indices[0] * primitive.NormalStride);
-	normalsLS[1] = vertexBuffer.Load<float32x3>(primitive.NormalOffset + indices[1] * primitive.NormalStride);
-	normalsLS[2] = vertexBuffer.Load<float32x3>(primitive.NormalOffset + indices[2] * primitive.NormalStride);
+	normalsLS[0] = LoadVertexNormal(vertexBuffer, primitive, indices[0]);
+	normalsLS[1] = LoadVertexNormal(vertexBuffer, primitive, indices[1]);
+	normalsLS[2] = LoadVertexNormal(vertexBuffer, primitive, indices[2]);
 }
@@ -18,9 +18,8 @@ enum class ViewMode : uint32
 
 struct VisibilityRootConstants
 {
-	uint32 DrawCallIndex;
+	uint32 FirstDrawCallIndex;
 	uint32 PrimitiveIndex;
-	uint32 NodeIndex;
 
 	ViewMode ViewMode;
 };
@@ -99,18 +98,36 @@ struct Scene
 	PAD(12);
 };
 
+enum class VertexFormat : uint32
+{
+	Float32,
+
+	Int8,
+	UInt8,
+	Int16,
+	UInt16,
+
+	Int8Normalized,
+	UInt8Normalized,
+	Int16Normalized,
+	UInt16Normalized,
+};
+
 struct Primitive
 {
 	uint32 MaterialIndex;
 
 	uint32 PositionOffset;
 	uint32 PositionStride;
+	VertexFormat PositionFormat;
 
 	uint32 TextureCoordinateOffset;
 	uint32 TextureCoordinateStride;
+	VertexFormat TextureCoordinateFormat;
 
 	uint32 NormalOffset;
 	uint32 NormalStride;
+	VertexFormat NormalFormat;
 
 	uint32 IndexOffset;
 	uint32 IndexStride;
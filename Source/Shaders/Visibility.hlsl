@@ -1,30 +1,38 @@
+#include "Geometry.hlsli"
 #include "Samplers.hlsli"
 #include "Transform.hlsli"
 #include "Types.hlsli"
 
-struct VertexInput
-{
-	float32x3 PositionLS : POSITION0;
-	float32x2 UV : TEXCOORD0;
-};
-
 struct PixelInput
 {
 	float32x4 JitteredPositionCS : SV_POSITION;
 	float32x2 UV : TEXCOORD0;
+	nointerpolation uint32 DrawCallIndex : DRAW_CALL_INDEX;
 };
 
 ConstantBuffer<VisibilityRootConstants> RootConstants : register(b0);
 ConstantBuffer<Scene> Scene : register(b1);
 
-PixelInput VertexStart(VertexInput input)
+// Vertices are fetched by index rather than through input layouts, so quantized attributes are decoded the same way
+// as in every other pass. Placements of a primitive are drawn as instances, whose draw calls follow one another.
+PixelInput VertexStart(uint32 vertexIndex : SV_VertexID, uint32 instanceID : SV_InstanceID)
 {
+	const ByteAddressBuffer vertexBuffer = ResourceDescriptorHeap[Scene.VertexBufferIndex];
+	const StructuredBuffer<Primitive> primitiveBuffer = ResourceDescriptorHeap[Scene.PrimitiveBufferIndex];
 	const StructuredBuffer<Node> nodeBuffer = ResourceDescriptorHeap[Scene.NodeBufferIndex];
-	const Node node = nodeBuffer[RootConstants.NodeIndex];
+	const StructuredBuffer<DrawCall> drawCallBuffer = ResourceDescriptorHeap[Scene.DrawCallBufferIndex];
+
+	const Primitive primitive = primitiveBuffer[RootConstants.PrimitiveIndex];
+	const uint32 drawCallIndex = RootConstants.FirstDrawCallIndex + instanceID;
+
+	const Node node = nodeBuffer[drawCallBuffer[drawCallIndex].NodeIndex];
+
+	const float32x3 positionLS = LoadVertexPosition(vertexBuffer, primitive, vertexIndex);
 
 	PixelInput result;
-	result.JitteredPositionCS = TransformWorldToClip(TransformLocalPositionToWorld(input.PositionLS, node.LocalToWorld), Scene.JitteredWorldToClip);
-	result.UV = input.UV;
+	result.JitteredPositionCS = TransformWorldToClip(TransformLocalPositionToWorld(positionLS, node.LocalToWorld), Scene.JitteredWorldToClip);
+	result.UV = LoadVertexTextureCoordinate(vertexBuffer, primitive, vertexIndex);
+	result.DrawCallIndex = drawCallIndex;
 	return result;
 }
 
@@ -44,5 +52,5 @@ uint32x2 PixelStart(PixelInput input, uint32 primitiveID : SV_PrimitiveID) : SV_
 		discard;
 	}
 
-	return uint32x2(RootConstants.DrawCallIndex + 1, primitiveID + 1);
+	return uint32x2(input.DrawCallIndex + 1, primitiveID + 1);
 }
@@ -1,9 +1,12 @@
 #include "CameraController.hpp"
 #include "Editor.hpp"
+#include "Jobs.hpp"
 #include "Renderer.hpp"
 
 void Start()
 {
+	Jobs::Init(Jobs::GetDefaultWorkerCount());
+
 	Platform::Window* window = Platform::CreateWindow("Hummingbird"_view, 1920, 1080);
 
 	static bool needsResize = false;
@@ -65,4 +68,6 @@ void Start()
 	}
 
 	Platform::DestroyWindow(window);
+
+	Jobs::Shutdown();
 }
@@ -4,6 +4,7 @@
 #include "RenderContext.hpp"
 #include "ResourceUploader.hpp"
 
+#include "Luft/HashTable.hpp"
 #include "Luft/Sort.hpp"
 
 namespace HLSL
@@ -90,81 +91,209 @@ static BufferView DrawBufferViews[FramesInFlight] = {};
 
 static GraphicsPipeline Pipeline = GraphicsPipeline::Invalid();
 
-void Init()
+static const JSON::Value& ReadFontValue(JSON::Reader* reader)
 {
-	DDS::Image fontImage = DDS::LoadImage("Assets/UI/Fonts/RobotoMSDF.dds"_view);
-
-	const JSON::Object fontDescription = JSON::Load("Assets/UI/Fonts/RobotoMSDF.json"_view);
-
-	const JSON::Object& fontAtlasDescription = fontDescription["atlas"_view].GetObject();
-
-	const float64 distanceRange = fontAtlasDescription["distanceRange"_view].GetDecimal();
-	const uint32 width = static_cast<uint32>(fontAtlasDescription["width"_view].GetDecimal());
-	const uint32 height = static_cast<uint32>(fontAtlasDescription["height"_view].GetDecimal());
+	VERIFY(reader->NextToken() == JSON::Token::Value, "Unexpected JSON value type!");
+	return reader->GetValue();
+}
 
-	const JSON::Object& fontMetrics = fontDescription["metrics"_view].GetObject();
-	Font::Em = static_cast<float32>(fontMetrics["emSize"_view].GetDecimal());
-	Font::LineHeight = static_cast<float32>(fontMetrics["lineHeight"_view].GetDecimal());
-	Font::Ascender = static_cast<float32>(fontMetrics["ascender"_view].GetDecimal());
-	Font::Descender = static_cast<float32>(fontMetrics["descender"_view].GetDecimal());
+struct FontBounds
+{
+	float64 Left;
+	float64 Bottom;
+	float64 Right;
+	float64 Top;
+};
 
-	RootConstants.UnitRange.X = static_cast<float32>(distanceRange / width);
-	RootConstants.UnitRange.Y = static_cast<float32>(distanceRange / height);
+static FontBounds ReadFontBounds(JSON::Reader* reader)
+{
+	VERIFY(reader->NextToken() == JSON::Token::BeginObject, "Unexpected JSON value type!");
 
-	const JSON::Array& fontGlyphs = fontDescription["glyphs"_view].GetArray();
+	FontBounds bounds = {};
+	while (reader->NextToken() != JSON::Token::EndObject)
+	{
+		const StringView key = reader->GetKey();
+		if (key == "left"_view)
+		{
+			bounds.Left = ReadFontValue(reader).GetDecimal();
+		}
+		else if (key == "bottom"_view)
+		{
+			bounds.Bottom = ReadFontValue(reader).GetDecimal();
+		}
+		else if (key == "right"_view)
+		{
+			bounds.Right = ReadFontValue(reader).GetDecimal();
+		}
+		else if (key == "top"_view)
+		{
+			bounds.Top = ReadFontValue(reader).GetDecimal();
+		}
+		else
+		{
+			reader->SkipValue();
+		}
+	}
+	return bounds;
+}
 
-	for (const JSON::Value& glyphValue : fontGlyphs)
+// Expects the reader to have just entered the glyph object.
+static void ReadFontGlyph(JSON::Reader* reader, const DDS::Image& fontImage)
+{
+	usize unicode = INDEX_NONE;
+	float32 advance = 0.0f;
+	float32x2 atlasPosition = { 0.0f, 0.0f };
+	float32x2 atlasSize = { 0.0f, 0.0f };
+	float32x2 planePosition = { 0.0f, 0.0f };
+	float32x2 planeSize = { 0.0f, 0.0f };
+
+	while (reader->NextToken() != JSON::Token::EndObject)
 	{
-		const JSON::Object& glyphObject = glyphValue.GetObject();
+		const StringView key = reader->GetKey();
+		if (key == "unicode"_view)
+		{
+			unicode = ReadFontValue(reader).GetUnsigned();
+		}
+		else if (key == "advance"_view)
+		{
+			advance = static_cast<float32>(ReadFontValue(reader).GetDecimal());
+		}
+		else if (key == "atlasBounds"_view)
+		{
+			const FontBounds atlasBounds = ReadFontBounds(reader);
 
-		const float32 advance = static_cast<float32>(glyphObject["advance"_view].GetDecimal());
-		float32x2 atlasPosition = { 0.0f, 0.0f };
-		float32x2 atlasSize = { 0.0f, 0.0f };
-		float32x2 planePosition = { 0.0f, 0.0f };
-		float32x2 planeSize = { 0.0f, 0.0f };
+			atlasPosition.X = static_cast<float32>(atlasBounds.Left) / static_cast<float32>(fontImage.Width);
+			atlasPosition.Y = static_cast<float32>(atlasBounds.Top) / static_cast<float32>(fontImage.Height);
 
-		if (glyphObject.HasKey("atlasBounds"_view))
+			atlasSize.X = static_cast<float32>(atlasBounds.Right - atlasBounds.Left) / static_cast<float32>(fontImage.Width);
+			atlasSize.Y = static_cast<float32>(atlasBounds.Bottom - atlasBounds.Top) / static_cast<float32>(fontImage.Height);
+		}
+		else if (key == "planeBounds"_view)
 		{
-			const JSON::Object& atlasBounds = glyphObject["atlasBounds"_view].GetObject();
+			const FontBounds planeBounds = ReadFontBounds(reader);
 
-			const float64 left = atlasBounds["left"_view].GetDecimal();
-			const float64 bottom = atlasBounds["bottom"_view].GetDecimal();
-			const float64 right = atlasBounds["right"_view].GetDecimal();
-			const float64 top = atlasBounds["top"_view].GetDecimal();
+			planePosition.X = static_cast<float32>(planeBounds.Left);
+			planePosition.Y = static_cast<float32>(planeBounds.Top);
 
-			atlasPosition.X = static_cast<float32>(left) / static_cast<float32>(fontImage.Width);
-			atlasPosition.Y = static_cast<float32>(top) / static_cast<float32>(fontImage.Height);
-
-			atlasSize.X = static_cast<float32>(right - left) / static_cast<float32>(fontImage.Width);
-			atlasSize.Y = static_cast<float32>(bottom - top) / static_cast<float32>(fontImage.Height);
+			planeSize.X = static_cast<float32>(planeBounds.Right - planeBounds.Left);
+			planeSize.Y = static_cast<float32>(planeBounds.Bottom - planeBounds.Top);
 		}
-
-		if (glyphObject.HasKey("planeBounds"_view))
+		else
 		{
-			const JSON::Object& planeBounds = glyphObject["planeBounds"_view].GetObject();
+			reader->SkipValue();
+		}
+	}
+	VERIFY(unicode != INDEX_NONE, "Key not present in JSON object!");
 
-			const float64 left = planeBounds["left"_view].GetDecimal();
-			const float64 bottom = planeBounds["bottom"_view].GetDecimal();
-			const float64 right = planeBounds["right"_view].GetDecimal();
-			const float64 top = planeBounds["top"_view].GetDecimal();
+	const char codepoint = static_cast<char>(unicode);
+	Font::Glyphs.Add(codepoint, Font::Glyph
+	{
+		.AtlasPosition = atlasPosition,
+		.AtlasSize = atlasSize,
+		.PlanePosition = planePosition,
+		.PlaneSize = planeSize,
+		.Advance = advance,
+	});
+}
 
-			planePosition.X = static_cast<float32>(left);
-			planePosition.Y = static_cast<float32>(top);
+void Init()
+{
+	DDS::Image fontImage = DDS::LoadImage("Assets/UI/Fonts/RobotoMSDF.dds"_view);
 
-			planeSize.X = static_cast<float32>(right - left);
-			planeSize.Y = static_cast<float32>(bottom - top);
-		}
+	Arena fontStorage(MB(1), Allocator);
+	JSON::Reader fontReader("Assets/UI/Fonts/RobotoMSDF.json"_view, &fontStorage);
+
+	float64 distanceRange = 0.0;
+	uint32 width = 0;
+	uint32 height = 0;
 
-		const char codepoint = static_cast<char>(glyphObject["unicode"_view].GetDecimal());
-		Font::Glyphs.Add(codepoint, Font::Glyph
+	bool hasDistanceRange = false;
+	bool hasEmSize = false;
+	bool hasLineHeight = false;
+	bool hasAscender = false;
+	bool hasDescender = false;
+
+	VERIFY(fontReader.NextToken() == JSON::Token::BeginObject, "Unexpected JSON value type!");
+	while (fontReader.NextToken() != JSON::Token::EndObject)
+	{
+		const StringView key = fontReader.GetKey();
+		if (key == "atlas"_view)
 		{
-			.AtlasPosition = atlasPosition,
-			.AtlasSize = atlasSize,
-			.PlanePosition = planePosition,
-			.PlaneSize = planeSize,
-			.Advance = advance,
-		});
+			VERIFY(fontReader.NextToken() == JSON::Token::BeginObject, "Unexpected JSON value type!");
+			while (fontReader.NextToken() != JSON::Token::EndObject)
+			{
+				const StringView atlasKey = fontReader.GetKey();
+				if (atlasKey == "distanceRange"_view)
+				{
+					distanceRange = ReadFontValue(&fontReader).GetDecimal();
+					hasDistanceRange = true;
+				}
+				else if (atlasKey == "width"_view)
+				{
+					width = static_cast<uint32>(ReadFontValue(&fontReader).GetUnsigned());
+				}
+				else if (atlasKey == "height"_view)
+				{
+					height = static_cast<uint32>(ReadFontValue(&fontReader).GetUnsigned());
+				}
+				else
+				{
+					fontReader.SkipValue();
+				}
+			}
+		}
+		else if (key == "metrics"_view)
+		{
+			VERIFY(fontReader.NextToken() == JSON::Token::BeginObject, "Unexpected JSON value type!");
+			while (fontReader.NextToken() != JSON::Token::EndObject)
+			{
+				const StringView metricsKey = fontReader.GetKey();
+				if (metricsKey == "emSize"_view)
+				{
+					Font::Em = static_cast<float32>(ReadFontValue(&fontReader).GetDecimal());
+					hasEmSize = true;
+				}
+				else if (metricsKey == "lineHeight"_view)
+				{
+					Font::LineHeight = static_cast<float32>(ReadFontValue(&fontReader).GetDecimal());
+					hasLineHeight = true;
+				}
+				else if (metricsKey == "ascender"_view)
+				{
+					Font::Ascender = static_cast<float32>(ReadFontValue(&fontReader).GetDecimal());
+					hasAscender = true;
+				}
+				else if (metricsKey == "descender"_view)
+				{
+					Font::Descender = static_cast<float32>(ReadFontValue(&fontReader).GetDecimal());
+					hasDescender = true;
+				}
+				else
+				{
+					fontReader.SkipValue();
+				}
+			}
+		}
+		else if (key == "glyphs"_view)
+		{
+			VERIFY(fontReader.NextToken() == JSON::Token::BeginArray, "Unexpected JSON value type!");
+			for (JSON::Token token = fontReader.NextToken(); token != JSON::Token::EndArray; token = fontReader.NextToken())
+			{
+				VERIFY(token == JSON::Token::BeginObject, "Unexpected JSON value type!");
+				ReadFontGlyph(&fontReader, fontImage);
+			}
+		}
+		else
+		{
+			fontReader.SkipValue();
+		}
 	}
+	VERIFY(width != 0 && height != 0, "Font atlas is missing its dimensions!");
+	VERIFY(hasDistanceRange, "Font atlas is missing its distance range!");
+	VERIFY(hasEmSize && hasLineHeight && hasAscender && hasDescender, "Font is missing its metrics!");
+
+	RootConstants.UnitRange.X = static_cast<float32>(distanceRange / width);
+	RootConstants.UnitRange.Y = static_cast<float32>(distanceRange / height);
 
 	Font::Resource = ResourceUploader::Upload(ResourceUploader::Lifetime::Persistent, fontImage.Data,
 	{
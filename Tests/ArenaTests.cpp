@@ -0,0 +1,167 @@
+#include "Arena.hpp"
+#include "Test.hpp"
+
+// Passes allocations through to the global allocator and counts the ones still live.
+class CountingAllocator : public Allocator
+{
+public:
+	void* Allocate(usize size) override
+	{
+		++LiveCount;
+		return GlobalAllocator::Get().Allocate(size);
+	}
+
+	void Deallocate(void* data, usize size) override
+	{
+		CHECK(LiveCount != 0);
+		--LiveCount;
+		GlobalAllocator::Get().Deallocate(data, size);
+	}
+
+	usize LiveCount = 0;
+};
+
+static constexpr usize TestBlockSize = 4096;
+
+static void AllocationsAreAlignedAndCounted()
+{
+	CountingAllocator parent;
+	Arena arena(TestBlockSize, &parent);
+
+	usize expectedUsedSize = 0;
+	for (usize size = 1; size <= 100; ++size)
+	{
+		const uint8* data = static_cast<uint8*>(arena.Allocate(size));
+		VERIFY(reinterpret_cast<usize>(data) % 16 == 0, "Arena allocation is misaligned!");
+		expectedUsedSize += NextMultipleOf(size, static_cast<usize>(16));
+	}
+
+	VERIFY(arena.GetAllocationCount() == 100, "Arena miscounted its allocations!");
+	VERIFY(arena.GetUsedSize() == expectedUsedSize, "Arena miscounted its used size!");
+	VERIFY(arena.GetBlockCount() == parent.LiveCount, "Arena miscounted its blocks!");
+}
+
+static void AllocationsDontOverlap()
+{
+	Arena arena(TestBlockSize);
+
+	static constexpr usize allocationCount = 1000;
+	static constexpr usize allocationSize = 40;
+
+	uint8* allocations[allocationCount];
+	for (usize allocationIndex = 0; allocationIndex < allocationCount; ++allocationIndex)
+	{
+		allocations[allocationIndex] = static_cast<uint8*>(arena.Allocate(allocationSize));
+		Platform::MemorySet(allocations[allocationIndex], static_cast<uint8>(allocationIndex), allocationSize);
+	}
+
+	for (usize allocationIndex = 0; allocationIndex < allocationCount; ++allocationIndex)
+	{
+		for (usize byteIndex = 0; byteIndex < allocationSize; ++byteIndex)
+		{
+			VERIFY(allocations[allocationIndex][byteIndex] == static_cast<uint8>(allocationIndex), "Arena allocations overlap!");
+		}
+	}
+}
+
+static void LargeAllocationsGetTheirOwnBlock()
+{
+	CountingAllocator parent;
+	Arena arena(TestBlockSize, &parent);
+
+	arena.Allocate(16);
+	uint8* large = static_cast<uint8*>(arena.Allocate(TestBlockSize * 4));
+	Platform::MemorySet(large, 0xAB, TestBlockSize * 4);
+
+	VERIFY(arena.GetBlockCount() == 2 && parent.LiveCount == 2, "Arena didn't add a block for a large allocation!");
+}
+
+static void ResetFreesEveryBlockAtOnce()
+{
+	CountingAllocator parent;
+	{
+		Arena arena(TestBlockSize, &parent);
+		for (usize allocationIndex = 0; allocationIndex < 10000; ++allocationIndex)
+		{
+			arena.Allocate(24);
+		}
+		VERIFY(parent.LiveCount == arena.GetBlockCount() && parent.LiveCount > 1, "Arena miscounted its blocks!");
+
+		arena.Reset();
+		VERIFY(parent.LiveCount == 0, "Arena reset didn't free every block!");
+		VERIFY(arena.GetAllocationCount() == 0 && arena.GetBlockCount() == 0 && arena.GetUsedSize() == 0, "Arena reset didn't clear its counts!");
+
+		arena.Allocate(24);
+	}
+	VERIFY(parent.LiveCount == 0, "Arena destructor didn't free every block!");
+}
+
+static void MovesHandOverBlocks()
+{
+	CountingAllocator parent;
+	{
+		Arena arena(TestBlockSize, &parent);
+		uint32* value = static_cast<uint32*>(arena.Allocate(sizeof(uint32)));
+		*value = 0xC0FFEE;
+
+		Arena moved(Move(arena));
+		VERIFY(arena.GetBlockCount() == 0 && moved.GetBlockCount() == 1, "Arena move didn't hand over its blocks!");
+		VERIFY(*value == 0xC0FFEE, "Arena move touched its allocations!");
+
+		Arena assigned(TestBlockSize, &parent);
+		assigned.Allocate(16);
+		assigned = Move(moved);
+		VERIFY(parent.LiveCount == 1, "Arena move assignment didn't free the blocks it replaced!");
+		VERIFY(assigned.GetAllocationCount() == 1, "Arena move assignment didn't take over the counts!");
+	}
+	VERIFY(parent.LiveCount == 0, "Moved arenas leaked a block!");
+}
+
+static void AdoptKeepsAllocationsAlive()
+{
+	CountingAllocator parent;
+	{
+		Arena arena(TestBlockSize, &parent);
+		arena.Allocate(16);
+
+		uint32* adopted[100];
+		{
+			Arena other(TestBlockSize, &parent);
+			for (usize allocationIndex = 0; allocationIndex < ARRAY_COUNT(adopted); ++allocationIndex)
+			{
+				adopted[allocationIndex] = static_cast<uint32*>(other.Allocate(256));
+				*adopted[allocationIndex] = static_cast<uint32>(allocationIndex);
+			}
+
+			const usize blockCount = arena.GetBlockCount() + other.GetBlockCount();
+			arena.Adopt(&other);
+			VERIFY(arena.GetBlockCount() == blockCount && other.GetBlockCount() == 0, "Arena didn't adopt every block!");
+			VERIFY(arena.GetAllocationCount() == ARRAY_COUNT(adopted) + 1, "Arena didn't adopt the allocation count!");
+		}
+		VERIFY(parent.LiveCount == arena.GetBlockCount(), "Adopted blocks were freed with their old arena!");
+
+		// The current block stays on top, so it is still allocated from.
+		arena.Allocate(16);
+		VERIFY(parent.LiveCount == arena.GetBlockCount(), "Arena added a block after adopting!");
+
+		for (usize allocationIndex = 0; allocationIndex < ARRAY_COUNT(adopted); ++allocationIndex)
+		{
+			VERIFY(*adopted[allocationIndex] == allocationIndex, "Adopted allocation was overwritten!");
+		}
+	}
+	VERIFY(parent.LiveCount == 0, "Adopted blocks leaked!");
+}
+
+void RunArenaTests()
+{
+	static constexpr Test tests[] =
+	{
+		{ "Allocations are aligned and counted", AllocationsAreAlignedAndCounted },
+		{ "Allocations don't overlap", AllocationsDontOverlap },
+		{ "Large allocations get their own block", LargeAllocationsGetTheirOwnBlock },
+		{ "Reset frees every block at once", ResetFreesEveryBlockAtOnce },
+		{ "Moves hand over blocks", MovesHandOverBlocks },
+		{ "Adopt keeps allocations alive", AdoptKeepsAllocationsAlive },
+	};
+	RunTests("Arena", tests);
+}
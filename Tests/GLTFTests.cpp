@@ -0,0 +1,1644 @@
+#include "GLTF.hpp"
+#include "JSON.hpp"
+#include "Test.hpp"
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static Allocator* Allocator = &GlobalAllocator::Get();
+
+static constexpr usize UnsignedByteComponentType = 5121;
+static constexpr usize ShortComponentType = 5122;
+static constexpr usize UnsignedShortComponentType = 5123;
+static constexpr usize FloatComponentType = 5126;
+
+// One accessor of the test buffer, each with a buffer view of its own.
+struct TestAccessor
+{
+	usize Offset;
+	usize Size;
+	usize Stride;
+	usize Count;
+	usize ComponentType;
+	StringView Type;
+	bool Normalized;
+
+	bool HasMinMax;
+	float32 Min[3];
+	float32 Max[3];
+
+	// The accessor whose view this one reads through, which is itself unless its elements are interleaved with those of
+	// another, and where its elements start in that view.
+	usize View;
+	usize ViewOffset;
+};
+
+// A primitive of one of the test meshes, which leaves out the attributes it has no accessor for.
+struct TestPrimitive
+{
+	usize Positions;
+	usize Indices;
+	usize Normals = INDEX_NONE;
+	usize TexCoords = INDEX_NONE;
+};
+
+struct TestMesh
+{
+	usize FirstPrimitive;
+	usize PrimitiveCount;
+};
+
+// Everything but the nodes and scenes of a test manifest, and the files it is written to. Each test names its scene, so
+// that the files of one never stand in for those of another.
+struct TestScene
+{
+	char ManifestPath[512];
+	char BufferPath[512];
+	char BinaryPath[512];
+	char BufferUri[128];
+
+	Array<uint8> Buffer;
+	Array<TestAccessor> Accessors;
+	Array<TestPrimitive> Primitives;
+	Array<TestMesh> Meshes;
+};
+
+static const char* GetTemporaryDirectory()
+{
+	const char* directory = getenv("TMPDIR");
+	if (!directory)
+	{
+		directory = getenv("TEMP");
+	}
+	// The loader resolves buffers against the directory of the manifest, so the path needs one even when it is the
+	// current directory.
+	return directory ? directory : ".";
+}
+
+static TestScene MakeTestScene(const char* name)
+{
+	TestScene scene =
+	{
+		.Buffer = Array<uint8>(Allocator),
+		.Accessors = Array<TestAccessor>(Allocator),
+		.Primitives = Array<TestPrimitive>(Allocator),
+		.Meshes = Array<TestMesh>(Allocator),
+	};
+	const char* directory = GetTemporaryDirectory();
+	Platform::StringPrint("%s/GLTFTests_%s.gltf", scene.ManifestPath, sizeof(scene.ManifestPath), directory, name);
+	Platform::StringPrint("%s/GLTFTests_%s.bin", scene.BufferPath, sizeof(scene.BufferPath), directory, name);
+	Platform::StringPrint("%s/GLTFTests_%s.glb", scene.BinaryPath, sizeof(scene.BinaryPath), directory, name);
+	Platform::StringPrint("GLTFTests_%s.bin", scene.BufferUri, sizeof(scene.BufferUri), name);
+	return scene;
+}
+
+// Views start on four bytes, as every component type needs.
+static usize AddBufferData(TestScene* scene, usize size)
+{
+	while (scene->Buffer.GetCount() % 4 != 0)
+	{
+		scene->Buffer.Add(0);
+	}
+	const usize offset = scene->Buffer.GetCount();
+	scene->Buffer.AddUninitialized(size);
+	Platform::MemorySet(scene->Buffer.GetData() + offset, 0, size);
+	return offset;
+}
+
+// Writes the positions apart by the stride, where a stride wider than a position leaves zeroes between them.
+template<usize PositionCount>
+static usize AddPositions(TestScene* scene, const float32 (&positions)[PositionCount][3], usize stride, bool hasMinMax)
+{
+	static constexpr usize positionSize = sizeof(positions[0]);
+	CHECK(stride >= positionSize && stride % 4 == 0);
+
+	const usize size = (PositionCount - 1) * stride + positionSize;
+	const usize offset = AddBufferData(scene, size);
+
+	TestAccessor accessor =
+	{
+		.Offset = offset,
+		.Size = size,
+		.Stride = stride == positionSize ? 0 : stride,
+		.Count = PositionCount,
+		.ComponentType = FloatComponentType,
+		.Type = "VEC3"_view,
+		.Normalized = false,
+		.HasMinMax = hasMinMax,
+		.Min = { FLT_MAX, FLT_MAX, FLT_MAX },
+		.Max = { -FLT_MAX, -FLT_MAX, -FLT_MAX },
+		.View = scene->Accessors.GetCount(),
+		.ViewOffset = 0,
+	};
+	for (usize positionIndex = 0; positionIndex < PositionCount; ++positionIndex)
+	{
+		Platform::MemoryCopy(scene->Buffer.GetData() + offset + positionIndex * stride, positions[positionIndex], positionSize);
+		for (usize componentIndex = 0; componentIndex < 3; ++componentIndex)
+		{
+			accessor.Min[componentIndex] = Min(accessor.Min[componentIndex], positions[positionIndex][componentIndex]);
+			accessor.Max[componentIndex] = Max(accessor.Max[componentIndex], positions[positionIndex][componentIndex]);
+		}
+	}
+
+	scene->Accessors.Add(accessor);
+	return scene->Accessors.GetCount() - 1;
+}
+
+// Writes quaternions tightly packed, as the rotations of mesh instances.
+template<usize RotationCount>
+static usize AddRotations(TestScene* scene, const float32 (&rotations)[RotationCount][4])
+{
+	const usize offset = AddBufferData(scene, sizeof(rotations));
+	Platform::MemoryCopy(scene->Buffer.GetData() + offset, rotations, sizeof(rotations));
+
+	scene->Accessors.Add(TestAccessor
+	{
+		.Offset = offset,
+		.Size = sizeof(rotations),
+		.Stride = 0,
+		.Count = RotationCount,
+		.ComponentType = FloatComponentType,
+		.Type = "VEC4"_view,
+		.Normalized = false,
+		.HasMinMax = false,
+		.Min = {},
+		.Max = {},
+		.View = scene->Accessors.GetCount(),
+		.ViewOffset = 0,
+	});
+	return scene->Accessors.GetCount() - 1;
+}
+
+// Writes integer positions with each padded to four bytes, as vertex attributes have to be. Bounds are given in the
+// stored integers, as the file gives them.
+template<typename T, usize PositionCount>
+static usize AddQuantizedPositions(TestScene* scene, const T (&positions)[PositionCount][3], usize componentType, bool normalized, bool hasMinMax)
+{
+	static constexpr usize positionSize = sizeof(positions[0]);
+	static constexpr usize stride = (positionSize + 3) & ~static_cast<usize>(3);
+
+	const usize size = (PositionCount - 1) * stride + positionSize;
+	const usize offset = AddBufferData(scene, size);
+
+	TestAccessor accessor =
+	{
+		.Offset = offset,
+		.Size = size,
+		.Stride = stride == positionSize ? 0 : stride,
+		.Count = PositionCount,
+		.ComponentType = componentType,
+		.Type = "VEC3"_view,
+		.Normalized = normalized,
+		.HasMinMax = hasMinMax,
+		.Min = { FLT_MAX, FLT_MAX, FLT_MAX },
+		.Max = { -FLT_MAX, -FLT_MAX, -FLT_MAX },
+		.View = scene->Accessors.GetCount(),
+		.ViewOffset = 0,
+	};
+	for (usize positionIndex = 0; positionIndex < PositionCount; ++positionIndex)
+	{
+		Platform::MemoryCopy(scene->Buffer.GetData() + offset + positionIndex * stride, positions[positionIndex], positionSize);
+		for (usize componentIndex = 0; componentIndex < 3; ++componentIndex)
+		{
+			accessor.Min[componentIndex] = Min(accessor.Min[componentIndex], static_cast<float32>(positions[positionIndex][componentIndex]));
+			accessor.Max[componentIndex] = Max(accessor.Max[componentIndex], static_cast<float32>(positions[positionIndex][componentIndex]));
+		}
+	}
+
+	scene->Accessors.Add(accessor);
+	return scene->Accessors.GetCount() - 1;
+}
+
+template<usize IndexCount>
+static usize AddIndices(TestScene* scene, const uint16 (&indices)[IndexCount])
+{
+	const usize offset = AddBufferData(scene, sizeof(indices));
+	Platform::MemoryCopy(scene->Buffer.GetData() + offset, indices, sizeof(indices));
+
+	scene->Accessors.Add(TestAccessor
+	{
+		.Offset = offset,
+		.Size = sizeof(indices),
+		.Stride = 0,
+		.Count = IndexCount,
+		.ComponentType = UnsignedShortComponentType,
+		.Type = "SCALAR"_view,
+		.Normalized = false,
+		.HasMinMax = false,
+		.Min = {},
+		.Max = {},
+		.View = scene->Accessors.GetCount(),
+		.ViewOffset = 0,
+	});
+	return scene->Accessors.GetCount() - 1;
+}
+
+// Writes each position with its normal right after it, and reads both through the view of the positions. The normals
+// still get a view of their own, which nothing reads.
+template<usize VertexCount>
+static void AddInterleavedPositionsAndNormals(TestScene* scene,
+											  const float32 (&positions)[VertexCount][3],
+											  const float32 (&normals)[VertexCount][3],
+											  usize* positionAccessor,
+											  usize* normalAccessor)
+{
+	static constexpr usize elementSize = sizeof(positions[0]);
+	static constexpr usize stride = elementSize * 2;
+
+	const usize size = VertexCount * stride;
+	const usize offset = AddBufferData(scene, size);
+	for (usize vertexIndex = 0; vertexIndex < VertexCount; ++vertexIndex)
+	{
+		Platform::MemoryCopy(scene->Buffer.GetData() + offset + vertexIndex * stride, positions[vertexIndex], elementSize);
+		Platform::MemoryCopy(scene->Buffer.GetData() + offset + vertexIndex * stride + elementSize, normals[vertexIndex], elementSize);
+	}
+
+	TestAccessor positionAccessorData =
+	{
+		.Offset = offset,
+		.Size = size,
+		.Stride = stride,
+		.Count = VertexCount,
+		.ComponentType = FloatComponentType,
+		.Type = "VEC3"_view,
+		.Normalized = false,
+		.HasMinMax = true,
+		.Min = { FLT_MAX, FLT_MAX, FLT_MAX },
+		.Max = { -FLT_MAX, -FLT_MAX, -FLT_MAX },
+		.View = scene->Accessors.GetCount(),
+		.ViewOffset = 0,
+	};
+	for (usize vertexIndex = 0; vertexIndex < VertexCount; ++vertexIndex)
+	{
+		for (usize componentIndex = 0; componentIndex < 3; ++componentIndex)
+		{
+			positionAccessorData.Min[componentIndex] = Min(positionAccessorData.Min[componentIndex], positions[vertexIndex][componentIndex]);
+			positionAccessorData.Max[componentIndex] = Max(positionAccessorData.Max[componentIndex], positions[vertexIndex][componentIndex]);
+		}
+	}
+	*positionAccessor = scene->Accessors.GetCount();
+	scene->Accessors.Add(positionAccessorData);
+
+	*normalAccessor = scene->Accessors.GetCount();
+	scene->Accessors.Add(TestAccessor
+	{
+		.Offset = offset + elementSize,
+		.Size = size - elementSize,
+		.Stride = stride,
+		.Count = VertexCount,
+		.ComponentType = FloatComponentType,
+		.Type = "VEC3"_view,
+		.Normalized = false,
+		.HasMinMax = false,
+		.Min = {},
+		.Max = {},
+		.View = *positionAccessor,
+		.ViewOffset = elementSize,
+	});
+}
+
+static usize AddMesh(TestScene* scene, const TestPrimitive* primitives, usize primitiveCount)
+{
+	scene->Meshes.Add(TestMesh
+	{
+		.FirstPrimitive = scene->Primitives.GetCount(),
+		.PrimitiveCount = primitiveCount,
+	});
+	for (usize primitiveIndex = 0; primitiveIndex < primitiveCount; ++primitiveIndex)
+	{
+		scene->Primitives.Add(primitives[primitiveIndex]);
+	}
+	return scene->Meshes.GetCount() - 1;
+}
+
+static usize AddMesh(TestScene* scene, usize positionAccessor, usize indexAccessor)
+{
+	const TestPrimitive primitive =
+	{
+		.Positions = positionAccessor,
+		.Indices = indexAccessor,
+	};
+	return AddMesh(scene, &primitive, 1);
+}
+
+static void WriteFile(const char* filePath, const void* data, usize size)
+{
+	FILE* file = fopen(filePath, "wb");
+	VERIFY(file, "Failed to open test file!");
+	VERIFY(fwrite(data, 1, size, file) == size, "Failed to write test file!");
+	fclose(file);
+}
+
+static void WriteFloats(JSON::Writer* manifest, const float32 (&values)[3])
+{
+	manifest->BeginArray();
+	for (const float32 value : values)
+	{
+		manifest->WriteDecimal(value);
+	}
+	manifest->EndArray();
+}
+
+static void WriteAttribute(JSON::Writer* manifest, StringView name, usize accessor)
+{
+	if (accessor == INDEX_NONE)
+	{
+		return;
+	}
+	manifest->WriteKey(name);
+	manifest->WriteInteger(static_cast<int64>(accessor));
+}
+
+// Writes the meshes, buffer, views and accessors of the scene, and a material for the primitives to use. Each accessor
+// has a view of its own. An embedded buffer has no URI, as the BIN chunk of a GLB file.
+static void WriteTestScene(JSON::Writer* manifest, const TestScene& testScene, bool embedsBuffer)
+{
+	manifest->WriteKey("meshes"_view);
+	manifest->BeginArray();
+	for (const TestMesh& mesh : testScene.Meshes)
+	{
+		manifest->BeginObject();
+		manifest->WriteKey("primitives"_view);
+		manifest->BeginArray();
+		for (usize primitiveIndex = mesh.FirstPrimitive; primitiveIndex < mesh.FirstPrimitive + mesh.PrimitiveCount; ++primitiveIndex)
+		{
+			const TestPrimitive& primitive = testScene.Primitives[primitiveIndex];
+			manifest->BeginObject();
+			manifest->WriteKey("attributes"_view);
+			manifest->BeginObject();
+			WriteAttribute(manifest, "POSITION"_view, primitive.Positions);
+			WriteAttribute(manifest, "NORMAL"_view, primitive.Normals);
+			WriteAttribute(manifest, "TEXCOORD_0"_view, primitive.TexCoords);
+			manifest->EndObject();
+			manifest->WriteKey("indices"_view);
+			manifest->WriteInteger(static_cast<int64>(primitive.Indices));
+			manifest->WriteKey("material"_view);
+			manifest->WriteInteger(0);
+			manifest->EndObject();
+		}
+		manifest->EndArray();
+		manifest->EndObject();
+	}
+	manifest->EndArray();
+
+	manifest->WriteKey("materials"_view);
+	manifest->BeginArray();
+	manifest->BeginObject();
+	manifest->EndObject();
+	manifest->EndArray();
+
+	manifest->WriteKey("buffers"_view);
+	manifest->BeginArray();
+	manifest->BeginObject();
+	if (!embedsBuffer)
+	{
+		manifest->WriteKey("uri"_view);
+		manifest->WriteString(StringView(testScene.BufferUri, Platform::StringLength(testScene.BufferUri)));
+	}
+	manifest->WriteKey("byteLength"_view);
+	manifest->WriteInteger(static_cast<int64>(testScene.Buffer.GetCount()));
+	manifest->EndObject();
+	manifest->EndArray();
+
+	manifest->WriteKey("bufferViews"_view);
+	manifest->BeginArray();
+	for (const TestAccessor& accessor : testScene.Accessors)
+	{
+		manifest->BeginObject();
+		manifest->WriteKey("buffer"_view);
+		manifest->WriteInteger(0);
+		manifest->WriteKey("byteOffset"_view);
+		manifest->WriteInteger(static_cast<int64>(accessor.Offset));
+		manifest->WriteKey("byteLength"_view);
+		manifest->WriteInteger(static_cast<int64>(accessor.Size));
+		if (accessor.Stride)
+		{
+			manifest->WriteKey("byteStride"_view);
+			manifest->WriteInteger(static_cast<int64>(accessor.Stride));
+		}
+		manifest->EndObject();
+	}
+	manifest->EndArray();
+
+	manifest->WriteKey("accessors"_view);
+	manifest->BeginArray();
+	for (usize accessorIndex = 0; accessorIndex < testScene.Accessors.GetCount(); ++accessorIndex)
+	{
+		const TestAccessor& accessor = testScene.Accessors[accessorIndex];
+		manifest->BeginObject();
+		manifest->WriteKey("bufferView"_view);
+		manifest->WriteInteger(static_cast<int64>(accessor.View));
+		if (accessor.ViewOffset)
+		{
+			manifest->WriteKey("byteOffset"_view);
+			manifest->WriteInteger(static_cast<int64>(accessor.ViewOffset));
+		}
+		manifest->WriteKey("componentType"_view);
+		manifest->WriteInteger(static_cast<int64>(accessor.ComponentType));
+		manifest->WriteKey("count"_view);
+		manifest->WriteInteger(static_cast<int64>(accessor.Count));
+		manifest->WriteKey("type"_view);
+		manifest->WriteString(accessor.Type);
+		if (accessor.Normalized)
+		{
+			manifest->WriteKey("normalized"_view);
+			manifest->WriteBoolean(true);
+		}
+		if (accessor.HasMinMax)
+		{
+			manifest->WriteKey("min"_view);
+			WriteFloats(manifest, accessor.Min);
+			manifest->WriteKey("max"_view);
+			WriteFloats(manifest, accessor.Max);
+		}
+		manifest->EndObject();
+	}
+	manifest->EndArray();
+}
+
+// The members of the given object, such as the scenes and nodes, are copied into the manifest ahead of what the test
+// scene holds.
+static void WriteManifest(JSON::Writer* manifest, const TestScene& testScene, StringView members, bool embedsBuffer)
+{
+	const JSON::Document document = JSON::Parse(members);
+
+	manifest->BeginObject();
+	manifest->WriteKey("asset"_view);
+	manifest->BeginObject();
+	manifest->WriteKey("version"_view);
+	manifest->WriteString("2.0"_view);
+	manifest->EndObject();
+	for (const JSON::Member& member : document.GetRoot())
+	{
+		manifest->WriteKey(member.GetName());
+		manifest->WriteValue(member.Value);
+	}
+	WriteTestScene(manifest, testScene, embedsBuffer);
+	manifest->EndObject();
+}
+
+// Writes the manifest and buffer of the scene and loads them.
+static GLTF::Scene LoadTestScene(const TestScene& testScene, StringView members, GLTF::VertexLayout vertexLayout = GLTF::VertexLayout::AsStored)
+{
+	JSON::Writer manifest;
+	WriteManifest(&manifest, testScene, members, false);
+
+	const StringView manifestText = manifest.GetText();
+	WriteFile(testScene.ManifestPath, manifestText.GetData(), manifestText.GetLength());
+	WriteFile(testScene.BufferPath, testScene.Buffer.GetData(), testScene.Buffer.GetCount());
+
+	return GLTF::LoadScene(StringView(testScene.ManifestPath, Platform::StringLength(testScene.ManifestPath)), vertexLayout);
+}
+
+// Ways of breaking a GLB file that the loader has to catch before reading past the end of it.
+enum class BinaryFileDamage : uint8
+{
+	None,
+	LongJSONChunk,
+	LongBinaryChunk,
+	NoBinaryChunk,
+};
+
+static void AddUInt32(Array<uint8>* file, uint32 value)
+{
+	const usize offset = file->GetCount();
+	file->AddUninitialized(sizeof(value));
+	Platform::MemoryCopy(file->GetData() + offset, &value, sizeof(value));
+}
+
+// Adds a chunk padded to four bytes with the given byte, with the padding counted in its length as the format asks.
+static void AddChunk(Array<uint8>* file, uint32 type, const void* data, usize size, uint8 padding)
+{
+	const usize paddedSize = (size + 3) & ~static_cast<usize>(3);
+	AddUInt32(file, static_cast<uint32>(paddedSize));
+	AddUInt32(file, type);
+
+	const usize offset = file->GetCount();
+	file->AddUninitialized(paddedSize);
+	Platform::MemoryCopy(file->GetData() + offset, data, size);
+	Platform::MemorySet(file->GetData() + offset + size, padding, paddedSize - size);
+}
+
+// Writes the scene as a GLB file, with its buffer in the BIN chunk, and loads it.
+static GLTF::Scene LoadBinaryTestScene(const TestScene& testScene, StringView members, BinaryFileDamage damage = BinaryFileDamage::None)
+{
+	static constexpr uint32 magic = 0x46546C67;
+	static constexpr uint32 version = 2;
+	static constexpr uint32 jsonChunkType = 0x4E4F534A;
+	static constexpr uint32 binaryChunkType = 0x004E4942;
+	static constexpr usize headerSize = 12;
+
+	JSON::Writer manifest;
+	WriteManifest(&manifest, testScene, members, true);
+	const StringView manifestText = manifest.GetText();
+
+	Array<uint8> file(Allocator);
+	AddUInt32(&file, magic);
+	AddUInt32(&file, version);
+	AddUInt32(&file, 0);
+	AddChunk(&file, jsonChunkType, manifestText.GetData(), manifestText.GetLength(), ' ');
+	const usize binaryChunkHeaderStart = file.GetCount();
+	if (damage != BinaryFileDamage::NoBinaryChunk)
+	{
+		AddChunk(&file, binaryChunkType, testScene.Buffer.GetData(), testScene.Buffer.GetCount(), 0);
+	}
+
+	// The lengths are bent after the fact, so that the container still ends where the file does.
+	const uint32 fileSize = static_cast<uint32>(file.GetCount());
+	Platform::MemoryCopy(file.GetData() + 8, &fileSize, sizeof(fileSize));
+	if (damage == BinaryFileDamage::LongJSONChunk)
+	{
+		const uint32 jsonChunkSize = fileSize;
+		Platform::MemoryCopy(file.GetData() + headerSize, &jsonChunkSize, sizeof(jsonChunkSize));
+	}
+	if (damage == BinaryFileDamage::LongBinaryChunk)
+	{
+		const uint32 binaryChunkSize = static_cast<uint32>(testScene.Buffer.GetCount() + 64);
+		Platform::MemoryCopy(file.GetData() + binaryChunkHeaderStart, &binaryChunkSize, sizeof(binaryChunkSize));
+	}
+	WriteFile(testScene.BinaryPath, file.GetData(), file.GetCount());
+
+	return GLTF::LoadScene(StringView(testScene.BinaryPath, Platform::StringLength(testScene.BinaryPath)), GLTF::VertexLayout::AsStored);
+}
+
+static void RemoveTestScene(const TestScene& testScene)
+{
+	remove(testScene.ManifestPath);
+	remove(testScene.BufferPath);
+	remove(testScene.BinaryPath);
+}
+
+static void UnloadTestScene(const TestScene& testScene, GLTF::Scene* scene)
+{
+	GLTF::UnloadScene(scene);
+
+	// The buffer is mapped until the scene is unloaded, and some platforms keep mapped files from being removed.
+	RemoveTestScene(testScene);
+}
+
+// Formats the members that LoadTestScene takes, for nodes that need numbers in them.
+template<typename... Arguments>
+static String FormatMembers(const char* format, Arguments... arguments)
+{
+	char members[1024];
+	Platform::StringPrint(format, members, sizeof(members), arguments...);
+
+	String result(sizeof(members), Allocator);
+	result.Append(StringView(members, Platform::StringLength(members)));
+	return result;
+}
+
+// A triangle moved along X, so that triangles made with different offsets never share their data.
+static void MakeTriangle(float32 offset, float32 (&positions)[3][3])
+{
+	static constexpr float32 triangle[3][3] =
+	{
+		{ 0.0f, 0.0f, 0.0f },
+		{ 1.0f, 0.0f, 0.0f },
+		{ 0.0f, 1.0f, 0.0f },
+	};
+	for (usize positionIndex = 0; positionIndex < 3; ++positionIndex)
+	{
+		positions[positionIndex][0] = triangle[positionIndex][0] + offset;
+		positions[positionIndex][1] = triangle[positionIndex][1];
+		positions[positionIndex][2] = triangle[positionIndex][2];
+	}
+}
+
+static constexpr uint16 TriangleIndices[] = { 0, 1, 2 };
+
+static void LinksChildrenInOneRunPerNode()
+{
+	TestScene testScene = MakeTestScene("LinksChildren");
+	float32 positions[3][3];
+	MakeTriangle(0.0f, positions);
+	AddMesh(&testScene, AddPositions(&testScene, positions, sizeof(positions[0]), true), AddIndices(&testScene, TriangleIndices));
+
+	GLTF::Scene scene = LoadTestScene(testScene, R"({
+		"scenes": [{ "nodes": [0, 5] }],
+		"nodes": [
+			{ "children": [1, 2, 4] },
+			{ "mesh": 0 },
+			{ "children": [3] },
+			{ "mesh": 0 },
+			{},
+			{ "mesh": 0 }
+		]
+	})"_view);
+
+	VERIFY(scene.TopLevelNodes.GetCount() == 2 && scene.TopLevelNodes[0] == 0 && scene.TopLevelNodes[1] == 5, "Unexpected GLTF top level nodes!");
+	VERIFY(scene.Nodes.GetCount() == 6, "Unexpected GLTF node count!");
+	VERIFY(scene.ChildNodes.GetCount() == 4, "GLTF child lists aren't packed together!");
+
+	static constexpr usize expectedChildren[][3] =
+	{
+		{ 1, 2, 4 },
+		{},
+		{ 3 },
+		{},
+		{},
+		{},
+	};
+	static constexpr usize expectedChildCounts[] = { 3, 0, 1, 0, 0, 0 };
+	static constexpr usize expectedParents[] = { INDEX_NONE, 0, 0, 2, 0, INDEX_NONE };
+	for (usize nodeIndex = 0; nodeIndex < scene.Nodes.GetCount(); ++nodeIndex)
+	{
+		const GLTF::Node& node = scene.Nodes[nodeIndex];
+		VERIFY(node.Parent == expectedParents[nodeIndex], "Unexpected GLTF node parent!");
+		VERIFY(node.ChildNodeCount == expectedChildCounts[nodeIndex], "Unexpected GLTF child count!");
+		VERIFY(node.ChildNodeCount == 0 || node.FirstChildNode + node.ChildNodeCount <= scene.ChildNodes.GetCount(), "GLTF child run is out of bounds!");
+		for (usize childIndex = 0; childIndex < node.ChildNodeCount; ++childIndex)
+		{
+			VERIFY(scene.ChildNodes[node.FirstChildNode + childIndex] == expectedChildren[nodeIndex][childIndex], "Unexpected GLTF child node!");
+		}
+	}
+
+	UnloadTestScene(testScene, &scene);
+}
+
+static void KeepsThePrimitivesOfEachMeshInOneRun()
+{
+	static constexpr usize meshPrimitiveCounts[] = { 2, 1, 3 };
+
+	TestScene testScene = MakeTestScene("KeepsPrimitiveRuns");
+
+	usize primitiveIndex = 0;
+	for (usize meshIndex = 0; meshIndex < ARRAY_COUNT(meshPrimitiveCounts); ++meshIndex)
+	{
+		TestPrimitive primitives[3];
+		CHECK(meshPrimitiveCounts[meshIndex] <= ARRAY_COUNT(primitives));
+		for (usize meshPrimitiveIndex = 0; meshPrimitiveIndex < meshPrimitiveCounts[meshIndex]; ++meshPrimitiveIndex)
+		{
+			float32 positions[3][3];
+			MakeTriangle(static_cast<float32>(primitiveIndex), positions);
+			primitives[meshPrimitiveIndex] =
+			{
+				.Positions = AddPositions(&testScene, positions, sizeof(positions[0]), true),
+				.Indices = AddIndices(&testScene, TriangleIndices),
+			};
+			CHECK(primitives[meshPrimitiveIndex].Positions == primitiveIndex * 2 && primitives[meshPrimitiveIndex].Indices == primitiveIndex * 2 + 1);
+			++primitiveIndex;
+		}
+		AddMesh(&testScene, primitives, meshPrimitiveCounts[meshIndex]);
+	}
+
+	GLTF::Scene scene = LoadTestScene(testScene, R"({ "nodes": [{ "mesh": 0 }, { "mesh": 1 }, { "mesh": 2 }] })"_view);
+
+	VERIFY(scene.Meshes.GetCount() == ARRAY_COUNT(meshPrimitiveCounts), "Unexpected GLTF mesh count!");
+	VERIFY(scene.Primitives.GetCount() == primitiveIndex, "Unexpected GLTF primitive count!");
+
+	usize expectedFirstPrimitive = 0;
+	for (usize meshIndex = 0; meshIndex < ARRAY_COUNT(meshPrimitiveCounts); ++meshIndex)
+	{
+		const GLTF::Mesh& mesh = scene.Meshes[meshIndex];
+		VERIFY(mesh.FirstPrimitive == expectedFirstPrimitive && mesh.PrimitiveCount == meshPrimitiveCounts[meshIndex], "Unexpected GLTF primitive run!");
+		expectedFirstPrimitive += mesh.PrimitiveCount;
+	}
+
+	for (usize index = 0; index < scene.Primitives.GetCount(); ++index)
+	{
+		const GLTF::Primitive& primitive = scene.Primitives[index];
+		VERIFY(GLTF::GetAttribute(primitive, GLTF::AttributeType::Position) == index * 2, "Unexpected GLTF primitive positions!");
+		// Every triangle has the same indices, which are merged into the first of them.
+		VERIFY(primitive.Indices == 1, "Unexpected GLTF primitive indices!");
+		VERIFY(primitive.Material == 0, "Unexpected GLTF primitive material!");
+	}
+
+	UnloadTestScene(testScene, &scene);
+}
+
+// Loads a scene of two nodes and meshes and one of many, in both layouts. The storage takes one allocation per array
+// however many elements the arrays hold.
+static void StoresScenesInFewAllocations()
+{
+	static constexpr usize largeNodeCount = 500;
+	static constexpr GLTF::VertexLayout vertexLayouts[] = { GLTF::VertexLayout::AsStored, GLTF::VertexLayout::Packed };
+
+	for (const GLTF::VertexLayout vertexLayout : vertexLayouts)
+	{
+		usize allocationCounts[2];
+		usize blockCounts[2];
+
+		const usize nodeCounts[] = { 2, largeNodeCount };
+		for (usize sizeIndex = 0; sizeIndex < ARRAY_COUNT(nodeCounts); ++sizeIndex)
+		{
+			const usize nodeCount = nodeCounts[sizeIndex];
+			TestScene testScene = MakeTestScene("FewAllocations");
+			String members(16 * 1024, Allocator);
+
+			// The first node holds every other one.
+			members.Append(R"({ "nodes": [{ "mesh": 0, "children": [)"_view);
+			for (usize nodeIndex = 1; nodeIndex < nodeCount; ++nodeIndex)
+			{
+				char child[32];
+				Platform::StringPrint("%s%zu", child, sizeof(child), nodeIndex == 1 ? "" : ", ", nodeIndex);
+				members.Append(StringView(child, Platform::StringLength(child)));
+			}
+			members.Append("] }"_view);
+			for (usize nodeIndex = 1; nodeIndex < nodeCount; ++nodeIndex)
+			{
+				char node[64];
+				Platform::StringPrint(R"(, { "mesh": %zu })", node, sizeof(node), nodeIndex);
+				members.Append(StringView(node, Platform::StringLength(node)));
+			}
+
+			members.Append("] }"_view);
+
+			for (usize meshIndex = 0; meshIndex < nodeCount; ++meshIndex)
+			{
+				float32 positions[3][3];
+				MakeTriangle(static_cast<float32>(meshIndex), positions);
+				AddMesh(&testScene, AddPositions(&testScene, positions, sizeof(positions[0]), true), AddIndices(&testScene, TriangleIndices));
+			}
+
+			GLTF::Scene scene = LoadTestScene(testScene, members, vertexLayout);
+			VERIFY(scene.Nodes.GetCount() == nodeCount && scene.Meshes.GetCount() == nodeCount, "Unexpected GLTF node count!");
+			VERIFY(scene.Nodes[0].ChildNodeCount == nodeCount - 1, "Unexpected GLTF child count!");
+
+			allocationCounts[sizeIndex] = scene.Storage->GetAllocationCount();
+			blockCounts[sizeIndex] = scene.Storage->GetBlockCount();
+			UnloadTestScene(testScene, &scene);
+		}
+
+		VERIFY(allocationCounts[0] == allocationCounts[1], "GLTF scene allocations grow with its element count!");
+		VERIFY(blockCounts[0] == 1 && blockCounts[1] == 1, "Small GLTF scenes take more than one storage block!");
+	}
+}
+
+static void UnloadingLetsGoOfEverything()
+{
+	TestScene testScene = MakeTestScene("Unloading");
+	float32 positions[3][3];
+	MakeTriangle(0.0f, positions);
+	AddMesh(&testScene, AddPositions(&testScene, positions, sizeof(positions[0]), true), AddIndices(&testScene, TriangleIndices));
+
+	GLTF::Scene scene = LoadTestScene(testScene, R"({ "nodes": [{ "mesh": 0 }] })"_view);
+	VERIFY(scene.Storage && scene.Buffers.GetCount() == 1 && scene.Buffers[0].MappedFile, "GLTF buffer wasn't mapped!");
+
+	UnloadTestScene(testScene, &scene);
+	VERIFY(!scene.Storage, "GLTF scene storage outlived the scene!");
+	VERIFY(scene.Nodes.IsEmpty() && scene.ChildNodes.IsEmpty() && scene.NodeLocalToWorlds.IsEmpty() && scene.NodeWorldBounds.IsEmpty(),
+		   "GLTF node arrays outlived the scene!");
+	VERIFY(scene.Buffers.IsEmpty() && scene.BufferViews.IsEmpty() && scene.Accessors.IsEmpty(), "GLTF buffer arrays outlived the scene!");
+	VERIFY(scene.Meshes.IsEmpty() && scene.Primitives.IsEmpty() && scene.Materials.IsEmpty(), "GLTF mesh arrays outlived the scene!");
+}
+
+// Points of a box from (-1, -2, -3) to (4, 5, 6), with some inside it, in three orders.
+static constexpr float32 BoxPositions[][3] =
+{
+	{ 0.0f, 0.0f, 0.0f },
+	{ -1.0f, 5.0f, 0.5f },
+	{ 4.0f, -2.0f, 1.0f },
+	{ 1.0f, 1.0f, -3.0f },
+	{ 2.0f, 3.0f, 6.0f },
+	{ 0.25f, -0.5f, 2.0f },
+};
+static constexpr float32 ReversedBoxPositions[][3] =
+{
+	{ 0.25f, -0.5f, 2.0f },
+	{ 2.0f, 3.0f, 6.0f },
+	{ 1.0f, 1.0f, -3.0f },
+	{ 4.0f, -2.0f, 1.0f },
+	{ -1.0f, 5.0f, 0.5f },
+	{ 0.0f, 0.0f, 0.0f },
+};
+static constexpr float32 RotatedBoxPositions[][3] =
+{
+	{ -1.0f, 5.0f, 0.5f },
+	{ 4.0f, -2.0f, 1.0f },
+	{ 1.0f, 1.0f, -3.0f },
+	{ 2.0f, 3.0f, 6.0f },
+	{ 0.25f, -0.5f, 2.0f },
+	{ 0.0f, 0.0f, 0.0f },
+};
+static constexpr float32x3 BoxMin = { -1.0f, -2.0f, -3.0f };
+static constexpr float32x3 BoxMax = { 4.0f, 5.0f, 6.0f };
+
+static bool IsNear(float32 a, float32 b)
+{
+	return fabsf(a - b) <= 1.0e-5f * Max(1.0f, fabsf(b));
+}
+
+static bool IsNear(float32x3 a, float32x3 b)
+{
+	return IsNear(a.X, b.X) && IsNear(a.Y, b.Y) && IsNear(a.Z, b.Z);
+}
+
+static bool IsNear(const Matrix& a, const Matrix& b)
+{
+	const float32* aValues = &a.M00;
+	const float32* bValues = &b.M00;
+	for (usize index = 0; index < 16; ++index)
+	{
+		if (fabsf(aValues[index] - bValues[index]) > 1.0e-5f * Max(1.0f, fabsf(bValues[index])))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Checks the box and the sphere around it, which has the center of the box and reaches its corners.
+static void VerifyBounds(const GLTF::Bounds& bounds, float32x3 minimum, float32x3 maximum)
+{
+	const float32x3 center = { (minimum.X + maximum.X) * 0.5f, (minimum.Y + maximum.Y) * 0.5f, (minimum.Z + maximum.Z) * 0.5f };
+	const float32x3 extent = { maximum.X - minimum.X, maximum.Y - minimum.Y, maximum.Z - minimum.Z };
+	const float32 radius = sqrtf(extent.X * extent.X + extent.Y * extent.Y + extent.Z * extent.Z) * 0.5f;
+
+	VERIFY(IsNear(bounds.Min, minimum) && IsNear(bounds.Max, maximum), "Unexpected GLTF bounds box!");
+	VERIFY(IsNear(bounds.Center, center) && IsNear(bounds.Radius, radius), "Unexpected GLTF bounds sphere!");
+}
+
+static void VerifyEmptyBounds(const GLTF::Bounds& bounds)
+{
+	VERIFY(bounds.Radius < 0.0f, "GLTF bounds of nothing have a radius!");
+	VERIFY(bounds.Min.X > bounds.Max.X && bounds.Min.Y > bounds.Max.Y && bounds.Min.Z > bounds.Max.Z, "GLTF bounds of nothing hold something!");
+}
+
+// The same points are given with their bounds, without them, and without them and apart, and each order is its own
+// stream so that none of them are merged.
+static void BoundsPrimitivesWithAndWithoutMinMax()
+{
+	static constexpr usize paddedStride = 20;
+
+	TestScene testScene = MakeTestScene("BoundsPrimitives");
+	const usize givenAccessor = AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), true);
+	const usize readAccessor = AddPositions(&testScene, ReversedBoxPositions, sizeof(ReversedBoxPositions[0]), false);
+	const usize readApartAccessor = AddPositions(&testScene, RotatedBoxPositions, paddedStride, false);
+	const usize indexAccessor = AddIndices(&testScene, TriangleIndices);
+
+	const TestPrimitive primitives[] =
+	{
+		{ .Positions = givenAccessor, .Indices = indexAccessor },
+		{ .Positions = readAccessor, .Indices = indexAccessor },
+		{ .Positions = readApartAccessor, .Indices = indexAccessor },
+	};
+	AddMesh(&testScene, primitives, ARRAY_COUNT(primitives));
+
+	GLTF::Scene scene = LoadTestScene(testScene, R"({ "nodes": [{ "mesh": 0 }] })"_view);
+
+	VERIFY(scene.Accessors[givenAccessor].HasMinMax, "GLTF accessor lost its bounds!");
+	VERIFY(!scene.Accessors[readAccessor].HasMinMax && !scene.Accessors[readApartAccessor].HasMinMax, "GLTF accessor gained bounds!");
+	VERIFY(scene.Primitives.GetCount() == 3, "Unexpected GLTF primitive count!");
+	for (const GLTF::Primitive& primitive : scene.Primitives)
+	{
+		VerifyBounds(primitive.Bounds, BoxMin, BoxMax);
+	}
+
+	UnloadTestScene(testScene, &scene);
+}
+
+// Bounds the file gives are taken as they are, so wider ones than the points need show through.
+static void TakesTheMinMaxOfTheFile()
+{
+	static constexpr float32x3 givenMin = { -10.0f, -20.0f, -30.0f };
+	static constexpr float32x3 givenMax = { 40.0f, 50.0f, 60.0f };
+
+	TestScene testScene = MakeTestScene("TakesMinMax");
+	const usize positionAccessor = AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), true);
+	AddMesh(&testScene, positionAccessor, AddIndices(&testScene, TriangleIndices));
+
+	TestAccessor& accessor = testScene.Accessors[positionAccessor];
+	accessor.Min[0] = givenMin.X;
+	accessor.Min[1] = givenMin.Y;
+	accessor.Min[2] = givenMin.Z;
+	accessor.Max[0] = givenMax.X;
+	accessor.Max[1] = givenMax.Y;
+	accessor.Max[2] = givenMax.Z;
+
+	GLTF::Scene scene = LoadTestScene(testScene, R"({ "nodes": [{ "mesh": 0 }] })"_view);
+
+	VerifyBounds(scene.Primitives[0].Bounds, givenMin, givenMax);
+
+	UnloadTestScene(testScene, &scene);
+}
+
+struct ComponentCase
+{
+	GLTF::ComponentType ComponentType;
+	bool Normalized;
+	int64 Stored;
+	float32 Decoded;
+};
+
+// Normalized signed integers reach -1 one step before their lowest value, which is clamped to -1 as well.
+static constexpr ComponentCase ComponentCases[] =
+{
+	{ GLTF::ComponentType::Int8, true, -128, -1.0f },
+	{ GLTF::ComponentType::Int8, true, -127, -1.0f },
+	{ GLTF::ComponentType::Int8, true, 0, 0.0f },
+	{ GLTF::ComponentType::Int8, true, 127, 1.0f },
+	{ GLTF::ComponentType::UInt8, true, 0, 0.0f },
+	{ GLTF::ComponentType::UInt8, true, 51, 0.2f },
+	{ GLTF::ComponentType::UInt8, true, 255, 1.0f },
+	{ GLTF::ComponentType::Int16, true, -32768, -1.0f },
+	{ GLTF::ComponentType::Int16, true, -32767, -1.0f },
+	{ GLTF::ComponentType::Int16, true, 32767, 1.0f },
+	{ GLTF::ComponentType::UInt16, true, 0, 0.0f },
+	{ GLTF::ComponentType::UInt16, true, 13107, 0.2f },
+	{ GLTF::ComponentType::UInt16, true, 65535, 1.0f },
+	{ GLTF::ComponentType::Int8, false, -128, -128.0f },
+	{ GLTF::ComponentType::Int8, false, 127, 127.0f },
+	{ GLTF::ComponentType::UInt8, false, 255, 255.0f },
+	{ GLTF::ComponentType::Int16, false, -32768, -32768.0f },
+	{ GLTF::ComponentType::Int16, false, 32767, 32767.0f },
+	{ GLTF::ComponentType::UInt16, false, 65535, 65535.0f },
+};
+
+static void DecodesComponents()
+{
+	for (const ComponentCase& componentCase : ComponentCases)
+	{
+		// Stored little endian in the size of the component, as in a buffer.
+		uint8 data[sizeof(int64)];
+		for (usize byteIndex = 0; byteIndex < sizeof(data); ++byteIndex)
+		{
+			data[byteIndex] = static_cast<uint8>(static_cast<uint64>(componentCase.Stored) >> (byteIndex * 8));
+		}
+		VERIFY(IsNear(GLTF::DecodeComponent(data, componentCase.ComponentType, componentCase.Normalized), componentCase.Decoded),
+			   "Unexpected GLTF component value!");
+	}
+
+	static constexpr float32 decimal = -2.5f;
+	uint8 data[sizeof(decimal)];
+	Platform::MemoryCopy(data, &decimal, sizeof(decimal));
+	VERIFY(GLTF::DecodeComponent(data, GLTF::ComponentType::Float32, false) == decimal, "Unexpected GLTF component value!");
+}
+
+// The normalized positions give their bounds in the stored integers, which are left for the decoded points. The
+// positions that aren't normalized are bounded in the integers themselves.
+static void BoundsQuantizedPositions()
+{
+	static constexpr int16 normalizedPositions[][3] =
+	{
+		{ -32767, -32768, 0 },
+		{ 32767, 16384, -16384 },
+		{ 0, 0, 32767 },
+	};
+	static constexpr uint8 wholePositions[][3] =
+	{
+		{ 0, 10, 200 },
+		{ 255, 20, 100 },
+		{ 5, 30, 150 },
+	};
+
+	TestScene testScene = MakeTestScene("QuantizedPositions");
+	const usize indexAccessor = AddIndices(&testScene, TriangleIndices);
+	const TestPrimitive primitives[] =
+	{
+		{ .Positions = AddQuantizedPositions(&testScene, normalizedPositions, ShortComponentType, true, true), .Indices = indexAccessor },
+		{ .Positions = AddQuantizedPositions(&testScene, wholePositions, UnsignedByteComponentType, false, false), .Indices = indexAccessor },
+	};
+	AddMesh(&testScene, primitives, ARRAY_COUNT(primitives));
+
+	GLTF::Scene scene = LoadTestScene(testScene, R"({ "nodes": [{ "mesh": 0 }] })"_view);
+
+	VERIFY(scene.Primitives.GetCount() == 2, "Unexpected GLTF primitive count!");
+	VerifyBounds(scene.Primitives[0].Bounds, float32x3 { -1.0f, -1.0f, -16384.0f / 32767.0f }, float32x3 { 1.0f, 16384.0f / 32767.0f, 1.0f });
+	VerifyBounds(scene.Primitives[1].Bounds, float32x3 { 0.0f, 10.0f, 100.0f }, float32x3 { 255.0f, 30.0f, 200.0f });
+
+	UnloadTestScene(testScene, &scene);
+}
+
+// A translated parent holds a scaled child with the mesh, beside nodes without one.
+static void BoundsNodesInWorldSpace()
+{
+	static constexpr float32x3 translation = { 10.0f, 20.0f, 30.0f };
+	static constexpr float32 scale = 2.0f;
+
+	TestScene testScene = MakeTestScene("BoundsNodes");
+	AddMesh(&testScene, AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), true), AddIndices(&testScene, TriangleIndices));
+
+	const String members = FormatMembers(R"({
+		"nodes": [
+			{ "translation": [%g, %g, %g], "children": [1] },
+			{ "mesh": 0, "scale": [%g, %g, %g] },
+			{ "mesh": 0 },
+			{}
+		]
+	})", translation.X, translation.Y, translation.Z, scale, scale, scale);
+	GLTF::Scene scene = LoadTestScene(testScene, members);
+
+	VERIFY(scene.NodeWorldBounds.GetCount() == scene.Nodes.GetCount(), "GLTF node bounds aren't indexed like the nodes!");
+
+	VerifyEmptyBounds(scene.NodeWorldBounds[0]);
+	VerifyEmptyBounds(scene.NodeWorldBounds[3]);
+
+	const float32x3 worldMin = { BoxMin.X * scale + translation.X, BoxMin.Y * scale + translation.Y, BoxMin.Z * scale + translation.Z };
+	const float32x3 worldMax = { BoxMax.X * scale + translation.X, BoxMax.Y * scale + translation.Y, BoxMax.Z * scale + translation.Z };
+	VerifyBounds(scene.NodeWorldBounds[1], worldMin, worldMax);
+	VerifyBounds(scene.NodeWorldBounds[2], BoxMin, BoxMax);
+
+	UnloadTestScene(testScene, &scene);
+}
+
+// Two trees three levels deep, with a rotated root, a scaled child and a translated grandchild, so that multiplying in
+// the wrong order or skipping a level moves the grandchild.
+static void ChainsTransformsDownTheHierarchy()
+{
+	TestScene testScene = MakeTestScene("ChainsTransforms");
+	float32 positions[3][3];
+	MakeTriangle(0.0f, positions);
+	AddMesh(&testScene, AddPositions(&testScene, positions, sizeof(positions[0]), true), AddIndices(&testScene, TriangleIndices));
+
+	GLTF::Scene scene = LoadTestScene(testScene, R"({
+		"nodes": [
+			{ "translation": [1, 2, 3], "rotation": [0, 0.7071068, 0, 0.7071068], "children": [1, 3] },
+			{ "scale": [2, 2, 2], "children": [2] },
+			{ "mesh": 0, "translation": [1, 0, 0] },
+			{ "translation": [0, 5, 0] },
+			{ "translation": [-1, 0, 0], "children": [5] },
+			{ "rotation": [0, 0, 0.7071068, 0.7071068], "children": [6] },
+			{ "mesh": 0, "translation": [0, 0, 4] }
+		]
+	})"_view);
+
+	VERIFY(scene.NodeLocalToWorlds.GetCount() == scene.Nodes.GetCount(), "GLTF node transforms aren't indexed like the nodes!");
+	for (usize nodeIndex = 0; nodeIndex < scene.Nodes.GetCount(); ++nodeIndex)
+	{
+		const GLTF::Node& node = scene.Nodes[nodeIndex];
+		const Matrix expectedLocalToWorld = node.Parent == INDEX_NONE ? node.LocalToWorld : scene.NodeLocalToWorlds[node.Parent] * node.LocalToWorld;
+		VERIFY(IsNear(scene.NodeLocalToWorlds[nodeIndex], expectedLocalToWorld), "GLTF node transform isn't its parent's times its own!");
+	}
+
+	// The grandchild sits 1 along X, scaled to 2, turned onto -Z and moved by the root.
+	const float32* grandchildLocalToWorld = &scene.NodeLocalToWorlds[2].M00;
+	VERIFY(IsNear(float32x3 { grandchildLocalToWorld[12], grandchildLocalToWorld[13], grandchildLocalToWorld[14] }, float32x3 { 1.0f, 2.0f, 1.0f }),
+		   "Unexpected GLTF node position!");
+
+	UnloadTestScene(testScene, &scene);
+}
+
+// Loads a triangle under the given nodes and leaves the scene and its files behind, as the process is meant to fail.
+static void LoadBrokenHierarchy(const char* name, StringView members)
+{
+	TestScene testScene = MakeTestScene(name);
+	float32 positions[3][3];
+	MakeTriangle(0.0f, positions);
+	AddMesh(&testScene, AddPositions(&testScene, positions, sizeof(positions[0]), true), AddIndices(&testScene, TriangleIndices));
+	LoadTestScene(testScene, members);
+}
+
+static void LoadCyclicHierarchy()
+{
+	LoadBrokenHierarchy("Cycle", R"({ "nodes": [{ "mesh": 0 }, { "children": [2] }, { "children": [1] }] })"_view);
+}
+
+static void LoadSharedChild()
+{
+	LoadBrokenHierarchy("SharedChild", R"({ "nodes": [{ "children": [2] }, { "children": [2] }, { "mesh": 0 }] })"_view);
+}
+
+static void RejectsBrokenHierarchies()
+{
+	VERIFY(DoesFail("GLTF cycle", LoadCyclicHierarchy), "GLTF node cycle was accepted!");
+	RemoveTestScene(MakeTestScene("Cycle"));
+
+	VERIFY(DoesFail("GLTF shared child", LoadSharedChild), "GLTF node with two parents was accepted!");
+	RemoveTestScene(MakeTestScene("SharedChild"));
+}
+
+// The points are only in the BIN chunk and have no bounds given, so the bounds can only come from reading the chunk.
+static void LoadsBinaryFiles()
+{
+	TestScene testScene = MakeTestScene("Binary");
+	AddMesh(&testScene, AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), false), AddIndices(&testScene, TriangleIndices));
+
+	GLTF::Scene scene = LoadBinaryTestScene(testScene, R"({ "nodes": [{ "mesh": 0 }] })"_view);
+
+	VERIFY(scene.Buffers.GetCount() == 1 && scene.Buffers[0].Size == testScene.Buffer.GetCount(), "Unexpected GLTF buffer!");
+	VERIFY(memcmp(scene.Buffers[0].Data, testScene.Buffer.GetData(), testScene.Buffer.GetCount()) == 0, "GLTF buffer isn't the BIN chunk!");
+	VERIFY(scene.Primitives.GetCount() == 1, "Unexpected GLTF primitive count!");
+	VerifyBounds(scene.Primitives[0].Bounds, BoxMin, BoxMax);
+
+	UnloadTestScene(testScene, &scene);
+}
+
+static void LoadDamagedBinaryFile(const char* name, BinaryFileDamage damage)
+{
+	TestScene testScene = MakeTestScene(name);
+	AddMesh(&testScene, AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), false), AddIndices(&testScene, TriangleIndices));
+	LoadBinaryTestScene(testScene, R"({ "nodes": [{ "mesh": 0 }] })"_view, damage);
+}
+
+static void LoadLongJSONChunk()
+{
+	LoadDamagedBinaryFile("LongJSONChunk", BinaryFileDamage::LongJSONChunk);
+}
+
+static void LoadLongBinaryChunk()
+{
+	LoadDamagedBinaryFile("LongBinaryChunk", BinaryFileDamage::LongBinaryChunk);
+}
+
+static void LoadMissingBinaryChunk()
+{
+	LoadDamagedBinaryFile("MissingBinaryChunk", BinaryFileDamage::NoBinaryChunk);
+}
+
+static void RejectsDamagedBinaryFiles()
+{
+	VERIFY(DoesFail("GLB long JSON chunk", LoadLongJSONChunk), "GLB JSON chunk past the end of the file was accepted!");
+	RemoveTestScene(MakeTestScene("LongJSONChunk"));
+
+	VERIFY(DoesFail("GLB long BIN chunk", LoadLongBinaryChunk), "GLB BIN chunk past the end of the file was accepted!");
+	RemoveTestScene(MakeTestScene("LongBinaryChunk"));
+
+	VERIFY(DoesFail("GLB missing BIN chunk", LoadMissingBinaryChunk), "GLB buffer without a BIN chunk was accepted!");
+	RemoveTestScene(MakeTestScene("MissingBinaryChunk"));
+}
+
+// Meshes 0 and 1 store the same triangle in views of their own, mesh 2 has other positions with the same indices, and
+// mesh 3 has the positions of mesh 0 stored apart.
+static void SharesRepeatedGeometry()
+{
+	static constexpr usize paddedStride = 16;
+
+	TestScene testScene = MakeTestScene("SharesGeometry");
+	const usize positionAccessor = AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), true);
+	const usize indexAccessor = AddIndices(&testScene, TriangleIndices);
+	const usize repeatedPositionAccessor = AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), true);
+	const usize repeatedIndexAccessor = AddIndices(&testScene, TriangleIndices);
+	const usize otherPositionAccessor = AddPositions(&testScene, ReversedBoxPositions, sizeof(ReversedBoxPositions[0]), true);
+	const usize otherIndexAccessor = AddIndices(&testScene, TriangleIndices);
+	const usize paddedPositionAccessor = AddPositions(&testScene, BoxPositions, paddedStride, true);
+	const usize paddedIndexAccessor = AddIndices(&testScene, TriangleIndices);
+
+	AddMesh(&testScene, positionAccessor, indexAccessor);
+	AddMesh(&testScene, repeatedPositionAccessor, repeatedIndexAccessor);
+	AddMesh(&testScene, otherPositionAccessor, otherIndexAccessor);
+	AddMesh(&testScene, paddedPositionAccessor, paddedIndexAccessor);
+
+	GLTF::Scene scene = LoadTestScene(testScene, R"({ "nodes": [{ "mesh": 0 }, { "mesh": 1 }, { "mesh": 2 }, { "mesh": 3 }] })"_view);
+
+	VERIFY(scene.Accessors.GetCount() == testScene.Accessors.GetCount(), "GLTF accessors were dropped!");
+	VERIFY(scene.Primitives.GetCount() == 4, "Unexpected GLTF primitive count!");
+
+	static constexpr usize expectedGeometries[] = { 0, 0, 2, 0 };
+	for (usize primitiveIndex = 0; primitiveIndex < scene.Primitives.GetCount(); ++primitiveIndex)
+	{
+		const GLTF::Primitive& primitive = scene.Primitives[primitiveIndex];
+		VERIFY(primitive.Geometry == expectedGeometries[primitiveIndex], "Unexpected GLTF primitive geometry!");
+		VERIFY(primitive.Indices == indexAccessor, "Repeated GLTF indices weren't merged!");
+	}
+
+	const usize expectedPositionAccessors[] = { positionAccessor, positionAccessor, otherPositionAccessor, positionAccessor };
+	for (usize primitiveIndex = 0; primitiveIndex < scene.Primitives.GetCount(); ++primitiveIndex)
+	{
+		VERIFY(GLTF::GetAttribute(scene.Primitives[primitiveIndex], GLTF::AttributeType::Position) == expectedPositionAccessors[primitiveIndex],
+			   "Unexpected GLTF primitive positions!");
+	}
+
+	// Merged primitives keep their bounds, which are those of the same points.
+	for (const GLTF::Primitive& primitive : scene.Primitives)
+	{
+		VerifyBounds(primitive.Bounds, BoxMin, BoxMax);
+	}
+
+	UnloadTestScene(testScene, &scene);
+}
+
+// Streams that differ in their last component, or hold the same bytes as another type, stay apart.
+static void KeepsDifferentStreamsApart()
+{
+	float32 nearlyBoxPositions[ARRAY_COUNT(BoxPositions)][3];
+	Platform::MemoryCopy(nearlyBoxPositions, BoxPositions, sizeof(BoxPositions));
+	nearlyBoxPositions[ARRAY_COUNT(BoxPositions) - 1][2] = nextafterf(nearlyBoxPositions[ARRAY_COUNT(BoxPositions) - 1][2], 10.0f);
+
+	static constexpr uint16 otherIndices[] = { 0, 2, 1 };
+
+	TestScene testScene = MakeTestScene("KeepsStreamsApart");
+	const usize positionAccessor = AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), true);
+	const usize indexAccessor = AddIndices(&testScene, TriangleIndices);
+	const usize nearlyPositionAccessor = AddPositions(&testScene, nearlyBoxPositions, sizeof(nearlyBoxPositions[0]), true);
+	const usize otherIndexAccessor = AddIndices(&testScene, otherIndices);
+
+	// The positions again, read as eighteen scalars.
+	const usize scalarAccessor = AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), false);
+	testScene.Accessors[scalarAccessor].Count = ARRAY_COUNT(BoxPositions) * 3;
+	testScene.Accessors[scalarAccessor].Type = "SCALAR"_view;
+
+	AddMesh(&testScene, positionAccessor, indexAccessor);
+	AddMesh(&testScene, nearlyPositionAccessor, indexAccessor);
+	const TestPrimitive texturedPrimitive =
+	{
+		.Positions = positionAccessor,
+		.Indices = otherIndexAccessor,
+		.TexCoords = scalarAccessor,
+	};
+	AddMesh(&testScene, &texturedPrimitive, 1);
+
+	GLTF::Scene scene = LoadTestScene(testScene, R"({ "nodes": [{ "mesh": 0 }, { "mesh": 1 }, { "mesh": 2 }] })"_view);
+
+	const GLTF::Primitive& nearlyPrimitive = scene.Primitives[1];
+	VERIFY(GLTF::GetAttribute(nearlyPrimitive, GLTF::AttributeType::Position) == nearlyPositionAccessor, "Different GLTF positions were merged!");
+	VERIFY(nearlyPrimitive.Geometry == 1, "GLTF primitives with different positions share geometry!");
+
+	const GLTF::Primitive& otherPrimitive = scene.Primitives[2];
+	VERIFY(otherPrimitive.Indices == otherIndexAccessor, "Different GLTF indices were merged!");
+	VERIFY(GLTF::GetAttribute(otherPrimitive, GLTF::AttributeType::TexCoord0) == scalarAccessor, "GLTF streams of different types were merged!");
+	VERIFY(otherPrimitive.Geometry == 2, "GLTF primitives with different indices share geometry!");
+
+	UnloadTestScene(testScene, &scene);
+}
+
+static bool IsSameMatrix(const Matrix& a, const Matrix& b)
+{
+	return memcmp(&a, &b, sizeof(Matrix)) == 0;
+}
+
+static bool IsSameBounds(const GLTF::Bounds& a, const GLTF::Bounds& b)
+{
+	return IsNear(a.Min, b.Min) && IsNear(a.Max, b.Max) && IsNear(a.Center, b.Center) && IsNear(a.Radius, b.Radius);
+}
+
+static constexpr float32 BoxNormals[][3] =
+{
+	{ 1.0f, 0.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 0.0f, 1.0f },
+	{ -1.0f, 0.0f, 0.0f },
+	{ 0.0f, -1.0f, 0.0f },
+	{ 0.0f, 0.0f, -1.0f },
+};
+
+template<usize ElementCount>
+static void VerifyStream(const GLTF::Scene& scene, usize accessorIndex, const float32 (&elements)[ElementCount][3])
+{
+	const GLTF::AccessorView view = GLTF::GetAccessorView(scene, accessorIndex);
+	const uint8* data = scene.Buffers[view.Buffer].Data + view.Offset;
+	for (usize elementIndex = 0; elementIndex < ElementCount; ++elementIndex)
+	{
+		VERIFY(memcmp(data + elementIndex * view.Stride, elements[elementIndex], sizeof(elements[elementIndex])) == 0,
+			   "GLTF stream doesn't hold the elements written!");
+	}
+}
+
+// Each vertex holds its position and then its normal in one view. As stored, both streams step over the other, and
+// packed, each is copied out into a dense stream of its own.
+static void ReadsInterleavedStreams()
+{
+	static constexpr usize elementSize = sizeof(BoxPositions[0]);
+	static constexpr usize vertexCount = ARRAY_COUNT(BoxPositions);
+
+	TestScene testScene = MakeTestScene("Interleaved");
+	usize positionAccessor;
+	usize normalAccessor;
+	AddInterleavedPositionsAndNormals(&testScene, BoxPositions, BoxNormals, &positionAccessor, &normalAccessor);
+	const TestPrimitive primitive =
+	{
+		.Positions = positionAccessor,
+		.Indices = AddIndices(&testScene, TriangleIndices),
+		.Normals = normalAccessor,
+	};
+	AddMesh(&testScene, &primitive, 1);
+
+	const StringView members = R"({ "nodes": [{ "mesh": 0 }] })"_view;
+	GLTF::Scene stored = LoadTestScene(testScene, members);
+
+	const GLTF::AccessorView storedPositions = GLTF::GetAccessorView(stored, positionAccessor);
+	const GLTF::AccessorView storedNormals = GLTF::GetAccessorView(stored, normalAccessor);
+	const usize interleavedSize = (vertexCount - 1) * elementSize * 2 + elementSize;
+	VERIFY(storedPositions.Buffer == storedNormals.Buffer, "GLTF interleaved streams are apart!");
+	VERIFY(storedPositions.Stride == elementSize * 2 && storedNormals.Stride == elementSize * 2, "Unexpected GLTF interleaved stride!");
+	VERIFY(storedPositions.Size == interleavedSize && storedNormals.Size == interleavedSize, "Unexpected GLTF interleaved size!");
+	VERIFY(storedPositions.Offset == testScene.Accessors[positionAccessor].Offset &&
+		   storedNormals.Offset == storedPositions.Offset + elementSize,
+		   "Unexpected GLTF interleaved offset!");
+	VerifyStream(stored, positionAccessor, BoxPositions);
+	VerifyStream(stored, normalAccessor, BoxNormals);
+
+	UnloadTestScene(testScene, &stored);
+
+	GLTF::Scene packed = LoadTestScene(testScene, members, GLTF::VertexLayout::Packed);
+
+	const GLTF::AccessorView packedPositions = GLTF::GetAccessorView(packed, positionAccessor);
+	const GLTF::AccessorView packedNormals = GLTF::GetAccessorView(packed, normalAccessor);
+	VERIFY(!packed.Buffers[packedPositions.Buffer].MappedFile && packedPositions.Buffer == packedNormals.Buffer,
+		   "GLTF streams weren't packed!");
+	VERIFY(packedPositions.Stride == elementSize && packedNormals.Stride == elementSize, "GLTF packed streams have gaps!");
+	VERIFY(packedPositions.Size == vertexCount * elementSize && packedNormals.Size == vertexCount * elementSize, "Unexpected GLTF packed size!");
+	VERIFY(packedNormals.Offset >= packedPositions.Offset + packedPositions.Size ||
+		   packedPositions.Offset >= packedNormals.Offset + packedNormals.Size,
+		   "GLTF packed streams overlap!");
+	VerifyStream(packed, positionAccessor, BoxPositions);
+	VerifyStream(packed, normalAccessor, BoxNormals);
+
+	UnloadTestScene(testScene, &packed);
+}
+
+// The document parser is kept to measure the streaming one against, so both have to build the same scene from the same
+// file, down to its cameras, lights and merged streams.
+static void ReadsTheSameSceneWithEitherParser()
+{
+	TestScene testScene = MakeTestScene("EitherParser");
+	const usize positionAccessor = AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), true);
+	const usize indexAccessor = AddIndices(&testScene, TriangleIndices);
+	AddMesh(&testScene, positionAccessor, indexAccessor);
+	AddMesh(&testScene, AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), false), AddIndices(&testScene, TriangleIndices));
+
+	const StringView members = R"({
+		"scenes": [{ "nodes": [0, 4] }],
+		"nodes": [
+			{ "translation": [1, 2, 3], "rotation": [0, 0.7071068, 0, 0.7071068], "children": [1, 2] },
+			{ "mesh": 0, "scale": [2, 2, 2], "children": [3] },
+			{ "camera": 0, "translation": [0, 0, 5] },
+			{ "mesh": 1, "matrix": [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, -4, 5, 6, 1] },
+			{ "extensions": { "KHR_lights_punctual": { "light": 0 } }, "translation": [0, 10, 0] }
+		],
+		"cameras": [{ "type": "perspective", "perspective": { "yfov": 0.8, "aspectRatio": 1.5, "znear": 0.1, "zfar": 100 } }],
+		"extensions": { "KHR_lights_punctual": { "lights": [{ "type": "point", "intensity": 3, "color": [1, 0.5, 0.25] }] } },
+		"extras": { "twoChannelNormalMaps": true }
+	})"_view;
+	GLTF::Scene streamed = LoadTestScene(testScene, members);
+	// The files are already written, and stay mapped by the first scene.
+	GLTF::Scene parsed = GLTF::LoadScene(StringView(testScene.ManifestPath, Platform::StringLength(testScene.ManifestPath)),
+										 GLTF::VertexLayout::AsStored,
+										 GLTF::ManifestParser::Document);
+
+	VERIFY(streamed.TopLevelNodes.GetCount() == parsed.TopLevelNodes.GetCount(), "GLTF parsers disagree on the top level nodes!");
+	for (usize index = 0; index < streamed.TopLevelNodes.GetCount(); ++index)
+	{
+		VERIFY(streamed.TopLevelNodes[index] == parsed.TopLevelNodes[index], "GLTF parsers disagree on the top level nodes!");
+	}
+
+	VERIFY(streamed.Nodes.GetCount() == parsed.Nodes.GetCount(), "GLTF parsers disagree on the node count!");
+	VERIFY(memcmp(streamed.Nodes.GetData(), parsed.Nodes.GetData(), streamed.Nodes.GetDataSize()) == 0,
+		   "GLTF parsers disagree on the nodes!");
+	VERIFY(streamed.ChildNodes.GetCount() == parsed.ChildNodes.GetCount() &&
+		   memcmp(streamed.ChildNodes.GetData(), parsed.ChildNodes.GetData(), streamed.ChildNodes.GetDataSize()) == 0,
+		   "GLTF parsers disagree on the child nodes!");
+	for (usize nodeIndex = 0; nodeIndex < streamed.Nodes.GetCount(); ++nodeIndex)
+	{
+		VERIFY(IsSameMatrix(streamed.NodeLocalToWorlds[nodeIndex], parsed.NodeLocalToWorlds[nodeIndex]), "GLTF parsers disagree on a node transform!");
+		VERIFY(IsSameBounds(streamed.NodeWorldBounds[nodeIndex], parsed.NodeWorldBounds[nodeIndex]), "GLTF parsers disagree on node bounds!");
+	}
+
+	VERIFY(streamed.Primitives.GetCount() == parsed.Primitives.GetCount(), "GLTF parsers disagree on the primitive count!");
+	for (usize primitiveIndex = 0; primitiveIndex < streamed.Primitives.GetCount(); ++primitiveIndex)
+	{
+		const GLTF::Primitive& streamedPrimitive = streamed.Primitives[primitiveIndex];
+		const GLTF::Primitive& parsedPrimitive = parsed.Primitives[primitiveIndex];
+		VERIFY(memcmp(streamedPrimitive.Attributes, parsedPrimitive.Attributes, sizeof(streamedPrimitive.Attributes)) == 0,
+			   "GLTF parsers disagree on the primitive attributes!");
+		VERIFY(streamedPrimitive.Indices == parsedPrimitive.Indices && streamedPrimitive.Geometry == parsedPrimitive.Geometry,
+			   "GLTF parsers disagree on the primitive geometry!");
+		VERIFY(IsSameBounds(streamedPrimitive.Bounds, parsedPrimitive.Bounds), "GLTF parsers disagree on primitive bounds!");
+	}
+
+	VERIFY(streamed.Accessors.GetCount() == parsed.Accessors.GetCount(), "GLTF parsers disagree on the accessor count!");
+	for (usize accessorIndex = 0; accessorIndex < streamed.Accessors.GetCount(); ++accessorIndex)
+	{
+		const GLTF::Accessor& streamedAccessor = streamed.Accessors[accessorIndex];
+		const GLTF::Accessor& parsedAccessor = parsed.Accessors[accessorIndex];
+		VERIFY(streamedAccessor.BufferView == parsedAccessor.BufferView &&
+			   streamedAccessor.Count == parsedAccessor.Count &&
+			   streamedAccessor.Offset == parsedAccessor.Offset &&
+			   streamedAccessor.ComponentType == parsedAccessor.ComponentType &&
+			   streamedAccessor.AccessorType == parsedAccessor.AccessorType &&
+			   streamedAccessor.HasMinMax == parsedAccessor.HasMinMax,
+			   "GLTF parsers disagree on an accessor!");
+	}
+
+	VERIFY(streamed.Cameras.GetCount() == 1 && parsed.Cameras.GetCount() == 1, "Unexpected GLTF camera count!");
+	VERIFY(IsSameMatrix(streamed.Cameras[0].LocalToWorld, parsed.Cameras[0].LocalToWorld) &&
+		   streamed.Cameras[0].FieldOfViewYRadians == parsed.Cameras[0].FieldOfViewYRadians &&
+		   streamed.Cameras[0].AspectRatio == parsed.Cameras[0].AspectRatio &&
+		   streamed.Cameras[0].Near == parsed.Cameras[0].Near &&
+		   streamed.Cameras[0].Far == parsed.Cameras[0].Far,
+		   "GLTF parsers disagree on the camera!");
+
+	VERIFY(streamed.Lights.GetCount() == 1 && parsed.Lights.GetCount() == 1, "Unexpected GLTF light count!");
+	VERIFY(streamed.Lights[0].Type == parsed.Lights[0].Type &&
+		   IsSameMatrix(streamed.Lights[0].LocalToWorld, parsed.Lights[0].LocalToWorld) &&
+		   streamed.Lights[0].Intensity == parsed.Lights[0].Intensity &&
+		   IsNear(streamed.Lights[0].RGB, parsed.Lights[0].RGB),
+		   "GLTF parsers disagree on the light!");
+
+	VERIFY(streamed.TwoChannelNormalMaps && parsed.TwoChannelNormalMaps, "GLTF parsers dropped the extras!");
+
+	GLTF::UnloadScene(&parsed);
+	UnloadTestScene(testScene, &streamed);
+}
+
+// Two grouping nodes, one a root and one inside it, hold a mesh with instances, a camera, a light and a mesh, beside a
+// mesh at the top level. Flattening keeps the five nodes that place something, in their order, each at the top level
+// where it was in the world.
+static void FlattensGroupingNodes()
+{
+	static constexpr float32 instanceTranslations[][3] =
+	{
+		{ 0.0f, 0.0f, 0.0f },
+		{ 3.0f, 0.0f, 0.0f },
+		{ 0.0f, -3.0f, 1.0f },
+	};
+	static constexpr usize keptNodes[] = { 1, 2, 3, 5, 6 };
+
+	TestScene testScene = MakeTestScene("Flattens");
+	AddMesh(&testScene, AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), true), AddIndices(&testScene, TriangleIndices));
+	const usize translationAccessor = AddPositions(&testScene, instanceTranslations, sizeof(instanceTranslations[0]), false);
+
+	const String members = FormatMembers(R"({
+		"scenes": [{ "nodes": [0, 6] }],
+		"nodes": [
+			{ "translation": [10, 0, 0], "children": [1, 2, 3, 4] },
+			{ "mesh": 0, "scale": [2, 2, 2], "extensions": { "EXT_mesh_gpu_instancing": { "attributes": { "TRANSLATION": %zu } } } },
+			{ "camera": 0, "translation": [0, 0, 5] },
+			{ "extensions": { "KHR_lights_punctual": { "light": 0 } }, "translation": [0, 3, 0] },
+			{ "rotation": [0, 0.7071068, 0, 0.7071068], "children": [5] },
+			{ "mesh": 0, "translation": [1, 0, 0] },
+			{ "mesh": 0 }
+		],
+		"cameras": [{ "type": "perspective", "perspective": { "yfov": 0.8, "aspectRatio": 1.5, "znear": 0.1, "zfar": 100 } }],
+		"extensions": { "KHR_lights_punctual": { "lights": [{ "type": "point", "intensity": 3, "color": [1, 0.5, 0.25] }] } }
+	})", translationAccessor);
+	GLTF::Scene scene = LoadTestScene(testScene, members);
+
+	VERIFY(scene.Nodes.GetCount() == 7, "Unexpected GLTF node count!");
+	Array<GLTF::Node> nodes(scene.Nodes.GetCount(), Allocator);
+	Array<Matrix> nodeLocalToWorlds(scene.Nodes.GetCount(), Allocator);
+	Array<GLTF::Bounds> nodeWorldBounds(scene.Nodes.GetCount(), Allocator);
+	for (usize nodeIndex = 0; nodeIndex < scene.Nodes.GetCount(); ++nodeIndex)
+	{
+		nodes.Add(scene.Nodes[nodeIndex]);
+		nodeLocalToWorlds.Add(scene.NodeLocalToWorlds[nodeIndex]);
+		nodeWorldBounds.Add(scene.NodeWorldBounds[nodeIndex]);
+	}
+	Array<Matrix> instanceLocalToWorlds(scene.InstanceLocalToWorlds.GetCount(), Allocator);
+	for (const Matrix& instanceLocalToWorld : scene.InstanceLocalToWorlds)
+	{
+		instanceLocalToWorlds.Add(instanceLocalToWorld);
+	}
+	VERIFY(instanceLocalToWorlds.GetCount() == ARRAY_COUNT(instanceTranslations), "Unexpected GLTF instance count!");
+	VERIFY(scene.Cameras.GetCount() == 1 && scene.Lights.GetCount() == 1, "Unexpected GLTF camera or light count!");
+	const GLTF::Camera camera = scene.Cameras[0];
+	const GLTF::Light light = scene.Lights[0];
+
+	GLTF::FlattenNodeHierarchy(&scene);
+
+	VERIFY(scene.Nodes.GetCount() == ARRAY_COUNT(keptNodes), "GLTF grouping nodes weren't dropped!");
+	VERIFY(scene.NodeLocalToWorlds.GetCount() == scene.Nodes.GetCount() && scene.NodeWorldBounds.GetCount() == scene.Nodes.GetCount(),
+		   "GLTF node transforms and bounds aren't indexed like the nodes!");
+	VERIFY(scene.ChildNodes.IsEmpty(), "Flattened GLTF nodes kept children!");
+	VERIFY(scene.TopLevelNodes.GetCount() == scene.Nodes.GetCount(), "Flattened GLTF nodes aren't all at the top level!");
+	for (usize nodeIndex = 0; nodeIndex < scene.Nodes.GetCount(); ++nodeIndex)
+	{
+		const GLTF::Node& node = scene.Nodes[nodeIndex];
+		const GLTF::Node& keptNode = nodes[keptNodes[nodeIndex]];
+		VERIFY(scene.TopLevelNodes[nodeIndex] == nodeIndex, "Unexpected GLTF top level node!");
+		VERIFY(node.Parent == INDEX_NONE && node.ChildNodeCount == 0, "Flattened GLTF node is still linked!");
+		VERIFY(node.Mesh == keptNode.Mesh && node.Camera == keptNode.Camera && node.Light == keptNode.Light &&
+			   node.FirstInstance == keptNode.FirstInstance && node.InstanceCount == keptNode.InstanceCount,
+			   "Flattened GLTF node places something else!");
+		VERIFY(IsSameMatrix(node.LocalToWorld, nodeLocalToWorlds[keptNodes[nodeIndex]]) &&
+			   IsSameMatrix(scene.NodeLocalToWorlds[nodeIndex], nodeLocalToWorlds[keptNodes[nodeIndex]]),
+			   "Flattened GLTF node moved!");
+		VERIFY(IsSameBounds(scene.NodeWorldBounds[nodeIndex], nodeWorldBounds[keptNodes[nodeIndex]]), "Flattened GLTF node bounds changed!");
+	}
+
+	VERIFY(scene.InstanceLocalToWorlds.GetCount() == instanceLocalToWorlds.GetCount(), "Flattening changed the GLTF instances!");
+	for (usize instanceIndex = 0; instanceIndex < instanceLocalToWorlds.GetCount(); ++instanceIndex)
+	{
+		VERIFY(IsSameMatrix(scene.InstanceLocalToWorlds[instanceIndex], instanceLocalToWorlds[instanceIndex]), "Flattened GLTF instance moved!");
+	}
+	VERIFY(IsSameMatrix(scene.Cameras[0].LocalToWorld, camera.LocalToWorld), "Flattened GLTF camera moved!");
+	VERIFY(IsSameMatrix(scene.Lights[0].LocalToWorld, light.LocalToWorld), "Flattened GLTF light moved!");
+
+	UnloadTestScene(testScene, &scene);
+}
+
+static float32x3 TransformPoint(const Matrix& localToWorld, float32x3 point)
+{
+	const float32* columns = &localToWorld.M00;
+	return float32x3
+	{
+		columns[0] * point.X + columns[4] * point.Y + columns[8] * point.Z + columns[12],
+		columns[1] * point.X + columns[5] * point.Y + columns[9] * point.Z + columns[13],
+		columns[2] * point.X + columns[6] * point.Y + columns[10] * point.Z + columns[14],
+	};
+}
+
+// Three instances of the box under a moved parent, each with a translation, rotation and scale of its own. Every
+// placement has to be the world transform of the node times that of the instance, and be boxed by the corners of the
+// box it moves.
+static void PlacesMeshInstances()
+{
+	static constexpr float32 instanceTranslations[][3] =
+	{
+		{ 0.0f, 0.0f, 0.0f },
+		{ 4.0f, 0.0f, 0.0f },
+		{ 0.0f, -2.0f, 6.0f },
+	};
+	static constexpr float32 instanceRotations[][4] =
+	{
+		{ 0.0f, 0.0f, 0.0f, 1.0f },
+		{ 0.0f, 0.0f, 0.7071068f, 0.7071068f },
+		{ 0.7071068f, 0.0f, 0.0f, 0.7071068f },
+	};
+	static constexpr float32 instanceScales[][3] =
+	{
+		{ 1.0f, 1.0f, 1.0f },
+		{ 2.0f, 2.0f, 2.0f },
+		{ 1.0f, 3.0f, 0.5f },
+	};
+	static constexpr usize instancedNode = 1;
+
+	TestScene testScene = MakeTestScene("PlacesInstances");
+	AddMesh(&testScene, AddPositions(&testScene, BoxPositions, sizeof(BoxPositions[0]), true), AddIndices(&testScene, TriangleIndices));
+	const usize translationAccessor = AddPositions(&testScene, instanceTranslations, sizeof(instanceTranslations[0]), false);
+	const usize rotationAccessor = AddRotations(&testScene, instanceRotations);
+	const usize scaleAccessor = AddPositions(&testScene, instanceScales, sizeof(instanceScales[0]), false);
+
+	const String members = FormatMembers(R"({
+		"nodes": [
+			{ "translation": [0, 0, -10], "children": [1] },
+			{
+				"mesh": 0,
+				"translation": [5, 0, 0],
+				"rotation": [0, 0.7071068, 0, 0.7071068],
+				"extensions": { "EXT_mesh_gpu_instancing": { "attributes": { "TRANSLATION": %zu, "ROTATION": %zu, "SCALE": %zu } } }
+			}
+		]
+	})", translationAccessor, rotationAccessor, scaleAccessor);
+	GLTF::Scene scene = LoadTestScene(testScene, members);
+
+	const GLTF::Node& node = scene.Nodes[instancedNode];
+	VERIFY(node.InstanceCount == ARRAY_COUNT(instanceTranslations), "Unexpected GLTF instance count!");
+	VERIFY(scene.InstanceLocalToWorlds.GetCount() == node.InstanceCount && scene.InstanceWorldBounds.GetCount() == node.InstanceCount,
+		   "GLTF instance placements aren't indexed like the instances!");
+
+	float32x3 nodeMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float32x3 nodeMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (usize instanceIndex = 0; instanceIndex < node.InstanceCount; ++instanceIndex)
+	{
+		const float32 (&translation)[3] = instanceTranslations[instanceIndex];
+		const float32 (&rotation)[4] = instanceRotations[instanceIndex];
+		const float32 (&scale)[3] = instanceScales[instanceIndex];
+		const Matrix instanceToNode = Matrix::Translation(translation[0], translation[1], translation[2]) *
+									  Quaternion(rotation[0], rotation[1], rotation[2], rotation[3]).ToMatrix() *
+									  Matrix::Scale(scale[0], scale[1], scale[2]);
+		const Matrix expectedLocalToWorld = scene.NodeLocalToWorlds[instancedNode] * instanceToNode;
+		VERIFY(IsNear(scene.InstanceLocalToWorlds[node.FirstInstance + instanceIndex], expectedLocalToWorld),
+			   "GLTF instance isn't placed by its node!");
+
+		float32x3 instanceMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+		float32x3 instanceMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for (usize cornerIndex = 0; cornerIndex < 8; ++cornerIndex)
+		{
+			const float32x3 corner =
+			{
+				cornerIndex & 1 ? BoxMax.X : BoxMin.X,
+				cornerIndex & 2 ? BoxMax.Y : BoxMin.Y,
+				cornerIndex & 4 ? BoxMax.Z : BoxMin.Z,
+			};
+			const float32x3 worldCorner = TransformPoint(expectedLocalToWorld, corner);
+			instanceMin = float32x3 { Min(instanceMin.X, worldCorner.X), Min(instanceMin.Y, worldCorner.Y), Min(instanceMin.Z, worldCorner.Z) };
+			instanceMax = float32x3 { Max(instanceMax.X, worldCorner.X), Max(instanceMax.Y, worldCorner.Y), Max(instanceMax.Z, worldCorner.Z) };
+		}
+		// The sphere of an instance is the sphere of the box moved with it, grown by the largest scale of the instance.
+		const GLTF::Bounds& instanceBounds = scene.InstanceWorldBounds[node.FirstInstance + instanceIndex];
+		const float32x3 boxCenter = { (BoxMin.X + BoxMax.X) * 0.5f, (BoxMin.Y + BoxMax.Y) * 0.5f, (BoxMin.Z + BoxMax.Z) * 0.5f };
+		const float32x3 boxExtent = { BoxMax.X - BoxMin.X, BoxMax.Y - BoxMin.Y, BoxMax.Z - BoxMin.Z };
+		const float32 boxRadius = sqrtf(boxExtent.X * boxExtent.X + boxExtent.Y * boxExtent.Y + boxExtent.Z * boxExtent.Z) * 0.5f;
+		const float32 largestScale = Max(scale[0], Max(scale[1], scale[2]));
+		VERIFY(IsNear(instanceBounds.Min, instanceMin) && IsNear(instanceBounds.Max, instanceMax), "Unexpected GLTF instance bounds box!");
+		VERIFY(IsNear(instanceBounds.Center, TransformPoint(expectedLocalToWorld, boxCenter)) && IsNear(instanceBounds.Radius, boxRadius * largestScale),
+			   "Unexpected GLTF instance bounds sphere!");
+
+		nodeMin = float32x3 { Min(nodeMin.X, instanceMin.X), Min(nodeMin.Y, instanceMin.Y), Min(nodeMin.Z, instanceMin.Z) };
+		nodeMax = float32x3 { Max(nodeMax.X, instanceMax.X), Max(nodeMax.Y, instanceMax.Y), Max(nodeMax.Z, instanceMax.Z) };
+	}
+	VerifyBounds(scene.NodeWorldBounds[instancedNode], nodeMin, nodeMax);
+
+	UnloadTestScene(testScene, &scene);
+}
+
+void RunGLTFTests()
+{
+	static constexpr Test tests[] =
+	{
+		{ "Links children in one run per node", LinksChildrenInOneRunPerNode },
+		{ "Keeps the primitives of each mesh in one run", KeepsThePrimitivesOfEachMeshInOneRun },
+		{ "Stores scenes in few allocations", StoresScenesInFewAllocations },
+		{ "Unloading lets go of everything", UnloadingLetsGoOfEverything },
+		{ "Bounds primitives with and without min and max", BoundsPrimitivesWithAndWithoutMinMax },
+		{ "Takes the min and max of the file", TakesTheMinMaxOfTheFile },
+		{ "Decodes components", DecodesComponents },
+		{ "Bounds quantized positions", BoundsQuantizedPositions },
+		{ "Bounds nodes in world space", BoundsNodesInWorldSpace },
+		{ "Chains transforms down the hierarchy", ChainsTransformsDownTheHierarchy },
+		{ "Rejects broken hierarchies", RejectsBrokenHierarchies },
+		{ "Loads binary files", LoadsBinaryFiles },
+		{ "Rejects damaged binary files", RejectsDamagedBinaryFiles },
+		{ "Shares repeated geometry", SharesRepeatedGeometry },
+		{ "Keeps different streams apart", KeepsDifferentStreamsApart },
+		{ "Reads interleaved streams", ReadsInterleavedStreams },
+		{ "Reads the same scene with either parser", ReadsTheSameSceneWithEitherParser },
+		{ "Places mesh instances", PlacesMeshInstances },
+		{ "Flattens grouping nodes", FlattensGroupingNodes },
+	};
+	RunTests("GLTF", tests);
+}
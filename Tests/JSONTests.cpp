@@ -0,0 +1,705 @@
+#include "JSON.hpp"
+#include "Test.hpp"
+
+#include <float.h>
+#include <locale.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static void VerifyString(const JSON::Value& value, StringView expected)
+{
+	VERIFY(value.GetTag() == JSON::Tag::String && value.GetString() == expected, "Unexpected JSON string!");
+}
+
+static void ParsesEveryValueType()
+{
+	static constexpr StringView text = R"({
+		"object": { "nested": { "deeper": [1, 2, 3] } },
+		"array": [true, false, null, "four", 5.5, -6],
+		"string": "text",
+		"decimal": 0.25,
+		"integer": 42,
+		"boolean": true,
+		"null": null,
+		"emptyObject": {},
+		"emptyArray": [],
+		"nestedArrays": [[[[[]]]]]
+	})"_view;
+
+	const JSON::Document document = JSON::Parse(text);
+	const JSON::Object root = document.GetRoot();
+	VERIFY(root.GetCount() == 10, "Unexpected JSON member count!");
+
+	const JSON::Array deeper = root["object"_key].GetObject()["nested"_key].GetObject()["deeper"_key].GetArray();
+	VERIFY(deeper.GetCount() == 3, "Unexpected JSON element count!");
+	for (usize elementIndex = 0; elementIndex < deeper.GetCount(); ++elementIndex)
+	{
+		VERIFY(deeper[elementIndex].GetInteger() == static_cast<int64>(elementIndex + 1), "Unexpected JSON integer!");
+	}
+
+	const JSON::Array array = root["array"_key].GetArray();
+	VERIFY(array.GetCount() == 6, "Unexpected JSON element count!");
+	VERIFY(array[0].GetBoolean() && !array[1].GetBoolean(), "Unexpected JSON boolean!");
+	VERIFY(array[2].GetTag() == JSON::Tag::Null, "Unexpected JSON null!");
+	VerifyString(array[3], "four"_view);
+	VERIFY(array[4].GetDecimal() == 5.5, "Unexpected JSON decimal!");
+	VERIFY(array[5].GetInteger() == -6, "Unexpected JSON integer!");
+
+	VerifyString(root["string"_key], "text"_view);
+	VERIFY(root["decimal"_key].GetTag() == JSON::Tag::Decimal && root["decimal"_key].GetDecimal() == 0.25, "Unexpected JSON decimal!");
+	VERIFY(root["integer"_key].GetTag() == JSON::Tag::Integer && root["integer"_key].GetUnsigned() == 42, "Unexpected JSON integer!");
+	VERIFY(root["boolean"_key].GetBoolean(), "Unexpected JSON boolean!");
+	VERIFY(root["null"_key].GetTag() == JSON::Tag::Null, "Unexpected JSON null!");
+	VERIFY(root["emptyObject"_key].GetObject().GetCount() == 0, "Unexpected JSON member count!");
+	VERIFY(root["emptyArray"_key].GetArray().GetCount() == 0, "Unexpected JSON element count!");
+
+	JSON::Value nested = root["nestedArrays"_key];
+	for (usize depth = 0; depth < 4; ++depth)
+	{
+		VERIFY(nested.GetArray().GetCount() == 1, "Unexpected JSON element count!");
+		nested = nested.GetArray()[0];
+	}
+	VERIFY(nested.GetArray().GetCount() == 0, "Unexpected JSON element count!");
+}
+
+static void KeepsMemberOrderAndFindsEveryMember()
+{
+	// More members than are searched linearly, so lookups go through the member table.
+	static constexpr StringView text = R"({
+		"m0": 0, "m1": 1, "m2": 2, "m3": 3, "m4": 4, "m5": 5, "m6": 6, "m7": 7, "m8": 8, "m9": 9,
+		"m10": 10, "m11": 11, "m12": 12, "m13": 13, "m14": 14, "m15": 15, "m16": 16, "m17": 17, "m18": 18, "m19": 19
+	})"_view;
+
+	const JSON::Document document = JSON::Parse(text);
+	const JSON::Object root = document.GetRoot();
+	VERIFY(root.GetCount() == 20, "Unexpected JSON member count!");
+
+	char name[4];
+	usize memberIndex = 0;
+	for (const JSON::Member& member : root)
+	{
+		const usize nameLength = memberIndex < 10 ? 2 : 3;
+		name[0] = 'm';
+		name[1] = static_cast<char>(memberIndex < 10 ? '0' + memberIndex : '1');
+		name[2] = static_cast<char>('0' + memberIndex % 10);
+
+		VERIFY(member.GetName() == StringView(name, nameLength), "JSON members are out of order!");
+		VERIFY(member.Value.GetUnsigned() == memberIndex, "Unexpected JSON member value!");
+		VERIFY(root[JSON::Key(name, nameLength)].GetUnsigned() == memberIndex, "Failed to find JSON member!");
+		++memberIndex;
+	}
+
+	VERIFY(!root.TryGet("m20"_key) && !root.HasKey("m"_key) && !root.HasKey(""_key), "Found a JSON member that isn't there!");
+}
+
+static void DecodesEscapes()
+{
+	static constexpr StringView text = R"({ "escapes": "\"\\\/\b\f\n\r\t", "unicode": "\u0041\u00E9\u20AC\uD83D\uDE00", "key\u0041": 1 })"_view;
+
+	const JSON::Document document = JSON::Parse(text);
+	const JSON::Object root = document.GetRoot();
+	VerifyString(root["escapes"_key], "\"\\/\b\f\n\r\t"_view);
+	VerifyString(root["unicode"_key], "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"_view);
+	VERIFY(root["keyA"_key].GetUnsigned() == 1, "Failed to find escaped JSON key!");
+}
+
+static void CopiedStringsOutliveTheText()
+{
+	static constexpr StringView source = R"({ "plain": "plain text", "escaped": "line\nbreak", "array": ["one", "two"] })"_view;
+
+	char text[128];
+	CHECK(source.GetLength() <= sizeof(text));
+	Platform::MemoryCopy(text, source.GetData(), source.GetLength());
+
+	const JSON::Document document = JSON::Parse(StringView(text, source.GetLength()), JSON::StringMode::Copy);
+	Platform::MemorySet(text, ' ', source.GetLength());
+
+	const JSON::Object root = document.GetRoot();
+	VerifyString(root["plain"_key], "plain text"_view);
+	VerifyString(root["escaped"_key], "line\nbreak"_view);
+	VerifyString(root["array"_key].GetArray()[0], "one"_view);
+	VerifyString(root["array"_key].GetArray()[1], "two"_view);
+}
+
+static void ZeroCopyStringsPointIntoTheText()
+{
+	static constexpr StringView text = R"({ "plain": "plain text", "escaped": "line\nbreak" })"_view;
+
+	const JSON::Document document = JSON::Parse(text);
+	const JSON::Object root = document.GetRoot();
+
+	const char* plain = root["plain"_key].GetString().GetData();
+	VERIFY(plain >= text.GetData() && plain < text.GetData() + text.GetLength(), "Zero-copy JSON string was copied!");
+	VerifyString(root["escaped"_key], "line\nbreak"_view);
+}
+
+// Builds a root array of small objects, sized so that it is split over the workers when there are any.
+static String MakeObjectArrayText(usize objectCount)
+{
+	String text(objectCount * 64, JSON::Allocator);
+	text.Append(R"({ "objects": [)"_view);
+
+	char object[128] = {};
+	for (usize objectIndex = 0; objectIndex < objectCount; ++objectIndex)
+	{
+		Platform::StringPrint(R"(%s{ "index": %zu, "half": %zu.5, "name": "object%zu", "flag": %s })",
+							  object,
+							  sizeof(object),
+							  objectIndex == 0 ? "" : ",",
+							  objectIndex,
+							  objectIndex,
+							  objectIndex,
+							  objectIndex % 2 ? "true" : "false");
+		text.Append(StringView(object, Platform::StringLength(object)));
+	}
+	text.Append(R"(], "count": 1 })"_view);
+	return text;
+}
+
+static void BuildsLargeArraysInFull()
+{
+	static constexpr usize objectCount = 20000;
+	const String textStorage = MakeObjectArrayText(objectCount);
+	const StringView text = textStorage;
+
+	const JSON::Document document = JSON::Parse(text);
+	const JSON::Object root = document.GetRoot();
+	const JSON::Array objects = root["objects"_key].GetArray();
+	VERIFY(objects.GetCount() == objectCount, "Unexpected JSON element count!");
+
+	char name[32] = {};
+	for (usize objectIndex = 0; objectIndex < objectCount; ++objectIndex)
+	{
+		const JSON::Object object = objects[objectIndex].GetObject();
+		VERIFY(object["index"_key].GetUnsigned() == objectIndex, "Unexpected JSON integer!");
+		VERIFY(object["half"_key].GetDecimal() == static_cast<float64>(objectIndex) + 0.5, "Unexpected JSON decimal!");
+		VERIFY(object["flag"_key].GetBoolean() == (objectIndex % 2 == 1), "Unexpected JSON boolean!");
+
+		Platform::StringPrint("object%zu", name, sizeof(name), objectIndex);
+		VerifyString(object["name"_key], StringView(name, Platform::StringLength(name)));
+	}
+	VERIFY(root["count"_key].GetUnsigned() == 1, "Unexpected JSON integer!");
+}
+
+static void StoresDocumentsInFewAllocations()
+{
+	static constexpr usize objectCount = 20000;
+	const String textStorage = MakeObjectArrayText(objectCount);
+	const StringView text = textStorage;
+
+	const JSON::Document document = JSON::Parse(text);
+	const Arena& storage = document.GetStorage();
+
+	// Each object is one run of members, and zero-copy strings take no storage, so there is far less than one
+	// allocation per value.
+	static constexpr usize valueCount = objectCount * 5;
+	VERIFY(storage.GetAllocationCount() < valueCount / 4, "JSON document made too many allocations!");
+	VERIFY(storage.GetUsedSize() < text.GetLength() * 2, "JSON document used too much storage!");
+}
+
+// One past what fits in the 32-bit count of a value. Values only keep the pointer they are given, so nothing that large
+// has to exist.
+static constexpr usize TooLargeCount = static_cast<usize>(0xFFFFFFFF) + 1;
+
+static void MakeTooLargeObject()
+{
+	static const JSON::Member member = {};
+	const JSON::Value value(&member, TooLargeCount);
+}
+
+static void MakeTooLargeArray()
+{
+	static const JSON::Value element;
+	const JSON::Value value(&element, TooLargeCount);
+}
+
+static void MakeTooLongString()
+{
+	const JSON::Value value(StringView("", TooLargeCount));
+}
+
+static void RefusesCountsPastThirtyTwoBits()
+{
+	static const JSON::Value element;
+	VERIFY(JSON::Value(&element, TooLargeCount - 1).GetArray().GetCount() == TooLargeCount - 1, "Unexpected JSON element count!");
+
+	VERIFY(DoesFail("JSON too large object", MakeTooLargeObject), "JSON object member count was cut short!");
+	VERIFY(DoesFail("JSON too large array", MakeTooLargeArray), "JSON array element count was cut short!");
+	VERIFY(DoesFail("JSON too long string", MakeTooLongString), "JSON string length was cut short!");
+}
+
+// Checks that two documents hold the same values in the same order, and that every member of the batched one can be
+// found by its key, which only works if its keys were all moved over to the table of the document.
+static void VerifySameValue(const JSON::Value& serial, const JSON::Value& batched)
+{
+	VERIFY(serial.GetTag() == batched.GetTag(), "Batched JSON value has a different type!");
+	switch (serial.GetTag())
+	{
+	case JSON::Tag::Object:
+	{
+		const JSON::Object serialObject = serial.GetObject();
+		const JSON::Object batchedObject = batched.GetObject();
+		VERIFY(serialObject.GetCount() == batchedObject.GetCount(), "Batched JSON object has a different member count!");
+
+		const JSON::Member* batchedMember = batchedObject.begin();
+		for (const JSON::Member& serialMember : serialObject)
+		{
+			VERIFY(serialMember.GetName() == batchedMember->GetName(), "Batched JSON members are in a different order!");
+			VERIFY(batchedObject.TryGet(JSON::Key(batchedMember->GetName())) == &batchedMember->Value, "Batched JSON member can't be found!");
+			VerifySameValue(serialMember.Value, batchedMember->Value);
+			++batchedMember;
+		}
+		break;
+	}
+	case JSON::Tag::Array:
+	{
+		const JSON::Array serialArray = serial.GetArray();
+		const JSON::Array batchedArray = batched.GetArray();
+		VERIFY(serialArray.GetCount() == batchedArray.GetCount(), "Batched JSON array has a different element count!");
+		for (usize elementIndex = 0; elementIndex < serialArray.GetCount(); ++elementIndex)
+		{
+			VerifySameValue(serialArray[elementIndex], batchedArray[elementIndex]);
+		}
+		break;
+	}
+	case JSON::Tag::String:
+		VERIFY(serial.GetString() == batched.GetString(), "Batched JSON string differs!");
+		break;
+	case JSON::Tag::Integer:
+		VERIFY(serial.GetInteger() == batched.GetInteger(), "Batched JSON integer differs!");
+		break;
+	case JSON::Tag::Decimal:
+		VERIFY(serial.GetDecimal() == batched.GetDecimal(), "Batched JSON decimal differs!");
+		break;
+	case JSON::Tag::Boolean:
+		VERIFY(serial.GetBoolean() == batched.GetBoolean(), "Batched JSON boolean differs!");
+		break;
+	default:
+		break;
+	}
+}
+
+// Root arrays are built in batches whether or not there are job workers, which merges the key tables of the batches
+// and remaps the members whose keys another batch or the document had first. The arrays share keys with each other and
+// with the root, nest objects in their elements, and include an empty array and one too small to split.
+static void BuildsBatchedArraysLikeSerialOnes()
+{
+	static constexpr usize elementCount = 3000;
+
+	String text(elementCount * 160, JSON::Allocator);
+	text.Append(R"({ "name": "root", "empty": [], "small": [{ "name": "a" }, { "name": "b", "extra": 1 }], "accessors": [)"_view);
+	char element[192] = {};
+	for (usize elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+	{
+		// Later elements bring keys the earlier ones don't have, so that the batches don't all start out the same.
+		Platform::StringPrint(R"(%s{ "name": "accessor%zu", "count": %zu, "min": [%zu.5, -1], "extras": { "key%zu": { "name": true } } })",
+							  element,
+							  sizeof(element),
+							  elementIndex == 0 ? "" : ",",
+							  elementIndex,
+							  elementIndex * 3,
+							  elementIndex,
+							  elementIndex % 7);
+		text.Append(StringView(element, Platform::StringLength(element)));
+	}
+	text.Append(R"(], "nodes": [)"_view);
+	for (usize elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+	{
+		Platform::StringPrint(R"(%s{ "mesh": %zu, "children": [%zu, %zu], "name": "node%zu", "count": null })",
+							  element,
+							  sizeof(element),
+							  elementIndex == 0 ? "" : ",",
+							  elementIndex,
+							  elementIndex + 1,
+							  elementIndex + 2,
+							  elementIndex);
+		text.Append(StringView(element, Platform::StringLength(element)));
+	}
+	text.Append(R"(], "count": 2 })"_view);
+
+	const JSON::Document serial = JSON::Parse(text, JSON::StringMode::ZeroCopy, JSON::Batching::Never);
+	const JSON::Document batched = JSON::Parse(text, JSON::StringMode::ZeroCopy, JSON::Batching::Always);
+
+	const JSON::Object serialRoot = serial.GetRoot();
+	const JSON::Object batchedRoot = batched.GetRoot();
+	VERIFY(batchedRoot["accessors"_key].GetArray().GetCount() == elementCount, "Unexpected JSON element count!");
+	VerifySameValue(JSON::Value(serialRoot.begin(), serialRoot.GetCount()), JSON::Value(batchedRoot.begin(), batchedRoot.GetCount()));
+}
+
+static void IgnoresStructuralsInsideStrings()
+{
+	static constexpr StringView text = R"({ "brackets": "{[,:]}", "quoted": "\"{\"", "array": ["]", "}", ","], "after": 1 })"_view;
+
+	const JSON::Document document = JSON::Parse(text);
+	const JSON::Object root = document.GetRoot();
+	VERIFY(root.GetCount() == 4, "Unexpected JSON member count!");
+	VerifyString(root["brackets"_key], "{[,:]}"_view);
+	VerifyString(root["quoted"_key], "\"{\""_view);
+
+	const JSON::Array array = root["array"_key].GetArray();
+	VERIFY(array.GetCount() == 3, "Unexpected JSON element count!");
+	VerifyString(array[0], "]"_view);
+	VerifyString(array[1], "}"_view);
+	VerifyString(array[2], ","_view);
+	VERIFY(root["after"_key].GetUnsigned() == 1, "Unexpected JSON integer!");
+}
+
+// Moves the same text across two 64-byte blocks one byte at a time, so that each run of backslashes, each string and
+// each scalar starts and ends on every side of a block boundary.
+static void IndexesAcrossBlockBoundaries()
+{
+	static constexpr StringView body = R"("a": "x\\\"y", "b": "\\\\", "c": [true, false, null, 12345, -0.5], "d": "\\")"_view;
+	static constexpr usize maximumPadding = 130;
+
+	char text[maximumPadding + 128];
+	CHECK(body.GetLength() + maximumPadding + 3 <= sizeof(text));
+
+	for (usize padding = 0; padding <= maximumPadding; ++padding)
+	{
+		usize length = 0;
+		text[length++] = '{';
+		Platform::MemorySet(text + length, ' ', padding);
+		length += padding;
+		Platform::MemoryCopy(text + length, body.GetData(), body.GetLength());
+		length += body.GetLength();
+		text[length++] = '}';
+
+		const JSON::Document document = JSON::Parse(StringView(text, length));
+		const JSON::Object root = document.GetRoot();
+		VerifyString(root["a"_key], "x\\\"y"_view);
+		VerifyString(root["b"_key], "\\\\"_view);
+		VerifyString(root["d"_key], "\\"_view);
+
+		const JSON::Array array = root["c"_key].GetArray();
+		VERIFY(array.GetCount() == 5, "Unexpected JSON element count!");
+		VERIFY(array[0].GetBoolean() && !array[1].GetBoolean() && array[2].GetTag() == JSON::Tag::Null, "Unexpected JSON literal!");
+		VERIFY(array[3].GetInteger() == 12345 && array[4].GetDecimal() == -0.5, "Unexpected JSON number!");
+	}
+}
+
+static void ReadsFilesAcrossChunks()
+{
+	// A few chunks of the file reader, with strings and numbers landing on every side of the chunk boundaries.
+	static constexpr usize objectCount = 60000;
+	static constexpr const char* filePath = "JSONTestChunks.json";
+
+	const String textStorage = MakeObjectArrayText(objectCount);
+	const StringView text = textStorage;
+
+	FILE* file = fopen(filePath, "wb");
+	VERIFY(file, "Failed to open JSON test file!");
+	VERIFY(fwrite(text.GetData(), 1, text.GetLength(), file) == text.GetLength(), "Failed to write JSON test file!");
+	fclose(file);
+
+	{
+		const JSON::Document document = JSON::Load(StringView(filePath, Platform::StringLength(filePath)));
+		const JSON::Array objects = document.GetRoot()["objects"_key].GetArray();
+		VERIFY(objects.GetCount() == objectCount, "Unexpected JSON element count!");
+
+		char name[32] = {};
+		for (usize objectIndex = 0; objectIndex < objectCount; ++objectIndex)
+		{
+			const JSON::Object object = objects[objectIndex].GetObject();
+			VERIFY(object["index"_key].GetUnsigned() == objectIndex, "Unexpected JSON integer!");
+			VERIFY(object["half"_key].GetDecimal() == static_cast<float64>(objectIndex) + 0.5, "Unexpected JSON decimal!");
+
+			Platform::StringPrint("object%zu", name, sizeof(name), objectIndex);
+			VerifyString(object["name"_key], StringView(name, Platform::StringLength(name)));
+		}
+	}
+
+	remove(filePath);
+}
+
+static void ReaderSkipsNestedValues()
+{
+	static constexpr StringView text = R"({ "skipped": { "a": [1, { "b": "]}" }], "c": {} }, "kept": [1, 2], "last": "end" })"_view;
+
+	Arena storage(4096);
+	JSON::Reader reader(text.GetData(), text.GetLength(), &storage);
+	VERIFY(reader.NextToken() == JSON::Token::BeginObject, "Unexpected JSON token!");
+
+	VERIFY(reader.NextToken() == JSON::Token::Key && reader.IsKey("skipped"_key), "Unexpected JSON key!");
+	reader.SkipValue();
+
+	VERIFY(reader.NextToken() == JSON::Token::Key && reader.IsKey("kept"_key), "Unexpected JSON key!");
+	VERIFY(reader.NextToken() == JSON::Token::BeginArray, "Unexpected JSON token!");
+	for (int64 element = 1; element <= 2; ++element)
+	{
+		VERIFY(reader.NextToken() == JSON::Token::Value && reader.GetValue().GetInteger() == element, "Unexpected JSON element!");
+	}
+	VERIFY(reader.NextToken() == JSON::Token::EndArray, "Unexpected JSON token!");
+
+	VERIFY(reader.NextToken() == JSON::Token::Key && reader.GetKey() == "last"_view, "Unexpected JSON key!");
+	VERIFY(reader.NextToken() == JSON::Token::Value && reader.GetValue().GetString() == "end"_view, "Unexpected JSON value!");
+	VERIFY(reader.NextToken() == JSON::Token::EndObject, "Unexpected JSON token!");
+	VERIFY(reader.NextToken() == JSON::Token::End, "Unexpected JSON token!");
+}
+
+// Reads a manifest from a file the way the scene loader does, dispatching on key hashes and skipping the extras and
+// extensions, which are large enough to span several chunks of the file reader.
+static void ReaderFindsMembersPastSkippedSubtrees()
+{
+	static constexpr usize extrasObjectCount = 60000;
+	static constexpr const char* filePath = "JSONTestSkips.json";
+
+	String text(extrasObjectCount * 64, JSON::Allocator);
+	text.Append(R"({ "extras": )"_view);
+	text.Append(MakeObjectArrayText(extrasObjectCount));
+	text.Append(R"(, "extensions": { "a": [[[{ "b": [] }]]], "c": "}]" }, "na\u006De": "scene", "nodes": [10, 20, 30] })"_view);
+
+	FILE* file = fopen(filePath, "wb");
+	VERIFY(file, "Failed to open JSON test file!");
+	VERIFY(fwrite(text.GetData(), 1, text.GetLength(), file) == text.GetLength(), "Failed to write JSON test file!");
+	fclose(file);
+
+	{
+		Arena storage(MB(1));
+		JSON::Reader reader(StringView(filePath, Platform::StringLength(filePath)), &storage);
+
+		bool hasName = false;
+		usize nodeCount = 0;
+		usize skippedCount = 0;
+		VERIFY(reader.NextToken() == JSON::Token::BeginObject, "Unexpected JSON token!");
+		while (reader.NextToken() != JSON::Token::EndObject)
+		{
+			VERIFY(!reader.IsKey("missing"_key), "Found a JSON key that isn't there!");
+
+			switch (reader.GetKeyHash())
+			{
+			// The key is written with an escape, and is matched once decoded.
+			case "name"_key.GetHash():
+				VERIFY(reader.IsKey("name"_key), "Escaped JSON key wasn't decoded!");
+				VERIFY(reader.NextToken() == JSON::Token::Value && reader.GetValue().GetString() == "scene"_view, "Unexpected JSON value!");
+				hasName = true;
+				break;
+			case "nodes"_key.GetHash():
+				VERIFY(reader.IsKey("nodes"_key), "Unexpected JSON key!");
+				VERIFY(reader.NextToken() == JSON::Token::BeginArray, "Unexpected JSON token!");
+				for (JSON::Token token = reader.NextToken(); token != JSON::Token::EndArray; token = reader.NextToken())
+				{
+					VERIFY(token == JSON::Token::Value && reader.GetValue().GetUnsigned() == (nodeCount + 1) * 10, "Unexpected JSON element!");
+					++nodeCount;
+				}
+				break;
+			default:
+				reader.SkipValue();
+				++skippedCount;
+				break;
+			}
+		}
+		VERIFY(reader.NextToken() == JSON::Token::End, "Unexpected JSON token!");
+
+		VERIFY(hasName, "JSON member after skipped subtrees wasn't found!");
+		// Reading past the last element ends the array instead of running into the object.
+		VERIFY(nodeCount == 3, "Unexpected JSON element count!");
+		VERIFY(skippedCount == 2, "Unexpected count of skipped JSON members!");
+	}
+
+	remove(filePath);
+}
+
+static JSON::Value ParseNumber(StringView number, Arena* storage)
+{
+	char text[128];
+	CHECK(number.GetLength() + 2 <= sizeof(text));
+	text[0] = '[';
+	Platform::MemoryCopy(text + 1, number.GetData(), number.GetLength());
+	text[number.GetLength() + 1] = ']';
+
+	JSON::Reader reader(text, number.GetLength() + 2, storage);
+	VERIFY(reader.NextToken() == JSON::Token::BeginArray, "Unexpected JSON token!");
+	VERIFY(reader.NextToken() == JSON::Token::Value, "Unexpected JSON token!");
+	return reader.GetValue();
+}
+
+static uint64 ToBits(float64 decimal)
+{
+	uint64 bits;
+	Platform::MemoryCopy(&bits, &decimal, sizeof(bits));
+	return bits;
+}
+
+static void VerifyDecimal(StringView number, float64 expected, Arena* storage)
+{
+	const JSON::Value value = ParseNumber(number, storage);
+	VERIFY(value.GetTag() == JSON::Tag::Decimal, "Expected a JSON decimal!");
+	VERIFY(ToBits(value.GetDecimal()) == ToBits(expected), "JSON decimal isn't correctly rounded!");
+}
+
+static void KeepsIntegersExact()
+{
+	Arena storage(4096);
+
+	struct IntegerCase
+	{
+		StringView Text;
+		int64 Expected;
+	};
+	static constexpr IntegerCase integerCases[] =
+	{
+		{ "0"_view, 0 },
+		{ "42"_view, 42 },
+		{ "-1"_view, -1 },
+		{ "9007199254740993"_view, 9007199254740993ll },
+		{ "9223372036854775807"_view, 0x7FFFFFFFFFFFFFFFll },
+		{ "-9223372036854775808"_view, static_cast<int64>(0x8000000000000000ull) },
+	};
+	for (const IntegerCase& integerCase : integerCases)
+	{
+		const JSON::Value value = ParseNumber(integerCase.Text, &storage);
+		VERIFY(value.GetTag() == JSON::Tag::Integer && value.GetInteger() == integerCase.Expected, "Unexpected JSON integer!");
+	}
+
+	// Past the int64 range, and anything with a fraction or an exponent, is a decimal.
+	VerifyDecimal("9223372036854775808"_view, 9223372036854775808.0, &storage);
+	VerifyDecimal("-9223372036854775809"_view, -9223372036854775809.0, &storage);
+	VerifyDecimal("123456789012345678901234567890"_view, 123456789012345678901234567890.0, &storage);
+	VerifyDecimal("1.0"_view, 1.0, &storage);
+	VerifyDecimal("1e2"_view, 100.0, &storage);
+	VerifyDecimal("1E+2"_view, 100.0, &storage);
+
+	// -0 has no integer representation, so it keeps its sign as a decimal.
+	VerifyDecimal("-0"_view, -0.0, &storage);
+	VerifyDecimal("-0.0"_view, -0.0, &storage);
+}
+
+static void RoundsDecimalsCorrectly()
+{
+	Arena storage(4096);
+
+	struct DecimalCase
+	{
+		StringView Text;
+		float64 Expected;
+	};
+	static constexpr DecimalCase decimalCases[] =
+	{
+		{ "0.1"_view, 0.1 },
+		{ "0.30000000000000004"_view, 0.30000000000000004 },
+		{ "3.141592653589793238462643383279"_view, 3.141592653589793238462643383279 },
+		{ "1e22"_view, 1e22 },
+		{ "1e23"_view, 1e23 },
+		{ "1e308"_view, 1e308 },
+		{ "1.7976931348623157e308"_view, DBL_MAX },
+		{ "2.2250738585072014e-308"_view, DBL_MIN },
+		{ "2.2250738585072011e-308"_view, 2.2250738585072011e-308 },
+		{ "4.9406564584124654e-324"_view, 4.9406564584124654e-324 },
+		{ "2.4703282292062328e-324"_view, 4.9406564584124654e-324 },
+		{ "2.4703282292062327e-324"_view, 0.0 },
+		{ "1e-400"_view, 0.0 },
+		{ "0e999999"_view, 0.0 },
+		{ "123.456e-2"_view, 1.23456 },
+		{ "-65.613616999999977"_view, -65.613616999999977 },
+
+		// Halfway between two doubles, which rounds to the even one, and just past halfway.
+		{ "9007199254740993.0"_view, 9007199254740992.0 },
+		{ "9007199254740995.0"_view, 9007199254740996.0 },
+		{ "1.00000000000000011102230246251565404236316680908203125"_view, 1.0 },
+		{ "1.00000000000000011102230246251565404236316680908203126"_view, 1.0000000000000002 },
+
+		// More digits than fit in the mantissa.
+		{ "0.1000000000000000055511151231257827021181583404541015625"_view, 0.1 },
+		{ "0.000000000000000000000000000000000000001234567890123456789012"_view, 1.234567890123456789012e-39 },
+	};
+	for (const DecimalCase& decimalCase : decimalCases)
+	{
+		VerifyDecimal(decimalCase.Text, decimalCase.Expected, &storage);
+	}
+
+	// Magnitudes past the largest double go to infinity, as with strtod.
+	VerifyDecimal("1e400"_view, HUGE_VAL, &storage);
+	VerifyDecimal("-1e999999999999"_view, -HUGE_VAL, &storage);
+}
+
+// Numbers with more digits than fit in the mantissa are read by strtod, which would stop at the dot under a locale with
+// a decimal comma. Such a locale is only tried when the system has one.
+static void ReadsDecimalsUnderAnyLocale()
+{
+	static constexpr const char* commaLocales[] = { "de_DE.UTF-8", "de_DE", "fr_FR.UTF-8", "fr_FR", "German_Germany.1252" };
+
+	Arena storage(4096);
+	for (const char* commaLocale : commaLocales)
+	{
+		if (setlocale(LC_NUMERIC, commaLocale))
+		{
+			break;
+		}
+	}
+
+	VerifyDecimal("3.141592653589793238462643383279"_view, 3.141592653589793238462643383279, &storage);
+	VerifyDecimal("-0.1000000000000000055511151231257827021181583404541015625"_view, -0.1, &storage);
+	VerifyDecimal("123456789012345678901.5e-3"_view, 123456789012345678901.5e-3, &storage);
+
+	setlocale(LC_NUMERIC, "C");
+}
+
+// Random finite doubles, printed with enough digits to identify them, have to read back bit for bit.
+static void RoundTripsRandomDecimals()
+{
+	static constexpr usize decimalCount = 200000;
+
+	Arena storage(MB(1));
+	uint64 state = 0x9E3779B97F4A7C15ull;
+	char text[64] = {};
+	for (usize decimalIndex = 0; decimalIndex < decimalCount; ++decimalIndex)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+
+		float64 decimal;
+		Platform::MemoryCopy(&decimal, &state, sizeof(decimal));
+		if (!isfinite(decimal))
+		{
+			continue;
+		}
+
+		// Every other value is printed with fewer digits, so rounding to the nearest double is covered too.
+		const bool shortened = decimalIndex % 2 == 1;
+		Platform::StringPrint(shortened ? "%.15g" : "%.17g", text, sizeof(text), decimal);
+		const StringView number(text, Platform::StringLength(text));
+
+		float64 expected = decimal;
+		if (shortened)
+		{
+			expected = strtod(text, nullptr);
+		}
+
+		const JSON::Value value = ParseNumber(number, &storage);
+		storage.Reset();
+		if (value.GetTag() == JSON::Tag::Integer)
+		{
+			VERIFY(static_cast<float64>(value.GetInteger()) == expected, "JSON integer doesn't round-trip!");
+			continue;
+		}
+		VERIFY(ToBits(value.GetDecimal()) == ToBits(expected), "JSON decimal doesn't round-trip!");
+	}
+}
+
+void RunJSONTests()
+{
+	static constexpr Test tests[] =
+	{
+		{ "Parses every value type", ParsesEveryValueType },
+		{ "Keeps member order and finds every member", KeepsMemberOrderAndFindsEveryMember },
+		{ "Decodes escapes", DecodesEscapes },
+		{ "Copied strings outlive the text", CopiedStringsOutliveTheText },
+		{ "Zero-copy strings point into the text", ZeroCopyStringsPointIntoTheText },
+		{ "Builds large arrays in full", BuildsLargeArraysInFull },
+		{ "Stores documents in few allocations", StoresDocumentsInFewAllocations },
+		{ "Refuses counts past 32 bits", RefusesCountsPastThirtyTwoBits },
+		{ "Builds batched arrays like serial ones", BuildsBatchedArraysLikeSerialOnes },
+		{ "Ignores structurals inside strings", IgnoresStructuralsInsideStrings },
+		{ "Indexes across block boundaries", IndexesAcrossBlockBoundaries },
+		{ "Reads files across chunks", ReadsFilesAcrossChunks },
+		{ "Reader skips nested values", ReaderSkipsNestedValues },
+		{ "Reader finds members past skipped subtrees", ReaderFindsMembersPastSkippedSubtrees },
+		{ "Keeps integers exact", KeepsIntegersExact },
+		{ "Rounds decimals correctly", RoundsDecimalsCorrectly },
+		{ "Reads decimals under any locale", ReadsDecimalsUnderAnyLocale },
+		{ "Round-trips random decimals", RoundTripsRandomDecimals },
+	};
+	RunTests("JSON", tests);
+}
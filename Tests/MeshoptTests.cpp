@@ -0,0 +1,382 @@
+#include "Meshopt.hpp"
+#include "Test.hpp"
+
+#include "Luft/Array.hpp"
+
+#include <math.h>
+
+static Allocator* Allocator = &GlobalAllocator::Get();
+
+template<usize IndexCount>
+static void VerifyIndices(const uint32 (&indices)[IndexCount], const uint32 (&expected)[IndexCount])
+{
+	for (usize indexIndex = 0; indexIndex < IndexCount; ++indexIndex)
+	{
+		VERIFY(indices[indexIndex] == expected[indexIndex], "Unexpected meshopt index!");
+	}
+}
+
+static void DecodesTriangles()
+{
+	// A triangle of three new vertices from the first code table entry, then one on its last edge with a new vertex.
+	static constexpr uint8 encoded[] =
+	{
+		0xE1,
+		0xF0, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	};
+
+	uint32 indices[6];
+	Meshopt::Decode(reinterpret_cast<uint8*>(indices), ARRAY_COUNT(indices), sizeof(uint32), Meshopt::Mode::Triangles, Meshopt::Filter::None, encoded, sizeof(encoded));
+	static constexpr uint32 expected[] = { 0, 1, 2, 0, 2, 3 };
+	VerifyIndices(indices, expected);
+
+	uint16 narrowIndices[6];
+	Meshopt::Decode(reinterpret_cast<uint8*>(narrowIndices), ARRAY_COUNT(narrowIndices), sizeof(uint16), Meshopt::Mode::Triangles, Meshopt::Filter::None, encoded, sizeof(encoded));
+	for (usize indexIndex = 0; indexIndex < ARRAY_COUNT(narrowIndices); ++indexIndex)
+	{
+		VERIFY(narrowIndices[indexIndex] == indices[indexIndex], "Unexpected meshopt index!");
+	}
+}
+
+static void DecodesExplicitTriangleIndices()
+{
+	// Every index is stored as a zigzag delta from the last one: 0 + 5, 5 + 2 and 7 - 1.
+	static constexpr uint8 encoded[] =
+	{
+		0xE1,
+		0xFF,
+		0xFF, 0x0A, 0x04, 0x01,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	};
+
+	uint32 indices[3];
+	Meshopt::Decode(reinterpret_cast<uint8*>(indices), ARRAY_COUNT(indices), sizeof(uint32), Meshopt::Mode::Triangles, Meshopt::Filter::None, encoded, sizeof(encoded));
+	static constexpr uint32 expected[] = { 5, 7, 6 };
+	VerifyIndices(indices, expected);
+}
+
+static void DecodesIndexSequences()
+{
+	// Deltas of 0, 1, 1 and 998 from the first baseline, the last of which takes two bytes.
+	static constexpr uint8 encoded[] =
+	{
+		0xD1,
+		0x00, 0x04, 0x04, 0x98, 0x1F,
+		0x00, 0x00, 0x00, 0x00,
+	};
+
+	uint32 indices[4];
+	Meshopt::Decode(reinterpret_cast<uint8*>(indices), ARRAY_COUNT(indices), sizeof(uint32), Meshopt::Mode::Indices, Meshopt::Filter::None, encoded, sizeof(encoded));
+	static constexpr uint32 expected[] = { 0, 1, 2, 1000 };
+	VerifyIndices(indices, expected);
+}
+
+static constexpr usize ByteGroupSize = 16;
+
+static uint8 ZigzagDelta(uint8 value, uint8 previous)
+{
+	const int8 delta = static_cast<int8>(value - previous);
+	return static_cast<uint8>((delta << 1) ^ (delta >> 7));
+}
+
+// Packs sixteen deltas into fields of the given width, most significant first, followed by the whole bytes of the ones
+// that don't fit.
+static void EncodeByteGroup(const uint8* deltas, usize bits, Array<uint8>* output)
+{
+	const uint8 escape = static_cast<uint8>((1 << bits) - 1);
+
+	const usize packedStart = output->GetCount();
+	for (usize byteIndex = 0; byteIndex < ByteGroupSize * bits / 8; ++byteIndex)
+	{
+		output->Add(0);
+	}
+	for (usize fieldIndex = 0; fieldIndex < ByteGroupSize; ++fieldIndex)
+	{
+		const uint8 field = Min(deltas[fieldIndex], escape);
+		const usize bitOffset = fieldIndex * bits;
+		(*output)[packedStart + bitOffset / 8] |= static_cast<uint8>(field << (8 - bits - bitOffset % 8));
+	}
+	for (usize fieldIndex = 0; fieldIndex < ByteGroupSize; ++fieldIndex)
+	{
+		if (deltas[fieldIndex] >= escape)
+		{
+			output->Add(deltas[fieldIndex]);
+		}
+	}
+}
+
+static usize GetEncodedGroupSize(const uint8* deltas, usize bitsLog2)
+{
+	if (bitsLog2 == 0)
+	{
+		for (usize fieldIndex = 0; fieldIndex < ByteGroupSize; ++fieldIndex)
+		{
+			if (deltas[fieldIndex] != 0)
+			{
+				return INDEX_NONE;
+			}
+		}
+		return 0;
+	}
+	if (bitsLog2 == 3)
+	{
+		return ByteGroupSize;
+	}
+
+	const usize bits = usize { 1 } << bitsLog2;
+	const uint8 escape = static_cast<uint8>((1 << bits) - 1);
+	usize size = ByteGroupSize * bits / 8;
+	for (usize fieldIndex = 0; fieldIndex < ByteGroupSize; ++fieldIndex)
+	{
+		size += deltas[fieldIndex] >= escape;
+	}
+	return size;
+}
+
+// A minimal encoder for the vertex codec, which picks the smallest of the four group widths, so that every one of them
+// is decoded.
+static Array<uint8> EncodeVertices(const uint8* vertices, usize count, usize stride)
+{
+	static constexpr usize blockSizeBytes = 8192;
+	static constexpr usize blockMaxSize = 256;
+	static constexpr usize tailMinimumSize = 32;
+
+	const usize blockSize = Min((blockSizeBytes / stride) & ~(ByteGroupSize - 1), blockMaxSize);
+
+	Array<uint8> output(Allocator);
+	output.Add(0xA0);
+
+	// Deltas start from a baseline vertex stored in the tail, which is the first vertex.
+	Array<uint8> previous(stride, Allocator);
+	for (usize byteIndex = 0; byteIndex < stride; ++byteIndex)
+	{
+		previous.Add(count ? vertices[byteIndex] : 0);
+	}
+	Array<uint8> baseline(stride, Allocator);
+	for (const uint8 byte : previous)
+	{
+		baseline.Add(byte);
+	}
+
+	for (usize first = 0; first < count; first += blockSize)
+	{
+		const usize blockCount = Min(blockSize, count - first);
+		const usize alignedCount = NextMultipleOf(blockCount, ByteGroupSize);
+		const usize groupCount = alignedCount / ByteGroupSize;
+
+		for (usize byteIndex = 0; byteIndex < stride; ++byteIndex)
+		{
+			uint8 deltas[blockMaxSize] = {};
+			for (usize vertexIndex = 0; vertexIndex < blockCount; ++vertexIndex)
+			{
+				const uint8 value = vertices[(first + vertexIndex) * stride + byteIndex];
+				deltas[vertexIndex] = ZigzagDelta(value, previous[byteIndex]);
+				previous[byteIndex] = value;
+			}
+
+			const usize headerStart = output.GetCount();
+			for (usize headerIndex = 0; headerIndex < (groupCount + 3) / 4; ++headerIndex)
+			{
+				output.Add(0);
+			}
+
+			for (usize groupIndex = 0; groupIndex < groupCount; ++groupIndex)
+			{
+				const uint8* groupDeltas = deltas + groupIndex * ByteGroupSize;
+
+				usize bestBitsLog2 = 3;
+				for (usize bitsLog2 = 0; bitsLog2 < 3; ++bitsLog2)
+				{
+					if (GetEncodedGroupSize(groupDeltas, bitsLog2) < GetEncodedGroupSize(groupDeltas, bestBitsLog2))
+					{
+						bestBitsLog2 = bitsLog2;
+					}
+				}
+				output[headerStart + groupIndex / 4] |= static_cast<uint8>(bestBitsLog2 << ((groupIndex % 4) * 2));
+
+				if (bestBitsLog2 == 1 || bestBitsLog2 == 2)
+				{
+					EncodeByteGroup(groupDeltas, usize { 1 } << bestBitsLog2, &output);
+				}
+				else if (bestBitsLog2 == 3)
+				{
+					for (usize fieldIndex = 0; fieldIndex < ByteGroupSize; ++fieldIndex)
+					{
+						output.Add(groupDeltas[fieldIndex]);
+					}
+				}
+			}
+		}
+	}
+
+	const usize tailSize = Max(stride, tailMinimumSize);
+	for (usize paddingIndex = 0; paddingIndex < tailSize - stride; ++paddingIndex)
+	{
+		output.Add(0);
+	}
+	for (const uint8 byte : baseline)
+	{
+		output.Add(byte);
+	}
+	return output;
+}
+
+static void DecodesVertices()
+{
+	struct VertexCase
+	{
+		usize Count;
+		usize Stride;
+	};
+	static constexpr VertexCase vertexCases[] =
+	{
+		{ 1, 4 },
+		{ 17, 8 },
+		{ 1000, 12 },
+		{ 700, 16 },
+		{ 300, 64 },
+	};
+
+	uint32 state = 0x12345678;
+	for (const VertexCase& vertexCase : vertexCases)
+	{
+		const usize size = vertexCase.Count * vertexCase.Stride;
+
+		// Smooth positions in the low bytes, with noise in the high ones, so that every group width is picked somewhere.
+		Array<uint8> vertices(size, Allocator);
+		for (usize byteIndex = 0; byteIndex < size; ++byteIndex)
+		{
+			state = state * 1664525u + 1013904223u;
+			const usize vertexIndex = byteIndex / vertexCase.Stride;
+			const usize channel = byteIndex % vertexCase.Stride;
+			uint8 byte = 0;
+			if (channel % 4 == 0)
+			{
+				byte = static_cast<uint8>(vertexIndex);
+			}
+			else if (channel % 4 == 1)
+			{
+				byte = static_cast<uint8>(vertexIndex / 8 + (state >> 30));
+			}
+			else if (channel % 4 == 2)
+			{
+				byte = static_cast<uint8>(state >> 24);
+			}
+			vertices.Add(byte);
+		}
+
+		const Array<uint8> encoded = EncodeVertices(vertices.GetData(), vertexCase.Count, vertexCase.Stride);
+
+		Array<uint8> decoded(size, Allocator);
+		decoded.AddUninitialized(size);
+		Meshopt::Decode(decoded.GetData(), vertexCase.Count, vertexCase.Stride, Meshopt::Mode::Attributes, Meshopt::Filter::None, encoded.GetData(), encoded.GetCount());
+
+		for (usize byteIndex = 0; byteIndex < size; ++byteIndex)
+		{
+			VERIFY(decoded[byteIndex] == vertices[byteIndex], "Meshopt vertex doesn't decode back!");
+		}
+	}
+}
+
+template<typename T>
+static void DecodeFiltered(T* elements, usize count, usize stride, Meshopt::Filter filter)
+{
+	const Array<uint8> encoded = EncodeVertices(reinterpret_cast<const uint8*>(elements), count, stride);
+	Meshopt::Decode(reinterpret_cast<uint8*>(elements), count, stride, Meshopt::Mode::Attributes, filter, encoded.GetData(), encoded.GetCount());
+}
+
+static int32 EncodeExponential(int32 exponent, int32 mantissa)
+{
+	return static_cast<int32>((static_cast<uint32>(exponent) << 24) | (static_cast<uint32>(mantissa) & 0xFFFFFF));
+}
+
+static void UndoesTheExponentialFilter()
+{
+	int32 values[] =
+	{
+		EncodeExponential(-2, 6),
+		EncodeExponential(3, -5),
+		EncodeExponential(0, 0),
+		EncodeExponential(-10, 1024),
+	};
+	DecodeFiltered(values, ARRAY_COUNT(values), sizeof(int32), Meshopt::Filter::Exponential);
+
+	static constexpr float32 expected[] = { 1.5f, -40.0f, 0.0f, 1.0f };
+	for (usize valueIndex = 0; valueIndex < ARRAY_COUNT(values); ++valueIndex)
+	{
+		float32 value;
+		Platform::MemoryCopy(&value, &values[valueIndex], sizeof(value));
+		VERIFY(value == expected[valueIndex], "Unexpected meshopt exponential value!");
+	}
+}
+
+static void UndoesTheOctahedralFilter()
+{
+	int8 normals[][4] =
+	{
+		{ 0, 0, 127, 11 },
+		{ 127, 0, 127, 22 },
+		{ 0, -127, 127, 33 },
+		{ 64, 64, 127, 44 },
+		{ -100, 27, 127, 55 },
+	};
+	DecodeFiltered(normals, ARRAY_COUNT(normals), sizeof(normals[0]), Meshopt::Filter::Octahedral);
+
+	VERIFY(normals[0][0] == 0 && normals[0][1] == 0 && normals[0][2] == 127, "Unexpected meshopt octahedral normal!");
+	VERIFY(normals[1][0] == 127 && normals[1][1] == 0 && normals[1][2] == 0, "Unexpected meshopt octahedral normal!");
+	VERIFY(normals[2][0] == 0 && normals[2][1] == -127 && normals[2][2] == 0, "Unexpected meshopt octahedral normal!");
+
+	// Past the edge of the octahedron, the vector folds over to the lower half.
+	VERIFY(normals[3][0] > 0 && normals[3][1] > 0 && normals[3][2] < 0, "Unexpected meshopt octahedral normal!");
+
+	for (usize normalIndex = 0; normalIndex < ARRAY_COUNT(normals); ++normalIndex)
+	{
+		const float32 x = normals[normalIndex][0];
+		const float32 y = normals[normalIndex][1];
+		const float32 z = normals[normalIndex][2];
+		VERIFY(fabsf(sqrtf(x * x + y * y + z * z) - 127.0f) < 1.5f, "Meshopt octahedral normal isn't unit length!");
+		VERIFY(normals[normalIndex][3] == static_cast<int8>(11 * (normalIndex + 1)), "Meshopt octahedral filter changed the fourth component!");
+	}
+}
+
+static void UndoesTheQuaternionFilter()
+{
+	// The fourth component holds the index of the component left out in its low bits.
+	int16 rotations[][4] =
+	{
+		{ 0, 0, 0, 3 },
+		{ 0, 0, 0, 0 },
+		{ 0, 0, 0, 1 },
+	};
+	DecodeFiltered(rotations, ARRAY_COUNT(rotations), sizeof(rotations[0]), Meshopt::Filter::Quaternion);
+
+	static constexpr int16 expected[][4] =
+	{
+		{ 0, 0, 0, 32767 },
+		{ 32767, 0, 0, 0 },
+		{ 0, 32767, 0, 0 },
+	};
+	for (usize rotationIndex = 0; rotationIndex < ARRAY_COUNT(rotations); ++rotationIndex)
+	{
+		for (usize componentIndex = 0; componentIndex < 4; ++componentIndex)
+		{
+			VERIFY(rotations[rotationIndex][componentIndex] == expected[rotationIndex][componentIndex], "Unexpected meshopt quaternion!");
+		}
+	}
+}
+
+void RunMeshoptTests()
+{
+	static constexpr Test tests[] =
+	{
+		{ "Decodes triangles", DecodesTriangles },
+		{ "Decodes explicit triangle indices", DecodesExplicitTriangleIndices },
+		{ "Decodes index sequences", DecodesIndexSequences },
+		{ "Decodes vertices", DecodesVertices },
+		{ "Undoes the exponential filter", UndoesTheExponentialFilter },
+		{ "Undoes the octahedral filter", UndoesTheOctahedralFilter },
+		{ "Undoes the quaternion filter", UndoesTheQuaternionFilter },
+	};
+	RunTests("Meshopt", tests);
+}
@@ -0,0 +1,17 @@
+#include "Jobs.hpp"
+#include "Test.hpp"
+
+void Start()
+{
+	Jobs::Init(Jobs::GetDefaultWorkerCount());
+
+	RunArenaTests();
+	RunJSONTests();
+	RunWriterTests();
+	RunMeshoptTests();
+	RunGLTFTests();
+
+	Jobs::Shutdown();
+
+	Platform::Log("All tests passed\n");
+}
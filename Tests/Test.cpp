@@ -0,0 +1,79 @@
+#include "Test.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+// Windows can't fork, so the test executable runs itself again with the name of the failure test in its environment.
+// The copy runs every test up to that one, skipping the other failure tests, and then runs only its function.
+static constexpr const char* FailureTestVariable = "HUMMINGBIRD_FAILURE_TEST";
+
+bool DoesFail(const char* name, void (*function)())
+{
+	char runningName[256];
+	const DWORD runningNameLength = GetEnvironmentVariableA(FailureTestVariable, runningName, sizeof(runningName));
+	if (runningNameLength != 0 && runningNameLength < sizeof(runningName))
+	{
+		if (strcmp(runningName, name) != 0)
+		{
+			return true;
+		}
+		function();
+		ExitProcess(0);
+	}
+
+	char executablePath[MAX_PATH];
+	const DWORD executablePathLength = GetModuleFileNameA(nullptr, executablePath, sizeof(executablePath));
+	VERIFY(executablePathLength != 0 && executablePathLength < sizeof(executablePath), "Failed to find the test executable!");
+
+	VERIFY(SetEnvironmentVariableA(FailureTestVariable, name), "Failed to name the failure test!");
+	STARTUPINFOA startupInfo = {};
+	startupInfo.cb = sizeof(startupInfo);
+	PROCESS_INFORMATION processInfo = {};
+	const BOOL started = CreateProcessA(executablePath, nullptr, nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startupInfo, &processInfo);
+	SetEnvironmentVariableA(FailureTestVariable, nullptr);
+	VERIFY(started, "Failed to start the failure test!");
+
+	WaitForSingleObject(processInfo.hProcess, INFINITE);
+	DWORD exitCode = 0;
+	GetExitCodeProcess(processInfo.hProcess, &exitCode);
+	CloseHandle(processInfo.hThread);
+	CloseHandle(processInfo.hProcess);
+
+	return exitCode != 0;
+}
+
+#else
+
+bool DoesFail(const char* name, void (*function)())
+{
+	(void)name;
+
+	// Anything still buffered would otherwise be written twice.
+	fflush(stdout);
+	fflush(stderr);
+
+	const pid_t child = fork();
+	VERIFY(child >= 0, "Failed to start the failure test!");
+	if (child == 0)
+	{
+		function();
+		_exit(0);
+	}
+
+	int status = 0;
+	VERIFY(waitpid(child, &status, 0) == child, "Failed to wait for the failure test!");
+	return !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+}
+
+#endif
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Luft/Base.hpp"
+#include "Luft/Platform.hpp"
+
+struct Test
+{
+	const char* Name;
+	void (*Function)();
+};
+
+// Checks fail through VERIFY, which stops the whole run, so every test that returns has passed.
+template<usize TestCount>
+void RunTests(const char* suiteName, const Test (&tests)[TestCount])
+{
+	for (const Test& test : tests)
+	{
+		Platform::LogFormatted("%s: %s\n", suiteName, test.Name);
+		test.Function();
+	}
+}
+
+// Runs the function in a process of its own and tells whether it failed, which is how checks that VERIFY fires are
+// written. The name has to be unique among the failure tests.
+bool DoesFail(const char* name, void (*function)());
+
+void RunArenaTests();
+void RunGLTFTests();
+void RunJSONTests();
+void RunMeshoptTests();
+void RunWriterTests();
@@ -0,0 +1,328 @@
+#include "JSON.hpp"
+#include "Test.hpp"
+
+#include <math.h>
+
+static uint64 ToBits(float64 decimal)
+{
+	uint64 bits;
+	Platform::MemoryCopy(&bits, &decimal, sizeof(bits));
+	return bits;
+}
+
+static bool AreValuesEqual(const JSON::Value& a, const JSON::Value& b)
+{
+	if (a.GetTag() != b.GetTag())
+	{
+		return false;
+	}
+
+	switch (a.GetTag())
+	{
+	case JSON::Tag::Object:
+	{
+		const JSON::Object objectA = a.GetObject();
+		const JSON::Object objectB = b.GetObject();
+		if (objectA.GetCount() != objectB.GetCount())
+		{
+			return false;
+		}
+		for (usize memberIndex = 0; memberIndex < objectA.GetCount(); ++memberIndex)
+		{
+			const JSON::Member& memberA = objectA.begin()[memberIndex];
+			const JSON::Member& memberB = objectB.begin()[memberIndex];
+			if (!(memberA.GetName() == memberB.GetName()) || !AreValuesEqual(memberA.Value, memberB.Value))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	case JSON::Tag::Array:
+	{
+		const JSON::Array arrayA = a.GetArray();
+		const JSON::Array arrayB = b.GetArray();
+		if (arrayA.GetCount() != arrayB.GetCount())
+		{
+			return false;
+		}
+		for (usize elementIndex = 0; elementIndex < arrayA.GetCount(); ++elementIndex)
+		{
+			if (!AreValuesEqual(arrayA[elementIndex], arrayB[elementIndex]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	case JSON::Tag::String:
+		return a.GetString() == b.GetString();
+	case JSON::Tag::Decimal:
+		return ToBits(a.GetDecimal()) == ToBits(b.GetDecimal());
+	case JSON::Tag::Integer:
+		return a.GetInteger() == b.GetInteger();
+	case JSON::Tag::Boolean:
+		return a.GetBoolean() == b.GetBoolean();
+	case JSON::Tag::Null:
+		return true;
+	default:
+		CHECK(false);
+		return false;
+	}
+}
+
+static void WriteSmallDocument(JSON::Writer* writer)
+{
+	writer->BeginObject();
+	writer->WriteKey("a"_view);
+	writer->WriteInteger(1);
+	writer->WriteKey("b"_view);
+	writer->BeginArray();
+	writer->WriteBoolean(true);
+	writer->WriteBoolean(false);
+	writer->WriteNull();
+	writer->EndArray();
+	writer->WriteKey("c"_view);
+	writer->WriteString("x"_view);
+	writer->WriteKey("d"_view);
+	writer->WriteDecimal(0.5);
+	writer->WriteKey("e"_view);
+	writer->BeginObject();
+	writer->EndObject();
+	writer->WriteKey("f"_view);
+	writer->BeginArray();
+	writer->EndArray();
+	writer->EndObject();
+}
+
+static void WritesCompactText()
+{
+	JSON::Writer writer(JSON::Format::Compact);
+	WriteSmallDocument(&writer);
+	VERIFY(writer.GetText() == R"({"a":1,"b":[true,false,null],"c":"x","d":0.5,"e":{},"f":[]})"_view, "Unexpected compact JSON text!");
+}
+
+static void WritesPrettyText()
+{
+	JSON::Writer writer(JSON::Format::Pretty);
+	WriteSmallDocument(&writer);
+	VERIFY(writer.GetText() == "{\n\t\"a\": 1,\n\t\"b\": [\n\t\ttrue,\n\t\tfalse,\n\t\tnull\n\t],\n\t\"c\": \"x\",\n\t\"d\": 0.5,\n\t\"e\": {},\n\t\"f\": []\n}"_view,
+		   "Unexpected pretty JSON text!");
+}
+
+static void WritesShortestDecimals()
+{
+	struct DecimalCase
+	{
+		float64 Decimal;
+		StringView Expected;
+	};
+	static constexpr DecimalCase decimalCases[] =
+	{
+		{ 0.0, "0.0"_view },
+		{ -0.0, "-0.0"_view },
+		{ 0.1, "0.1"_view },
+		{ 0.30000000000000004, "0.30000000000000004"_view },
+		{ 100.0, "100.0"_view },
+		{ -2.5, "-2.5"_view },
+		{ 0.0001, "0.0001"_view },
+		{ 0.00001, "1e-5"_view },
+		{ 123456789012345.0, "123456789012345.0"_view },
+		{ 1e21, "1e21"_view },
+		{ 1.5e300, "1.5e300"_view },
+		{ 5e-324, "5e-324"_view },
+		{ 1.7976931348623157e308, "1.7976931348623157e308"_view },
+	};
+	for (const DecimalCase& decimalCase : decimalCases)
+	{
+		JSON::Writer writer;
+		writer.WriteDecimal(decimalCase.Decimal);
+		VERIFY(writer.GetText() == decimalCase.Expected, "JSON decimal wasn't written with the fewest digits!");
+	}
+}
+
+static void ReadsBackEscapedStrings()
+{
+	static constexpr StringView strings[] =
+	{
+		""_view,
+		"plain"_view,
+		"\"quoted\""_view,
+		"back\\slash"_view,
+		"line\nbreak\ttab\rreturn"_view,
+		StringView("\x01\x02\x1F\x7F", 4),
+		StringView("nul\0byte", 8),
+		"A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"_view,
+	};
+
+	JSON::Writer writer;
+	writer.BeginObject();
+	for (const StringView string : strings)
+	{
+		writer.WriteKey(string);
+		writer.WriteString(string);
+	}
+	writer.EndObject();
+
+	const StringView text = writer.GetText();
+	for (usize characterIndex = 0; characterIndex < text.GetLength(); ++characterIndex)
+	{
+		VERIFY(static_cast<uint8>(text[characterIndex]) >= 0x20, "JSON writer left a control character unescaped!");
+	}
+
+	const JSON::Document document = JSON::Parse(text);
+	const JSON::Object root = document.GetRoot();
+	VERIFY(root.GetCount() == ARRAY_COUNT(strings), "Unexpected JSON member count!");
+	usize stringIndex = 0;
+	for (const JSON::Member& member : root)
+	{
+		VERIFY(member.GetName() == strings[stringIndex], "JSON key doesn't read back!");
+		VERIFY(member.Value.GetString() == strings[stringIndex], "JSON string doesn't read back!");
+		++stringIndex;
+	}
+}
+
+static void ReadsBackNumbers()
+{
+	static constexpr usize decimalCount = 100000;
+	static constexpr int64 integers[] =
+	{
+		0,
+		1,
+		-1,
+		0x7FFFFFFFFFFFFFFFll,
+		static_cast<int64>(0x8000000000000000ull),
+	};
+
+	static constexpr JSON::Format formats[] = { JSON::Format::Compact, JSON::Format::Pretty };
+
+	Array<float64> decimals(decimalCount, JSON::Allocator);
+	uint64 state = 0x2545F4914F6CDD1Dull;
+	while (decimals.GetCount() < decimalCount)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+
+		float64 decimal;
+		Platform::MemoryCopy(&decimal, &state, sizeof(decimal));
+		if (isfinite(decimal))
+		{
+			decimals.Add(decimal);
+		}
+	}
+
+	for (const JSON::Format format : formats)
+	{
+		JSON::Writer writer(format);
+		writer.BeginObject();
+		writer.WriteKey("integers"_view);
+		writer.BeginArray();
+		for (const int64 integer : integers)
+		{
+			writer.WriteInteger(integer);
+		}
+		writer.EndArray();
+		writer.WriteKey("decimals"_view);
+		writer.BeginArray();
+		for (const float64 decimal : decimals)
+		{
+			writer.WriteDecimal(decimal);
+		}
+		writer.EndArray();
+		writer.EndObject();
+
+		const JSON::Document document = JSON::Parse(writer.GetText());
+		const JSON::Object root = document.GetRoot();
+
+		const JSON::Array integerArray = root["integers"_key].GetArray();
+		VERIFY(integerArray.GetCount() == ARRAY_COUNT(integers), "Unexpected JSON element count!");
+		for (usize integerIndex = 0; integerIndex < ARRAY_COUNT(integers); ++integerIndex)
+		{
+			VERIFY(integerArray[integerIndex].GetInteger() == integers[integerIndex], "JSON integer doesn't read back!");
+		}
+
+		const JSON::Array decimalArray = root["decimals"_key].GetArray();
+		VERIFY(decimalArray.GetCount() == decimalCount, "Unexpected JSON element count!");
+		for (usize decimalIndex = 0; decimalIndex < decimalCount; ++decimalIndex)
+		{
+			const JSON::Value& value = decimalArray[decimalIndex];
+			VERIFY(value.GetTag() == JSON::Tag::Decimal, "JSON decimal read back as an integer!");
+
+			VERIFY(ToBits(value.GetDecimal()) == ToBits(decimals[decimalIndex]), "JSON decimal doesn't read back!");
+		}
+	}
+}
+
+static void ReadsBackParsedDocuments()
+{
+	static constexpr StringView text = R"({
+		"asset": { "version": "2.0", "generator": "Tests" },
+		"nodes": [
+			{ "name": "root", "children": [1, 2], "translation": [0.5, -1.25, 3e-7] },
+			{ "name": "child \"one\"", "mesh": 0, "matrix": [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 10.1, 20.2, 30.3, 1] },
+			{ "name": "child\ttwo", "extras": { "visible": false, "tag": null, "empty": [], "nested": [[{}]] } }
+		],
+		"count": 9223372036854775807,
+		"scale": -0.0
+	})"_view;
+
+	const JSON::Document document = JSON::Parse(text);
+	const JSON::Value root(document.GetRoot().begin(), document.GetRoot().GetCount());
+
+	JSON::Writer compactWriter(JSON::Format::Compact);
+	compactWriter.WriteValue(root);
+	JSON::Writer prettyWriter(JSON::Format::Pretty);
+	prettyWriter.WriteObject(document.GetRoot());
+
+	const JSON::Document compactDocument = JSON::Parse(compactWriter.GetText());
+	const JSON::Document prettyDocument = JSON::Parse(prettyWriter.GetText());
+	const JSON::Value compactRoot(compactDocument.GetRoot().begin(), compactDocument.GetRoot().GetCount());
+	const JSON::Value prettyRoot(prettyDocument.GetRoot().begin(), prettyDocument.GetRoot().GetCount());
+	VERIFY(AreValuesEqual(root, compactRoot), "Compact JSON doesn't read back!");
+	VERIFY(AreValuesEqual(root, prettyRoot), "Pretty JSON doesn't read back!");
+
+	// Writing what was read back gives the same text again.
+	JSON::Writer rewriter(JSON::Format::Compact);
+	rewriter.WriteValue(prettyRoot);
+	VERIFY(rewriter.GetText() == compactWriter.GetText(), "Rewritten JSON text differs!");
+}
+
+static void GrowsPastItsFirstBuffer()
+{
+	static constexpr usize elementCount = 200000;
+
+	JSON::Writer writer;
+	writer.BeginObject();
+	writer.WriteKey("elements"_view);
+	writer.BeginArray();
+	for (usize elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+	{
+		writer.WriteInteger(static_cast<int64>(elementIndex));
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	const JSON::Document document = JSON::Parse(writer.GetText());
+	const JSON::Array elements = document.GetRoot()["elements"_key].GetArray();
+	VERIFY(elements.GetCount() == elementCount, "Unexpected JSON element count!");
+	for (usize elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+	{
+		VERIFY(elements[elementIndex].GetUnsigned() == elementIndex, "JSON integer doesn't read back!");
+	}
+}
+
+void RunWriterTests()
+{
+	static constexpr Test tests[] =
+	{
+		{ "Writes compact text", WritesCompactText },
+		{ "Writes pretty text", WritesPrettyText },
+		{ "Writes shortest decimals", WritesShortestDecimals },
+		{ "Reads back escaped strings", ReadsBackEscapedStrings },
+		{ "Reads back numbers", ReadsBackNumbers },
+		{ "Reads back parsed documents", ReadsBackParsedDocuments },
+		{ "Grows past its first buffer", GrowsPastItsFirstBuffer },
+	};
+	RunTests("Writer", tests);
+}